@@ -3,6 +3,10 @@
 
 #include "GPUSDFCutter.h"
 #include "SDFMeshExporter.h"
+#include "SDFCutDelta.h"
+#include "SDFToolLibrary.h"
+#include "SDFVolumeAsset.h"
+#include "UDynamicMesh.h"
 #include "DynamicMesh/DynamicMesh3.h"
 
 #include "Engine/VolumeTexture.h"
@@ -43,7 +47,7 @@ bool UGPUSDFCutter::WorldToVoxelSpace(const FVector& WorldLocation, FVector& Out
 
 	// 2. 边界检查 (Broad Phase)
 	// 如果点在模型的局部包围盒之外，直接认为无效
-	// TargetLocalBounds 是在 InitResources 中计算的
+	// TargetLocalBounds 在初始化完成 (FinishInitialization) 时写入
 	if (!TargetLocalBounds.IsInside(LocalPos))
 	{
 		return false;
@@ -109,6 +113,42 @@ float UGPUSDFCutter::SampleSDF(const FVector& VoxelCoord) const
 	return FMath::Lerp(C0, C1, Gamma);
 }
 
+float UGPUSDFCutter::SampleSDFAndMaterial(const FVector& VoxelCoord, int32& OutMaterialID) const
+{
+	int32 X0 = FMath::FloorToInt(VoxelCoord.X);
+	int32 Y0 = FMath::FloorToInt(VoxelCoord.Y);
+	int32 Z0 = FMath::FloorToInt(VoxelCoord.Z);
+
+	float Alpha = VoxelCoord.X - X0;
+	float Beta  = VoxelCoord.Y - Y0;
+	float Gamma = VoxelCoord.Z - Z0;
+
+	// 采样8个角点 (与 SampleSDF 相同)
+	const FFloat16Color& P000 = CPU_SDFData[GetVoxelIndex(X0,     Y0,     Z0)];
+	const FFloat16Color& P100 = CPU_SDFData[GetVoxelIndex(X0 + 1, Y0,     Z0)];
+	const FFloat16Color& P010 = CPU_SDFData[GetVoxelIndex(X0,     Y0 + 1, Z0)];
+	const FFloat16Color& P110 = CPU_SDFData[GetVoxelIndex(X0 + 1, Y0 + 1, Z0)];
+	const FFloat16Color& P001 = CPU_SDFData[GetVoxelIndex(X0,     Y0,     Z0 + 1)];
+	const FFloat16Color& P101 = CPU_SDFData[GetVoxelIndex(X0 + 1, Y0,     Z0 + 1)];
+	const FFloat16Color& P011 = CPU_SDFData[GetVoxelIndex(X0,     Y0 + 1, Z0 + 1)];
+	const FFloat16Color& P111 = CPU_SDFData[GetVoxelIndex(X0 + 1, Y0 + 1, Z0 + 1)];
+
+	// 材质：最近的角点 (等价于 SampleMaterialID 的四舍五入)
+	const FFloat16Color* Corners[8] = { &P000, &P100, &P010, &P110, &P001, &P101, &P011, &P111 };
+	const int32 Nearest = (Alpha >= 0.5f ? 1 : 0) | (Beta >= 0.5f ? 2 : 0) | (Gamma >= 0.5f ? 4 : 0);
+	OutMaterialID = FMath::RoundToInt(Corners[Nearest]->G.GetFloat());
+
+	float C00 = FMath::Lerp(P000.R.GetFloat(), P100.R.GetFloat(), Alpha);
+	float C10 = FMath::Lerp(P010.R.GetFloat(), P110.R.GetFloat(), Alpha);
+	float C01 = FMath::Lerp(P001.R.GetFloat(), P101.R.GetFloat(), Alpha);
+	float C11 = FMath::Lerp(P011.R.GetFloat(), P111.R.GetFloat(), Alpha);
+
+	float C0 = FMath::Lerp(C00, C10, Beta);
+	float C1 = FMath::Lerp(C01, C11, Beta);
+
+	return FMath::Lerp(C0, C1, Gamma);
+}
+
 int32 UGPUSDFCutter::SampleMaterialID(const FVector& VoxelCoord) const
 {
 	// 如果数据未初始化，返回默认ID (例如 0)
@@ -135,6 +175,23 @@ int32 UGPUSDFCutter::SampleMaterialID(const FVector& VoxelCoord) const
 	return 0; // Fallback
 }
 
+float UGPUSDFCutter::GetWorldToSDFScale() const
+{
+	if (!TargetMeshComponent)
+	{
+		return 1.0f;
+	}
+
+	// 非均匀缩放时取最小缩放轴：同样的世界距离在该轴上对应最大的局部距离
+	const float MinScale = TargetMeshComponent->GetComponentScale().GetAbs().GetMin();
+	return MinScale > KINDA_SMALL_NUMBER ? 1.0f / MinScale : 1.0f;
+}
+
+FTransform UGPUSDFCutter::GetLocalToWorldTransform() const
+{
+	return TargetMeshComponent ? TargetMeshComponent->GetComponentTransform() : FTransform::Identity;
+}
+
 void UGPUSDFCutter::FindReferenceComponents()
 {
 	if(!TargetMeshActor) return;
@@ -171,6 +228,12 @@ void UGPUSDFCutter::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// 刀具库是共享资产，上一次 PIE 的换刀结果不能带到本次
+	if (ToolLibrary)
+	{
+		ToolLibrary->ResetActiveTool();
+	}
+
 	// 不再自动初始化 GPU 资源
 	// 子关卡加载时，资源可能还未就绪，需要用户手动调用 InitSDFCutter()
 	// 这样用户可以在确保所有资源加载完成后再初始化
@@ -184,17 +247,34 @@ bool UGPUSDFCutter::InitSDFCutter()
 		return true;
 	}
 
+	if (ActiveInitJob.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GPUSDFCutter: Initialization already in progress"));
+		return true;
+	}
+
 	// 查找引用的组件
 	FindReferenceComponents();
 
+	// 应用刀具库的当前刀具
+	SyncActiveTool();
+
 	// 检查必要的资源是否就绪
-	if (!OriginalSDFTexture)
+	if (!OriginalSDFTexture && !SDFVolumeAsset)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GPUSDFCutter: Neither OriginalSDFTexture nor SDFVolumeAsset is set"));
+		return false;
+	}
+
+	if (SDFVolumeAsset && !SDFVolumeAsset->IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("GPUSDFCutter: OriginalSDFTexture is not set"));
+		UE_LOG(LogTemp, Error, TEXT("GPUSDFCutter: SDFVolumeAsset %s is empty or corrupt"), *SDFVolumeAsset->GetName());
 		return false;
 	}
 
-	if (!ToolSDFTexture)
+	const bool bAnalyticTool = ToolShape.IsAnalytic();
+
+	if (!bAnalyticTool && !ToolSDFTexture)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("GPUSDFCutter: ToolSDFTexture is not set"));
 		return false;
@@ -212,40 +292,47 @@ bool UGPUSDFCutter::InitSDFCutter()
 		return false;
 	}
 
-	// 检查纹理资源是否已完全流式加载
-	if (!OriginalSDFTexture->IsFullyStreamedIn())
+	// 检查纹理资源是否已完全流式加载 (SDFVolumeAsset 的数据在初始化时同步解压，无需等待)
+	if (!SDFVolumeAsset && !OriginalSDFTexture->IsFullyStreamedIn())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("GPUSDFCutter: OriginalSDFTexture not fully streamed in yet"));
 		return false;
 	}
 
-	if (!ToolSDFTexture->IsFullyStreamedIn())
+	if (!bAnalyticTool && !ToolSDFTexture->IsFullyStreamedIn())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("GPUSDFCutter: ToolSDFTexture not fully streamed in yet"));
 		return false;
 	}
 
+	// 刀具库的所有纹理都必须常驻，之后换刀时不再等待流式加载
+	if (ToolLibrary && !ToolLibrary->AreToolTexturesResident())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GPUSDFCutter: ToolLibrary textures not fully streamed in yet"));
+		return false;
+	}
+
 	// 检查纹理 RHI 资源是否就绪
-	FTextureResource* OriginalResource = OriginalSDFTexture->GetResource();
-	FTextureResource* ToolResource = ToolSDFTexture->GetResource();
+	FTextureResource* OriginalResource = SDFVolumeAsset ? nullptr : OriginalSDFTexture->GetResource();
+	FTextureResource* ToolResource = bAnalyticTool ? nullptr : ToolSDFTexture->GetResource();
 
-	if (!OriginalResource || !OriginalResource->GetTextureRHI().IsValid())
+	if (!SDFVolumeAsset && (!OriginalResource || !OriginalResource->GetTextureRHI().IsValid()))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("GPUSDFCutter: OriginalSDFTexture RHI resource not ready"));
 		return false;
 	}
 
-	if (!ToolResource || !ToolResource->GetTextureRHI().IsValid())
+	if (!bAnalyticTool && (!ToolResource || !ToolResource->GetTextureRHI().IsValid()))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("GPUSDFCutter: ToolSDFTexture RHI resource not ready"));
 		return false;
 	}
 
-	// 所有资源就绪，执行初始化
+	// 所有资源就绪，开始初始化 (后台阶段完成后广播 OnCutterReady)
 	InitResources();
 
-	UE_LOG(LogTemp, Log, TEXT("GPUSDFCutter: Successfully initialized"));
-	return bGPUResourcesInitialized;
+	UE_LOG(LogTemp, Log, TEXT("GPUSDFCutter: Initialization started"));
+	return bGPUResourcesInitialized || ActiveInitJob.IsValid();
 }
 
 FVector UGPUSDFCutter::CalculateGradientAtVoxel(const FVector& VoxelCoord) const
@@ -268,15 +355,27 @@ void UGPUSDFCutter::TickComponent(float DeltaTime, ELevelTick TickType, FActorCo
 	if (!bGPUResourcesInitialized || !TargetMeshComponent || !CutToolComponent)
 		return;
 
-	// 如果初始纹理复制尚未完成，重试
+	// 如果初始纹理复制尚未完成，重试 (SDFVolumeAsset 时每帧上传一层块)
 	if (bPendingInitialCopy)
 	{
 		ExecuteInitialTextureCopy();
+
+		// 初始体数据上传完成前不切削，避免后续上传的切片覆盖切削结果
+		if (bPendingInitialCopy)
+		{
+			return;
+		}
 	}
 
 	UpdateToolTransform();
 	UpdateTargetTransform();
 
+	// 换刀后即使位置不变也要用新刀具重新切削
+	if (SyncActiveTool())
+	{
+		bRelativeTransformDirty = true;
+	}
+
 	// 只有工具位置变化才发送新请求
 	if (bRelativeTransformDirty)
 	{
@@ -287,24 +386,31 @@ void UGPUSDFCutter::TickComponent(float DeltaTime, ELevelTick TickType, FActorCo
 
 void UGPUSDFCutter::InitResources()
 {
-	if (bGPUResourcesInitialized)
+	if (bGPUResourcesInitialized || ActiveInitJob.IsValid())
 	{
 		UE_LOG(LogTemp, Error, TEXT("GPUResources Already Initlialized"));
 		return;
 	}
 
 	// 计算SDF尺寸
-	SDFDimensions = FIntVector(
-		OriginalSDFTexture->GetSizeX(),
-		OriginalSDFTexture->GetSizeY(),
-		OriginalSDFTexture->GetSizeZ()
-	);
+	if (SDFVolumeAsset)
+	{
+		SDFDimensions = SDFVolumeAsset->Dimensions;
+	}
+	else
+	{
+		SDFDimensions = FIntVector(
+			OriginalSDFTexture->GetSizeX(),
+			OriginalSDFTexture->GetSizeY(),
+			OriginalSDFTexture->GetSizeZ()
+		);
+	}
 
 	// 切削对象的LocalBounds
-	TargetLocalBounds = TargetMeshComponent->CalcLocalBounds().GetBox();
+	const FBox LocalBounds = TargetMeshComponent->CalcLocalBounds().GetBox();
 	
 	// 像素各个维度均等，选任意轴向均可
-	VoxelSize = TargetLocalBounds.GetSize().X / SDFDimensions.X;
+	VoxelSize = LocalBounds.GetSize().X / SDFDimensions.X;
 
 	CalculateToolDimensions();
 
@@ -314,11 +420,153 @@ void UGPUSDFCutter::InitResources()
 	VolumeRT = UKismetRenderingLibrary::CreateRenderTargetVolume(this, SDFDimensions.X, SDFDimensions.Y, SDFDimensions.Z, RTF_RGBA16f, FLinearColor::Black, false, true);
     VolumeRT->bCanCreateUAV = true;
 
-	// 等待 VolumeRT 的 RHI 资源初始化完成
-	// 子关卡加载时，资源创建是异步的，需要等待
-	FlushRenderingCommands();
+	// VolumeRT 的 RHI 资源在渲染线程上异步创建，这里不用 FlushRenderingCommands 等待：
+	// 初始上传在 FinishInitialization 中进行，RHI 未就绪时由 bPendingInitialCopy 逐帧重试
+
+	// 体数据读取/解压、材质统计和距离金字塔交给后台任务
+	TSharedPtr<FInitJob, ESPMode::ThreadSafe> Job = MakeShared<FInitJob, ESPMode::ThreadSafe>();
+	Job->Dimensions = SDFDimensions;
+	Job->VoxelSize = VoxelSize;
+	Job->TargetLocalBounds = LocalBounds;
+	if (SDFVolumeAsset)
+	{
+		Job->SourceAsset.Reset(SDFVolumeAsset);
+	}
+	else
+	{
+		Job->SourceTexture.Reset(OriginalSDFTexture);
+	}
+	ActiveInitJob = Job;
+
+	TWeakObjectPtr<UGPUSDFCutter> WeakThis(this);
+
+	// 进度回调：记录到共享状态，并投递到 GameThread 广播
+	auto ReportProgress = [WeakThis, Job](float Progress)
+	{
+		Job->Progress.store(Progress, std::memory_order_relaxed);
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Job, Progress]()
+		{
+			UGPUSDFCutter* Cutter = WeakThis.Get();
+			if (Cutter && Cutter->ActiveInitJob == Job)
+			{
+				Cutter->OnInitProgress.Broadcast(Progress);
+			}
+		});
+	};
+
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Job, ReportProgress]()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		const bool bBuilt = BuildInitialCPUData(*Job, ReportProgress);
+		if (bBuilt)
+		{
+			UE_LOG(LogTemp, Log, TEXT("GPUSDFCutter: Background initialization took %.1f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+
+		// 回到 GameThread 接管结果 (组件可能已被销毁)
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Job, bBuilt]()
+		{
+			// 数据源引用在 GameThread 上释放
+			Job->SourceTexture.Reset();
+			Job->SourceAsset.Reset();
+
+			UGPUSDFCutter* Cutter = WeakThis.Get();
+			if (!Cutter || Cutter->ActiveInitJob != Job)
+			{
+				return;
+			}
+
+			Cutter->FinishInitialization(Job, bBuilt);
+		});
+	});
+}
+
+bool UGPUSDFCutter::BuildInitialCPUData(FInitJob& Job, TFunctionRef<void(float)> ReportProgress)
+{
+	const FIntVector& Dims = Job.Dimensions;
+	const int32 TotalVoxels = Dims.X * Dims.Y * Dims.Z;
+	Job.SDFData.SetNumUninitialized(TotalVoxels);
+
+	bool bLoaded = false;
+	if (USDFVolumeAsset* Asset = Job.SourceAsset.Get())
+	{
+		// 各块并行解压，直接写入 CPU 镜像 (不经过体积纹理的平台数据)
+		bLoaded = Asset->DecompressTo(Job.SDFData);
+	}
+	else if (UVolumeTexture* Texture = Job.SourceTexture.Get())
+	{
+		// Read initial data from the original texture asset into CPU cache
+		FTexturePlatformData* PlatformData = Texture->GetPlatformData();
+		if (PlatformData && PlatformData->Mips.Num() > 0)
+		{
+			FByteBulkData& BulkData = PlatformData->Mips[0].BulkData;
+			const int64 NumBytes = (int64)TotalVoxels * sizeof(FFloat16Color);
+			if (BulkData.GetBulkDataSize() >= NumBytes)
+			{
+				// Assuming the source format is FFloat16Color Float
+				const void* RawData = BulkData.LockReadOnly();
+				FMemory::Memcpy(Job.SDFData.GetData(), RawData, NumBytes);
+				BulkData.Unlock();
+				bLoaded = true;
+			}
+		}
+	}
+
+	if (!bLoaded)
+	{
+		// 没有可用的初始数据时初始化失败，由 FinishInitialization 广播 OnCutterReady(false)
+		UE_LOG(LogTemp, Error, TEXT("GPUSDFCutter: No valid initial SDF data"));
+		return false;
+	}
+
+	ReportProgress(0.5f);
+	if (Job.bCancelRequested)
+	{
+		return false;
+	}
+
+	// 全量统计一次材质体素数量，之后增量维护
+	ComputeMaterialHistogram(Job.SDFData, Dims, Job.VoxelSize, Job.MaterialCounts, &Job.MaterialOccupancy);
+
+	ReportProgress(0.7f);
+	if (Job.bCancelRequested)
+	{
+		return false;
+	}
+
+	// 构建保守距离金字塔，供射线查询大步跳跃
+	Job.Pyramid.Build(Job.SDFData, Dims);
+
+	ReportProgress(0.95f);
+	return !Job.bCancelRequested;
+}
+
+void UGPUSDFCutter::FinishInitialization(const TSharedPtr<FInitJob, ESPMode::ThreadSafe>& Job, bool bSuccess)
+{
+	ActiveInitJob.Reset();
+
+	if (!bSuccess || Job->bCancelRequested || !TargetMeshComponent || !CutToolComponent)
+	{
+		UE_LOG(LogTemp, Log, TEXT("GPUSDFCutter: Initialization %s"), (bSuccess || Job->bCancelRequested) ? TEXT("cancelled") : TEXT("failed"));
+		VolumeRT = nullptr;
+		OnCutterReady.Broadcast(false);
+		return;
+	}
+
+	// 接管后台结果 (移动，不复制体数据)
+	{
+		FRWScopeLock WriteLock(DataRWLock, SLT_Write);
+		CPU_SDFData = MoveTemp(Job->SDFData);
+		for (int32 MaterialID = 0; MaterialID < MaxTrackedMaterialIDs; MaterialID++)
+		{
+			MaterialVoxelCounts[MaterialID] = Job->MaterialCounts[MaterialID];
+			MaterialOccupancySums[MaterialID] = Job->MaterialOccupancy[MaterialID];
+		}
+		DistancePyramid = MoveTemp(Job->Pyramid);
+		TargetLocalBounds = Job->TargetLocalBounds;
+	}
 
-	// 创建SDF渲染材质实例
+	// 创建SDF渲染材质实例 (体数据就绪后再替换目标材质，加载期间保持原材质)
 	SDFMaterialInstanceDynamic = UMaterialInstanceDynamic::Create(SDFMaterialInstance, this);
 	if (VolumeRT)
 	{
@@ -327,20 +575,53 @@ void UGPUSDFCutter::InitResources()
 	// 分配材质实例给目标网格
 	TargetMeshComponent->SetMaterial(0, SDFMaterialInstanceDynamic);
 
-	InitCPUData();
-
 	// 存储外部纹理的RHI引用(静态图片，可以直接获取RHI
-	OriginalSDFRHIRef = OriginalSDFTexture->GetResource()->GetTextureRHI();
-	ToolSDFRHIRef = ToolSDFTexture->GetResource()->GetTextureRHI();
+	OriginalSDFRHIRef = SDFVolumeAsset ? nullptr : OriginalSDFTexture->GetResource()->GetTextureRHI();
+	ToolSDFRHIRef = (ToolSDFTexture && ToolSDFTexture->GetResource()) ? ToolSDFTexture->GetResource()->GetTextureRHI() : nullptr;
 
 	bGPUResourcesInitialized = true;
 
 	// 尝试执行初始纹理复制（子关卡加载时可能需要延迟）
+	InitialUploadSliceZ = 0;
 	ExecuteInitialTextureCopy();
+
+	UE_LOG(LogTemp, Log, TEXT("GPUSDFCutter: Successfully initialized"));
+	OnInitProgress.Broadcast(1.0f);
+	OnCutterReady.Broadcast(true);
+}
+
+float UGPUSDFCutter::GetInitProgress() const
+{
+	return ActiveInitJob.IsValid() ? ActiveInitJob->Progress.load(std::memory_order_relaxed) : 0.0f;
+}
+
+void UGPUSDFCutter::CancelInitialization()
+{
+	if (ActiveInitJob.IsValid())
+	{
+		ActiveInitJob->bCancelRequested = true;
+	}
 }
 
 void UGPUSDFCutter::ExecuteInitialTextureCopy()
 {
+	// 压缩体数据已解压到 CPU 镜像，从镜像上传
+	if (SDFVolumeAsset)
+	{
+		FTextureResource* DestVolumeResource = VolumeRT ? VolumeRT->GetResource() : nullptr;
+		FTextureRHIRef DestVolumeRHI = DestVolumeResource ? DestVolumeResource->GetTextureRHI() : nullptr;
+		if (!DestVolumeRHI.IsValid())
+		{
+			bPendingInitialCopy = true;
+			return;
+		}
+
+		// 每次只提交一层块，剩余部分由后续 Tick 继续上传
+		UploadInitialVolumeFromCPUData(DestVolumeRHI);
+		bPendingInitialCopy = InitialUploadSliceZ < SDFDimensions.Z;
+		return;
+	}
+
 	if (!VolumeRT || !OriginalSDFTexture)
 	{
 		bPendingInitialCopy = true;
@@ -416,6 +697,49 @@ void UGPUSDFCutter::ExecuteInitialTextureCopy()
 	});
 }
 
+void UGPUSDFCutter::UploadInitialVolumeFromCPUData(FTextureRHIRef DestVolumeRHI)
+{
+	// 每次上传 BrickSize 层切片 (一层块)，暂存内存为 X * Y * BrickSize 个体素而不是整个体数据
+	const int32 SlabDepth = FMath::Max(SDFVolumeAsset->BrickSize, 1);
+	const FIntVector Dims = SDFDimensions;
+	const int32 Z = InitialUploadSliceZ;
+	const int32 Depth = FMath::Min(SlabDepth, Dims.Z - Z);
+	InitialUploadSliceZ += Depth;
+
+	ENQUEUE_RENDER_COMMAND(UploadSDFVolumeBricks)([this, DestVolumeRHI, Dims, Z, Depth](FRHICommandListImmediate& RHICmdList)
+	{
+		const int64 SliceSize = (int64)Dims.X * Dims.Y;
+
+		// 只在拷贝到暂存区时持有读锁，UpdateTexture3D 期间不阻塞 GameThread 的写锁
+		TArray<FFloat16Color> Staging;
+		{
+			FReadScopeLock ReadLock(DataRWLock);
+
+			if (CPU_SDFData.Num() != SliceSize * Dims.Z)
+			{
+				UE_LOG(LogTemp, Error, TEXT("GPUSDFCutter: CPU data size does not match volume dimensions, initial upload skipped"));
+				return;
+			}
+
+			Staging.SetNumUninitialized(SliceSize * Depth);
+			FMemory::Memcpy(Staging.GetData(), CPU_SDFData.GetData() + Z * SliceSize, Staging.Num() * sizeof(FFloat16Color));
+		}
+
+		const uint32 RowPitch = Dims.X * sizeof(FFloat16Color);
+		const uint32 DepthPitch = RowPitch * Dims.Y;
+		const FUpdateTextureRegion3D Region(0, 0, Z, 0, 0, 0, Dims.X, Dims.Y, Depth);
+
+		RHICmdList.Transition(FRHITransitionInfo(DestVolumeRHI, ERHIAccess::Unknown, ERHIAccess::CopyDest));
+		RHICmdList.UpdateTexture3D(DestVolumeRHI, 0, Region, RowPitch, DepthPitch, reinterpret_cast<const uint8*>(Staging.GetData()));
+		RHICmdList.Transition(FRHITransitionInfo(DestVolumeRHI, ERHIAccess::CopyDest, ERHIAccess::SRVMask));
+
+		if (Z + Depth >= Dims.Z)
+		{
+			UE_LOG(LogTemp, Log, TEXT("GPUSDFCutter: Initial volume uploaded from SDFVolumeAsset"));
+		}
+	});
+}
+
 void UGPUSDFCutter::UpdateToolTransform()
 {
 	FTransform NewTransform = CutToolComponent->GetComponentTransform();
@@ -506,100 +830,442 @@ bool UGPUSDFCutter::GetSDFValueAndNormal(FVector WorldLocation, float& OutSDFVal
 	return true;
 }
 
-float UGPUSDFCutter::CalculateCurrentVolume(int32 MaterialID, bool bWorldSpace)
+namespace GPUSDFCutterRayCast
 {
-	if (CPU_SDFData.Num() == 0 || !TargetMeshComponent)
+	// 表面附近球面追踪的最小步长 (体素)
+	static constexpr float MinStepVoxels = 0.05f;
+
+	// 单条射线的最大采样次数
+	static constexpr int32 MaxSteps = 4096;
+
+	// 交点二分细化次数
+	static constexpr int32 BisectionSteps = 8;
+
+	// 批量检测时开启并行的最小射线数
+	static constexpr int32 MinRaysForParallel = 16;
+}
+
+bool UGPUSDFCutter::RayCastLocked(const FTransform& TargetTransform, const FVector& WorldStart, const FVector& WorldEnd,
+	bool bUsePyramid, FSDFRayHit& OutHit) const
+{
+	using namespace GPUSDFCutterRayCast;
+
+	OutHit = FSDFRayHit();
+
+	// 世界空间 -> 体素空间 (仿射变换，线段参数保持线性)
+	const FVector VoxelStart = (TargetTransform.InverseTransformPosition(WorldStart) - TargetLocalBounds.Min) / VoxelSize;
+	const FVector VoxelEnd = (TargetTransform.InverseTransformPosition(WorldEnd) - TargetLocalBounds.Min) / VoxelSize;
+
+	const FVector Delta = VoxelEnd - VoxelStart;
+	const float Length = Delta.Size();
+	if (Length < KINDA_SMALL_NUMBER)
 	{
-		return 0.0f;
+		return false;
 	}
+	const FVector Direction = Delta / Length;
 
-	// 1. 计算单个体素的体积 (Local Space)
-	// VoxelSize 是在 InitResources 中根据 Bounds 和 Dimensions 计算出的单边长
-	// 假设体素是完美的立方体
-	const float SingleVoxelVolume = VoxelSize * VoxelSize * VoxelSize;
+	// 把线段裁剪到采样点范围 [0, Dimensions - 1]
+	float TMin = 0.0f;
+	float TMax = Length;
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		const float Lo = 0.0f;
+		const float Hi = (float)(SDFDimensions[Axis] - 1);
+		if (FMath::Abs(Direction[Axis]) < KINDA_SMALL_NUMBER)
+		{
+			if (VoxelStart[Axis] < Lo || VoxelStart[Axis] > Hi)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		float T0 = (Lo - VoxelStart[Axis]) / Direction[Axis];
+		float T1 = (Hi - VoxelStart[Axis]) / Direction[Axis];
+		if (T0 > T1)
+		{
+			Swap(T0, T1);
+		}
+		TMin = FMath::Max(TMin, T0);
+		TMax = FMath::Min(TMax, T1);
+	}
+
+	if (TMin > TMax)
+	{
+		return false;
+	}
 
-	// 2. 统计在表面内部的体素数量 (SDF <= 0)
-	// 使用原子操作以支持并行计算
-	std::atomic<int32> InsideVoxelCount(0);
+	const float InvVoxelSize = 1.0f / VoxelSize;
+	const bool bPyramid = bUsePyramid && DistancePyramid.IsValid();
 
-	// 并行遍历整个 SDF 数组
-	ParallelFor(CPU_SDFData.Num(), [&](int32 Index)
+	float T = TMin;
+	float PrevT = T;
+	bool bHasPrev = false;
+	bool bHit = false;
+
+	for (int32 Step = 0; Step < MaxSteps; Step++)
 	{
-		
-		// 假设 SDF <= 0 表示物体内部 
-		if (CPU_SDFData[Index].R <= 0.0f )
+		// 1. 远离表面：整块跳过 SDF 全为正的单元
+		if (bPyramid)
 		{
-			int32 MaterialIDRead = FMath::RoundToInt(CPU_SDFData[Index].G.GetFloat());
-			if (MaterialIDRead == MaterialID)
+			const float SkippedT = DistancePyramid.AdvanceRay(VoxelStart, Direction, T, TMax, 0.0f);
+			if (SkippedT > T)
 			{
-				++InsideVoxelCount;
-			}			
+				if (SkippedT >= TMax)
+				{
+					return false;
+				}
+
+				// 被跳过的区间全部在外部，可作为二分的下界
+				PrevT = T;
+				bHasPrev = true;
+				T = SkippedT;
+			}
 		}
-	});
 
-	// 3. 计算 Local 空间总体积
-	float LocalVolume = InsideVoxelCount.load() * SingleVoxelVolume;
+		// 2. 表面附近：球面追踪
+		const float Dist = SampleSDF(VoxelStart + Direction * T) * InvVoxelSize;
+		if (Dist <= 0.0f)
+		{
+			bHit = true;
+			break;
+		}
 
-	// 4. 如果需要世界空间体积，乘以 Actor 的缩放系数
-	if (bWorldSpace)
+		if (T >= TMax)
+		{
+			break;
+		}
+
+		PrevT = T;
+		bHasPrev = true;
+		T = FMath::Min(T + FMath::Max(Dist, MinStepVoxels), TMax);
+	}
+
+	if (!bHit)
 	{
-		FVector ActorScale = TargetMeshComponent->GetComponentScale();
-		// 体积缩放是三个轴向缩放的乘积
-		float ScaleFactor = FMath::Abs(ActorScale.X * ActorScale.Y * ActorScale.Z);
-		return LocalVolume * ScaleFactor;
+		return false;
 	}
 
-	return LocalVolume;
+	// 3. 在 [PrevT, T] 之间二分，逼近符号变化的位置 (起点就在内部时直接取起点)
+	if (bHasPrev)
+	{
+		float Lo = PrevT;
+		float Hi = T;
+		for (int32 i = 0; i < BisectionSteps; i++)
+		{
+			const float Mid = 0.5f * (Lo + Hi);
+			if (SampleSDF(VoxelStart + Direction * Mid) <= 0.0f)
+			{
+				Hi = Mid;
+			}
+			else
+			{
+				Lo = Mid;
+			}
+		}
+		T = Hi;
+	}
+
+	const FVector HitVoxel = VoxelStart + Direction * T;
+
+	OutHit.bHit = true;
+	OutHit.Location = TargetTransform.TransformPosition(TargetLocalBounds.Min + HitVoxel * VoxelSize);
+	OutHit.Normal = TargetTransform.TransformVector(CalculateGradientAtVoxel(HitVoxel)).GetSafeNormal();
+	OutHit.Distance = FVector::Dist(WorldStart, OutHit.Location);
+	OutHit.MaterialID = SampleMaterialID(HitVoxel);
+	return true;
 }
 
-void UGPUSDFCutter::InitCPUData()
+bool UGPUSDFCutter::RayCast(FVector Start, FVector End, FSDFRayHit& OutHit)
 {
-    // Initialize array size
-    int32 TotalVoxels = SDFDimensions.X * SDFDimensions.Y * SDFDimensions.Z;
-    CPU_SDFData.SetNumUninitialized(TotalVoxels);
+	OutHit = FSDFRayHit();
 
-    // Read initial data from the original texture asset into CPU cache
-    FTexturePlatformData* PlatformData = OriginalSDFTexture->GetPlatformData();
-    if (PlatformData && PlatformData->Mips.Num() > 0)
-    {
-        const void* RawData = PlatformData->Mips[0].BulkData.LockReadOnly();
+	if (CPU_SDFData.Num() == 0 || !TargetMeshComponent)
+	{
+		return false;
+	}
 
-        // Assuming the source format is FFloat16Color Float
-    	const FFloat16Color* SourceData = static_cast<const FFloat16Color*>(RawData);
-        FMemory::Memcpy(CPU_SDFData.GetData(), SourceData, CPU_SDFData.Num() * sizeof(FFloat16Color));
+	const FTransform TargetTransform = TargetMeshComponent->GetComponentTransform();
 
-        PlatformData->Mips[0].BulkData.Unlock();
-    }
-    else
-    {
-        // If no valid data, initialize to zero
-        FMemory::Memzero(CPU_SDFData.GetData(), CPU_SDFData.Num() * sizeof(FFloat16Color));
-    }
+	FRWScopeLock ReadLock(DataRWLock, SLT_ReadOnly);
+	return RayCastLocked(TargetTransform, Start, End, true, OutHit);
 }
 
-void UGPUSDFCutter::UpdateCPUDataPartial(FIntVector UpdateMin, FIntVector UpdateSize, TArray<FFloat16Color>& LocalData)
+void UGPUSDFCutter::RayCastBatch(const TArray<FSDFRay>& Rays, TArray<FSDFRayHit>& OutHits)
 {
-	// 校验数据大小是否匹配
-	int32 ExpectedSize = UpdateSize.X * UpdateSize.Y * UpdateSize.Z;
-	if (LocalData.Num() != ExpectedSize)
+	RayCastBatchInternal(Rays, OutHits, true);
+}
+
+void UGPUSDFCutter::RayCastBatchInternal(const TArray<FSDFRay>& Rays, TArray<FSDFRayHit>& OutHits, bool bUsePyramid)
+{
+	OutHits.Reset();
+	OutHits.SetNum(Rays.Num());
+
+	if (CPU_SDFData.Num() == 0 || !TargetMeshComponent)
 	{
-		// 可能是尺寸计算有细微偏差（如边界处理），做个保护
 		return;
 	}
 
-	if (CPU_SDFData.Num() != SDFDimensions.X * SDFDimensions.Y * SDFDimensions.Z)
+	// 组件变换只在 GameThread 读取一次
+	const FTransform TargetTransform = TargetMeshComponent->GetComponentTransform();
+
+	FRWScopeLock ReadLock(DataRWLock, SLT_ReadOnly);
+
+	ParallelFor(Rays.Num(), [&](int32 Index)
 	{
-		// 如果主缓存还没初始化，无法局部更新
-		return;
+		RayCastLocked(TargetTransform, Rays[Index].Start, Rays[Index].End, bUsePyramid, OutHits[Index]);
+	}, Rays.Num() < GPUSDFCutterRayCast::MinRaysForParallel ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+float UGPUSDFCutter::BenchmarkRayCasts(int32 NumRays)
+{
+	if (CPU_SDFData.Num() == 0 || !TargetMeshComponent || NumRays <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BenchmarkRayCasts: No SDF data available or target mesh not set"));
+		return 0.0f;
 	}
 
-	// 遍历局部数据，填入全局数组
-	// 这是一个三重循环，但只针对切削的小区域，速度极快
-	int32 LocalIndex = 0;
-	for (int32 z = 0; z < UpdateSize.Z; z++)
+	// 射线从包围球外随机一点射向包围盒内随机一点，大部分射线会穿过空白区域再命中表面
+	const FTransform TargetTransform = TargetMeshComponent->GetComponentTransform();
+	const FBox WorldBounds = TargetLocalBounds.TransformBy(TargetTransform);
+	const FVector Center = WorldBounds.GetCenter();
+	const float OuterRadius = WorldBounds.GetExtent().Size() * 1.5f;
+
+	FRandomStream Random(12345);
+	TArray<FSDFRay> Rays;
+	Rays.SetNumUninitialized(NumRays);
+	for (FSDFRay& Ray : Rays)
 	{
-		int32 GlobalZ = UpdateMin.Z + z;
-		if (GlobalZ >= SDFDimensions.Z) break;
+		Ray.Start = Center + Random.GetUnitVector() * OuterRadius;
+		Ray.End = FVector(
+			Random.FRandRange(WorldBounds.Min.X, WorldBounds.Max.X),
+			Random.FRandRange(WorldBounds.Min.Y, WorldBounds.Max.Y),
+			Random.FRandRange(WorldBounds.Min.Z, WorldBounds.Max.Z));
+	}
+
+	TArray<FSDFRayHit> Hits;
+
+	auto RunPass = [&](bool bUsePyramid, int32& OutHitCount) -> double
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		RayCastBatchInternal(Rays, Hits, bUsePyramid);
+		const double Elapsed = FMath::Max(FPlatformTime::Seconds() - StartTime, 1.0e-9);
+
+		OutHitCount = 0;
+		for (const FSDFRayHit& Hit : Hits)
+		{
+			OutHitCount += Hit.bHit ? 1 : 0;
+		}
+		return NumRays / Elapsed;
+	};
+
+	int32 SphereTraceHits = 0;
+	int32 PyramidHits = 0;
+	const double SphereTraceRate = RunPass(false, SphereTraceHits);
+	const double PyramidRate = RunPass(true, PyramidHits);
+
+	UE_LOG(LogTemp, Log, TEXT("BenchmarkRayCasts: %d rays, sphere tracing %.0f rays/sec (%d hits), pyramid %.0f rays/sec (%d hits), speedup %.2fx"),
+		NumRays, SphereTraceRate, SphereTraceHits, PyramidRate, PyramidHits, PyramidRate / SphereTraceRate);
+
+	return (float)PyramidRate;
+}
+
+float UGPUSDFCutter::CalculateCurrentVolume(int32 MaterialID, bool bWorldSpace, bool bSubVoxelAccurate)
+{
+	if (CPU_SDFData.Num() == 0 || !TargetMeshComponent)
+	{
+		return 0.0f;
+	}
+
+	if (MaterialID < 0 || MaterialID >= MaxTrackedMaterialIDs)
+	{
+		return 0.0f;
+	}
+
+	// 1. 计算单个体素的体积 (Local Space)
+	// VoxelSize 是在 InitResources 中根据 Bounds 和 Dimensions 计算出的单边长
+	// 假设体素是完美的立方体
+	const float SingleVoxelVolume = VoxelSize * VoxelSize * VoxelSize;
+
+	// 2. 读取增量维护的计数 (初始化时全量统计，UpdateCPUDataPartial 按差值更新)
+	double InsideVoxelCount;
+	{
+		FRWScopeLock ReadLock(DataRWLock, SLT_ReadOnly);
+		InsideVoxelCount = bSubVoxelAccurate
+			? (double)MaterialOccupancySums[MaterialID] / OccupancyFixedScale
+			: (double)MaterialVoxelCounts[MaterialID];
+	}
+
+	// 3. 计算 Local 空间总体积
+	float LocalVolume = InsideVoxelCount * SingleVoxelVolume;
+
+	// 4. 如果需要世界空间体积，乘以 Actor 的缩放系数
+	if (bWorldSpace)
+	{
+		FVector ActorScale = TargetMeshComponent->GetComponentScale();
+		// 体积缩放是三个轴向缩放的乘积
+		float ScaleFactor = FMath::Abs(ActorScale.X * ActorScale.Y * ActorScale.Z);
+		return LocalVolume * ScaleFactor;
+	}
+
+	return LocalVolume;
+}
+
+void UGPUSDFCutter::CalculateAllMaterialVolumes(TArray<float>& OutVolumes, bool bWorldSpace, bool bSubVoxelAccurate)
+{
+	OutVolumes.Init(0.0f, MaxTrackedMaterialIDs);
+
+	if (CPU_SDFData.Num() == 0 || !TargetMeshComponent)
+	{
+		return;
+	}
+
+	float ScaleFactor = VoxelSize * VoxelSize * VoxelSize;
+	if (bWorldSpace)
+	{
+		const FVector ActorScale = TargetMeshComponent->GetComponentScale();
+		ScaleFactor *= FMath::Abs(ActorScale.X * ActorScale.Y * ActorScale.Z);
+	}
+
+	FRWScopeLock ReadLock(DataRWLock, SLT_ReadOnly);
+	for (int32 MaterialID = 0; MaterialID < MaxTrackedMaterialIDs; MaterialID++)
+	{
+		const double VoxelCount = bSubVoxelAccurate
+			? (double)MaterialOccupancySums[MaterialID] / OccupancyFixedScale
+			: (double)MaterialVoxelCounts[MaterialID];
+		OutVolumes[MaterialID] = VoxelCount * ScaleFactor;
+	}
+}
+
+int32 UGPUSDFCutter::GetInsideMaterialIndex(const FFloat16Color& Voxel)
+{
+	// 假设 SDF <= 0 表示物体内部
+	if (Voxel.R.GetFloat() > 0.0f)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 MaterialID = FMath::RoundToInt(Voxel.G.GetFloat());
+	return (MaterialID >= 0 && MaterialID < MaxTrackedMaterialIDs) ? MaterialID : INDEX_NONE;
+}
+
+int32 UGPUSDFCutter::GetTrackedMaterialIndex(const FFloat16Color& Voxel)
+{
+	const int32 MaterialID = FMath::RoundToInt(Voxel.G.GetFloat());
+	return (MaterialID >= 0 && MaterialID < MaxTrackedMaterialIDs) ? MaterialID : INDEX_NONE;
+}
+
+int64 UGPUSDFCutter::GetQuantizedOccupancy(const FFloat16Color& Voxel, float InvVoxelSize)
+{
+	const float Occupancy = FMath::Clamp(0.5f - Voxel.R.GetFloat() * InvVoxelSize, 0.0f, 1.0f);
+	return (int64)FMath::RoundToInt(Occupancy * OccupancyFixedScale);
+}
+
+void UGPUSDFCutter::ComputeMaterialHistogram(TArray<int64>& OutCounts, TArray<int64>* OutOccupancy) const
+{
+	ComputeMaterialHistogram(CPU_SDFData, SDFDimensions, VoxelSize, OutCounts, OutOccupancy);
+}
+
+void UGPUSDFCutter::ComputeMaterialHistogram(const TArray<FFloat16Color>& SDFData, const FIntVector& Dimensions, float InVoxelSize,
+	TArray<int64>& OutCounts, TArray<int64>* OutOccupancy)
+{
+	OutCounts.Init(0, MaxTrackedMaterialIDs);
+	if (OutOccupancy)
+	{
+		OutOccupancy->Init(0, MaxTrackedMaterialIDs);
+	}
+
+	if (SDFData.Num() != Dimensions.X * Dimensions.Y * Dimensions.Z)
+	{
+		return;
+	}
+
+	// 每个线程独立计数，避免对共享原子变量的争用
+	struct FHistogramContext
+	{
+		int64 Counts[MaxTrackedMaterialIDs] = {};
+		int64 Occupancy[MaxTrackedMaterialIDs] = {};
+	};
+
+	const int32 SliceSize = Dimensions.X * Dimensions.Y;
+	const float InvVoxelSize = 1.0f / InVoxelSize;
+	TArray<FHistogramContext> Contexts;
+
+	ParallelForWithTaskContext(Contexts, Dimensions.Z, [&SDFData, SliceSize, InvVoxelSize](FHistogramContext& Context, int32 Z)
+	{
+		const FFloat16Color* Slice = SDFData.GetData() + (int64)Z * SliceSize;
+		for (int32 i = 0; i < SliceSize; i++)
+		{
+			const int32 MaterialID = GetTrackedMaterialIndex(Slice[i]);
+			if (MaterialID == INDEX_NONE)
+			{
+				continue;
+			}
+
+			if (Slice[i].R.GetFloat() <= 0.0f)
+			{
+				Context.Counts[MaterialID]++;
+			}
+			Context.Occupancy[MaterialID] += GetQuantizedOccupancy(Slice[i], InvVoxelSize);
+		}
+	});
+
+	// 合并各线程的局部计数
+	for (const FHistogramContext& Context : Contexts)
+	{
+		for (int32 MaterialID = 0; MaterialID < MaxTrackedMaterialIDs; MaterialID++)
+		{
+			OutCounts[MaterialID] += Context.Counts[MaterialID];
+			if (OutOccupancy)
+			{
+				(*OutOccupancy)[MaterialID] += Context.Occupancy[MaterialID];
+			}
+		}
+	}
+}
+
+void UGPUSDFCutter::UpdateCPUDataPartial(FIntVector UpdateMin, FIntVector UpdateSize, TArray<FFloat16Color>& LocalData)
+{
+	// 校验数据大小是否匹配
+	int32 ExpectedSize = UpdateSize.X * UpdateSize.Y * UpdateSize.Z;
+	if (LocalData.Num() != ExpectedSize)
+	{
+		// 可能是尺寸计算有细微偏差（如边界处理），做个保护
+		return;
+	}
+
+	if (CPU_SDFData.Num() != SDFDimensions.X * SDFDimensions.Y * SDFDimensions.Z)
+	{
+		// 如果主缓存还没初始化，无法局部更新
+		return;
+	}
+
+	// 写锁：防止 Haptics 线程读到写了一半的数据
+	FRWScopeLock WriteLock(DataRWLock, SLT_Write);
+
+	const float InvVoxelSize = 1.0f / VoxelSize;
+
+	// 有订阅者时顺带记录增量 (区域裁剪到体积范围内)
+	TSharedPtr<FSDFCutDelta, ESPMode::ThreadSafe> Delta;
+	if (CutDeltaChannel.HasSubscribers())
+	{
+		Delta = MakeShared<FSDFCutDelta, ESPMode::ThreadSafe>();
+		Delta->GridOrigin = TargetLocalBounds.Min;
+		Delta->CellSize = VoxelSize;
+		Delta->RegionMin = UpdateMin;
+		Delta->RegionSize = FIntVector(
+			FMath::Max(0, FMath::Min(UpdateSize.X, SDFDimensions.X - UpdateMin.X)),
+			FMath::Max(0, FMath::Min(UpdateSize.Y, SDFDimensions.Y - UpdateMin.Y)),
+			FMath::Max(0, FMath::Min(UpdateSize.Z, SDFDimensions.Z - UpdateMin.Z)));
+	}
+
+	// 遍历局部数据，填入全局数组
+	// 这是一个三重循环，但只针对切削的小区域，速度极快
+	int32 LocalIndex = 0;
+	for (int32 z = 0; z < UpdateSize.Z; z++)
+	{
+		int32 GlobalZ = UpdateMin.Z + z;
+		if (GlobalZ >= SDFDimensions.Z) break;
 
 		for (int32 y = 0; y < UpdateSize.Y; y++)
 		{
@@ -615,6 +1281,38 @@ void UGPUSDFCutter::UpdateCPUDataPartial(FIntVector UpdateMin, FIntVector Update
             
 			if (CopyCount > 0)
 			{
+				// 拷贝前比较新旧值，增量更新材质计数与占据率
+				for (int32 x = 0; x < CopyCount; x++)
+				{
+					const FFloat16Color& OldVoxel = CPU_SDFData[GlobalStartIndex + x];
+					const FFloat16Color& NewVoxel = LocalData[LocalIndex + x];
+
+					const int32 OldMaterial = GetInsideMaterialIndex(OldVoxel);
+					const int32 NewMaterial = GetInsideMaterialIndex(NewVoxel);
+					if (OldMaterial != NewMaterial)
+					{
+						if (OldMaterial != INDEX_NONE) MaterialVoxelCounts[OldMaterial]--;
+						if (NewMaterial != INDEX_NONE) MaterialVoxelCounts[NewMaterial]++;
+					}
+
+					const int32 OldTracked = GetTrackedMaterialIndex(OldVoxel);
+					const int32 NewTracked = GetTrackedMaterialIndex(NewVoxel);
+					if (OldTracked != INDEX_NONE) MaterialOccupancySums[OldTracked] -= GetQuantizedOccupancy(OldVoxel, InvVoxelSize);
+					if (NewTracked != INDEX_NONE) MaterialOccupancySums[NewTracked] += GetQuantizedOccupancy(NewVoxel, InvVoxelSize);
+
+					if (Delta.IsValid())
+					{
+						if (OldVoxel.R.Encoded != NewVoxel.R.Encoded || OldVoxel.G.Encoded != NewVoxel.G.Encoded)
+						{
+							Delta->AddChanged(OldVoxel, NewVoxel);
+						}
+						else
+						{
+							Delta->AddUnchanged();
+						}
+					}
+				}
+
 				FMemory::Memcpy(
 					&CPU_SDFData[GlobalStartIndex], 
 					&LocalData[LocalIndex], 
@@ -626,6 +1324,14 @@ void UGPUSDFCutter::UpdateCPUDataPartial(FIntVector UpdateMin, FIntVector Update
 			LocalIndex += UpdateSize.X; 
 		}
 	}
+
+	// 只重建被修改区域对应的金字塔单元
+	DistancePyramid.UpdateRegion(CPU_SDFData, UpdateMin, UpdateSize);
+
+	if (Delta.IsValid())
+	{
+		CutDeltaChannel.Publish(Delta.ToSharedRef());
+	}
 }
 
 int32 UGPUSDFCutter::GetVoxelIndex(int32 X, int32 Y, int32 Z) const
@@ -708,7 +1414,11 @@ void UGPUSDFCutter::DispatchLocalUpdate()
     FBox CapturedToolBounds = ToolLocalBounds;
     FIntVector CapturedSDFDimensions = SDFDimensions;
 
-    FTextureResource* ToolResource = ToolSDFTexture->GetResource();
+    // 解析刀具形状：按核类型选择着色器排列，不需要工具纹理
+    const ESDFToolKernel ToolKernel = ToolShape.GetKernel();
+    FSDFToolShape CapturedToolShape = ToolShape;
+
+    FTextureResource* ToolResource = (ToolKernel == ESDFToolKernel::MeshTexture && ToolSDFTexture) ? ToolSDFTexture->GetResource() : nullptr;
     FTextureResource* RenderTargetResource = VolumeRT->GetResource();
 
     // 3. 发送渲染命令
@@ -717,13 +1427,14 @@ void UGPUSDFCutter::DispatchLocalUpdate()
          CapturedTargetBounds, CapturedToolBounds,
          TargetSpaceToToolSpaceTransform,
          CapturedSDFDimensions,
-         ToolResource, RenderTargetResource]
+         ToolResource, RenderTargetResource,
+         ToolKernel, CapturedToolShape]
         (FRHICommandListImmediate& RHICmdList)
         {
             FRHITexture* ToolRHI = ToolResource ? ToolResource->GetTextureRHI() : nullptr;
             FRHITexture* VolumeRHI = RenderTargetResource ? RenderTargetResource->GetTextureRHI() : nullptr;
 
-            if (!ToolRHI || !VolumeRHI)
+            if ((ToolKernel == ESDFToolKernel::MeshTexture && !ToolRHI) || !VolumeRHI)
             {
                 bIsReadingBack = false;
                 return;
@@ -731,8 +1442,8 @@ void UGPUSDFCutter::DispatchLocalUpdate()
 
             FRDGBuilder GraphBuilder(RHICmdList);
 
-            // --- A. 执行 Compute Shader 切削 (保持不变) ---
-            FRDGTextureRef ToolTexture = RegisterExternalTexture(GraphBuilder, ToolRHI, TEXT("ToolSDF"));
+            // --- A. 执行 Compute Shader 切削 ---
+            FRDGTextureRef ToolTexture = ToolRHI ? RegisterExternalTexture(GraphBuilder, ToolRHI, TEXT("ToolSDF")) : nullptr;
             FRDGTextureRef VolumeRTTexture = RegisterExternalTexture(GraphBuilder, VolumeRHI, TEXT("VolumeRT"));
 
             auto* CutUBParams = GraphBuilder.AllocParameters<FCutUB>();
@@ -744,11 +1455,12 @@ void UGPUSDFCutter::DispatchLocalUpdate()
             CutUBParams->SDFDimensions = CapturedSDFDimensions;
             CutUBParams->UpdateRegionMin = UpdateMin;
             CutUBParams->UpdateRegionMax = UpdateMax;
+            CapturedToolShape.SetShaderParameters(*CutUBParams);
 
             auto* PassParams = GraphBuilder.AllocParameters<FUpdateSDFCS::FParameters>();
             PassParams->Params = GraphBuilder.CreateUniformBuffer(CutUBParams);
             PassParams->InputSDF = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(VolumeRTTexture));
-            PassParams->ToolSDF = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(ToolTexture));
+            PassParams->ToolSDF = ToolTexture ? GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(ToolTexture)) : nullptr;
             PassParams->OutputSDF = GraphBuilder.CreateUAV(VolumeRTTexture);
             PassParams->InputSDFSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
             PassParams->ToolSDFSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
@@ -758,7 +1470,9 @@ void UGPUSDFCutter::DispatchLocalUpdate()
             FIntVector DispatchSize = RegionSize + FIntVector(1, 1, 1); 
             FIntVector GroupCount = FComputeShaderUtils::GetGroupCount(DispatchSize, FIntVector(4, 4, 4));
 
-            TShaderMapRef<FUpdateSDFCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+            FUpdateSDFCS::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FUpdateSDFCS::FToolShapeDim>((int32)ToolKernel);
+            TShaderMapRef<FUpdateSDFCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel), PermutationVector);
             FComputeShaderUtils::AddPass(
                 GraphBuilder,
                 RDG_EVENT_NAME("LocalSDFUpdate"),
@@ -827,12 +1541,63 @@ void UGPUSDFCutter::DispatchLocalUpdate()
 
 void UGPUSDFCutter::CalculateToolDimensions()
 {
-
-	ToolLocalBounds = CutToolComponent->CalcLocalBounds().GetBox();
+	// 刀具库的刀具用条目自身的包围盒，否则解析刀具用图元的包围盒，网格刀具用组件的局部包围盒
+	const FSDFToolLibraryEntry* LibraryTool = ToolLibrary ? ToolLibrary->GetTool(AppliedToolIndex) : nullptr;
+	if (LibraryTool)
+	{
+		ToolLocalBounds = LibraryTool->GetLocalBounds();
+	}
+	else
+	{
+		ToolLocalBounds = ToolShape.IsAnalytic() ? ToolShape.GetLocalBounds() : CutToolComponent->CalcLocalBounds().GetBox();
+	}
 	// 计算工具尺寸
 	ToolOriginalSize = ToolLocalBounds.GetSize();
 }
 
+void UGPUSDFCutter::SetToolShape(const FSDFToolShape& NewShape)
+{
+	if (!NewShape.IsAnalytic() && !ToolSDFTexture)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GPUSDFCutter: Empty tool shape requires ToolSDFTexture"));
+		return;
+	}
+
+	ToolShape = NewShape;
+	if (bGPUResourcesInitialized && CutToolComponent)
+	{
+		CalculateToolDimensions();
+		bRelativeTransformDirty = true;
+	}
+}
+
+bool UGPUSDFCutter::SyncActiveTool()
+{
+	if (!ToolLibrary)
+	{
+		return false;
+	}
+
+	const int32 ToolIndex = ToolLibrary->GetActiveToolIndex();
+	const FSDFToolLibraryEntry* Tool = ToolLibrary->GetTool(ToolIndex);
+	if (ToolIndex == AppliedToolIndex || !Tool)
+	{
+		return false;
+	}
+
+	// 纹理在初始化时已确认常驻，这里只切换引用
+	ToolShape = Tool->Shape;
+	ToolSDFTexture = Tool->SDFTexture;
+	AppliedToolIndex = ToolIndex;
+
+	if (bGPUResourcesInitialized && CutToolComponent)
+	{
+		CalculateToolDimensions();
+		ToolSDFRHIRef = (ToolSDFTexture && ToolSDFTexture->GetResource()) ? ToolSDFTexture->GetResource()->GetTextureRHI() : nullptr;
+	}
+	return true;
+}
+
 bool UGPUSDFCutter::ExportToOBJ(
 	const FString& FilePath,
 	bool bIncludeNormals,
@@ -846,74 +1611,348 @@ bool UGPUSDFCutter::ExportToOBJWithDetail(
 	float CubeSize,
 	bool bIncludeNormals,
 	bool bIncludeMaterialColors)
+{
+	return ExportMesh(FilePath, ESDFExportFormat::OBJ, CubeSize, bIncludeNormals, bIncludeMaterialColors);
+}
+
+bool UGPUSDFCutter::ExportMesh(
+	const FString& FilePath,
+	ESDFExportFormat Format,
+	float CubeSize,
+	bool bIncludeNormals,
+	bool bIncludeMaterialColors)
 {
 	// Ensure we have valid data
 	if (CPU_SDFData.Num() == 0 || !TargetMeshComponent)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("ExportToOBJ: No SDF data available or target mesh not set"));
+		UE_LOG(LogTemp, Warning, TEXT("ExportMesh: No SDF data available or target mesh not set"));
 		return false;
 	}
 
-	// Acquire read lock to prevent data modification during export
-	FRWScopeLock ReadLock(DataRWLock, SLT_ReadOnly);
-
-	// Configure marching cubes
-	FSDFMeshExporter::FMarchingCubesConfig MCConfig;
-	MCConfig.IsoValue = 0.0f;
-	MCConfig.CubeSize = (CubeSize > 0.0f) ? CubeSize : VoxelSize;
-	MCConfig.bParallelCompute = true;
+	// STL has no per-vertex colors, skip material lookup
+	const bool bWantColors = bIncludeMaterialColors && Format != ESDFExportFormat::BinarySTL;
 
-	// Extract mesh
 	UE::Geometry::FDynamicMesh3 ExtractedMesh;
-	TArray<int32> MaterialIDs;
+	TArray<FLinearColor> VertexColors;
+	{
+		// Acquire read lock to prevent data modification during extraction
+		FRWScopeLock ReadLock(DataRWLock, SLT_ReadOnly);
 
-	bool bSuccess = FSDFMeshExporter::ExtractMeshFromSDF(
-		CPU_SDFData,
-		SDFDimensions,
-		VoxelSize,
-		TargetLocalBounds,
-		MCConfig,
-		ExtractedMesh,
-		bIncludeMaterialColors ? &MaterialIDs : nullptr
-	);
+		if (!ExtractExportMesh(CPU_SDFData, SDFDimensions, VoxelSize, TargetLocalBounds, CubeSize, bWantColors,
+			bExportWithDualContouring, ExtractedMesh, VertexColors))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ExportMesh: Mesh extraction failed or produced empty mesh"));
+			return false;
+		}
+	}
+
+	const bool bSuccess = WriteExportMesh(ExtractedMesh, VertexColors, FilePath, Format, bIncludeNormals);
 
-	if (!bSuccess || ExtractedMesh.TriangleCount() == 0)
+	if (bSuccess)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("ExportToOBJ: Mesh extraction failed or produced empty mesh"));
-		return false;
+		UE_LOG(LogTemp, Log, TEXT("ExportMesh: Successfully exported %d triangles to %s"),
+			ExtractedMesh.TriangleCount(), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ExportMesh: Failed to write file %s"), *FilePath);
 	}
 
-	// Configure OBJ export
-	FSDFMeshExporter::FOBJExportConfig OBJConfig;
-	OBJConfig.bIncludeNormals = bIncludeNormals;
-	OBJConfig.bIncludeVertexColors = bIncludeMaterialColors;
-	OBJConfig.bReverseWinding = true; // UE left-handed to OBJ right-handed
+	return bSuccess;
+}
+
+bool UGPUSDFCutter::ExtractExportMesh(
+	const TArray<FFloat16Color>& SDFData,
+	const FIntVector& Dimensions,
+	float InVoxelSize,
+	const FBox& LocalBounds,
+	float CubeSize,
+	bool bWantColors,
+	bool bDualContouring,
+	UE::Geometry::FDynamicMesh3& OutMesh,
+	TArray<FLinearColor>& OutVertexColors,
+	FExportJob* Job)
+{
+	TFunction<bool()> CancelF;
+	if (Job)
+	{
+		CancelF = [Job]() { return Job->bCancelRequested.load(std::memory_order_relaxed); };
+	}
+
+	TArray<int32> MaterialIDs;
+	bool bExtracted = false;
+	if (bDualContouring)
+	{
+		// Cell size snaps to a whole number of voxels
+		FSDFMeshExporter::FDualContouringConfig DCConfig;
+		DCConfig.IsoValue = 0.0f;
+		DCConfig.Stride = (CubeSize > 0.0f) ? FMath::Max(1, FMath::RoundToInt(CubeSize / InVoxelSize)) : 1;
+		DCConfig.bParallelCompute = true;
+		DCConfig.CancelF = CancelF;
+
+		bExtracted = FSDFMeshExporter::ExtractMeshDualContouring(
+			SDFData,
+			Dimensions,
+			InVoxelSize,
+			LocalBounds,
+			DCConfig,
+			OutMesh,
+			bWantColors ? &MaterialIDs : nullptr
+		);
+	}
+	else
+	{
+		// Configure marching cubes
+		FSDFMeshExporter::FMarchingCubesConfig MCConfig;
+		MCConfig.IsoValue = 0.0f;
+		MCConfig.CubeSize = (CubeSize > 0.0f) ? CubeSize : InVoxelSize;
+		MCConfig.bParallelCompute = true;
+		MCConfig.CancelF = CancelF;
+
+		bExtracted = FSDFMeshExporter::ExtractMeshFromSDF(
+			SDFData,
+			Dimensions,
+			InVoxelSize,
+			LocalBounds,
+			MCConfig,
+			OutMesh,
+			bWantColors ? &MaterialIDs : nullptr
+		);
+	}
+
+	if (!bExtracted || OutMesh.TriangleCount() == 0)
+	{
+		return false;
+	}
 
 	// Convert material IDs to colors if needed
-	TArray<FLinearColor> VertexColors;
-	if (bIncludeMaterialColors && MaterialIDs.Num() > 0)
+	if (bWantColors && MaterialIDs.Num() > 0)
 	{
-		VertexColors = FSDFMeshExporter::MaterialIDsToColors(MaterialIDs);
+		OutVertexColors = FSDFMeshExporter::MaterialIDsToColors(MaterialIDs);
 	}
 
-	// Write to file
-	bSuccess = FSDFMeshExporter::WriteMeshToOBJ(
-		ExtractedMesh,
+	return true;
+}
+
+bool UGPUSDFCutter::WriteExportMesh(
+	const UE::Geometry::FDynamicMesh3& Mesh,
+	const TArray<FLinearColor>& VertexColors,
+	const FString& FilePath,
+	ESDFExportFormat Format,
+	bool bIncludeNormals)
+{
+	// Configure export
+	FSDFMeshExporter::FOBJExportConfig ExportConfig;
+	ExportConfig.bIncludeNormals = bIncludeNormals;
+	ExportConfig.bIncludeVertexColors = VertexColors.Num() > 0;
+	ExportConfig.bReverseWinding = true; // UE left-handed to right-handed
+
+	FSDFMeshExporter::EMeshFileFormat FileFormat = FSDFMeshExporter::EMeshFileFormat::OBJ;
+	switch (Format)
+	{
+	case ESDFExportFormat::BinaryPLY: FileFormat = FSDFMeshExporter::EMeshFileFormat::BinaryPLY; break;
+	case ESDFExportFormat::BinarySTL: FileFormat = FSDFMeshExporter::EMeshFileFormat::BinarySTL; break;
+	default: break;
+	}
+
+	return FSDFMeshExporter::WriteMeshToFile(
+		Mesh,
 		FilePath,
-		OBJConfig,
-		bIncludeMaterialColors ? &VertexColors : nullptr
+		FileFormat,
+		ExportConfig,
+		VertexColors.Num() > 0 ? &VertexColors : nullptr
 	);
+}
 
-	if (bSuccess)
+bool UGPUSDFCutter::ExportMeshAsync(
+	const FString& FilePath,
+	ESDFExportFormat Format,
+	float CubeSize,
+	bool bIncludeNormals,
+	bool bIncludeMaterialColors)
+{
+	check(IsInGameThread());
+
+	if (CPU_SDFData.Num() == 0 || !TargetMeshComponent)
 	{
-		UE_LOG(LogTemp, Log, TEXT("ExportToOBJ: Successfully exported %d triangles to %s"),
-			ExtractedMesh.TriangleCount(), *FilePath);
+		UE_LOG(LogTemp, Warning, TEXT("ExportMeshAsync: No SDF data available or target mesh not set"));
+		return false;
 	}
-	else
+
+	if (ActiveExportJob.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ExportMeshAsync: Another export is still running"));
+		return false;
+	}
+
+	// 1. 在一次读锁内用单个 memcpy 拷贝完整快照，保证导出的是同一时刻的体数据
+	//    (线性 memcpy，远快于在锁内做完整的 Marching Cubes + 写文件)，随后移动到后台任务
+	TArray<FFloat16Color> Snapshot;
 	{
-		UE_LOG(LogTemp, Warning, TEXT("ExportToOBJ: Failed to write file %s"), *FilePath);
+		FRWScopeLock ReadLock(DataRWLock, SLT_ReadOnly);
+		Snapshot.SetNumUninitialized(CPU_SDFData.Num());
+		FMemory::Memcpy(Snapshot.GetData(), CPU_SDFData.GetData(), CPU_SDFData.Num() * sizeof(FFloat16Color));
 	}
 
+	TSharedPtr<FExportJob, ESPMode::ThreadSafe> Job = MakeShared<FExportJob, ESPMode::ThreadSafe>();
+	ActiveExportJob = Job;
+
+	const bool bWantColors = bIncludeMaterialColors && Format != ESDFExportFormat::BinarySTL;
+	TWeakObjectPtr<UGPUSDFCutter> WeakThis(this);
+
+	// 进度回调：记录到共享状态，并投递到 GameThread 广播
+	auto ReportProgress = [WeakThis, Job](float Progress)
+	{
+		Job->Progress.store(Progress, std::memory_order_relaxed);
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Job, Progress]()
+		{
+			UGPUSDFCutter* Cutter = WeakThis.Get();
+			if (Cutter && Cutter->ActiveExportJob == Job)
+			{
+				Cutter->OnExportProgress.Broadcast(Progress);
+			}
+		});
+	};
+
+	// 2. 后台任务：提取网格 + 写文件
+	Async(EAsyncExecution::ThreadPool,
+		[WeakThis, Job, ReportProgress, Snapshot = MoveTemp(Snapshot), Dimensions = SDFDimensions, InVoxelSize = VoxelSize,
+		 LocalBounds = TargetLocalBounds, bDualContouring = bExportWithDualContouring,
+		 FilePath, Format, CubeSize, bIncludeNormals, bWantColors]()
+	{
+		ReportProgress(0.05f);
+
+		bool bSuccess = false;
+		int32 TriangleCount = 0;
+
+		UE::Geometry::FDynamicMesh3 ExtractedMesh;
+		TArray<FLinearColor> VertexColors;
+		if (ExtractExportMesh(Snapshot, Dimensions, InVoxelSize, LocalBounds, CubeSize, bWantColors,
+			bDualContouring, ExtractedMesh, VertexColors, Job.Get()))
+		{
+			ReportProgress(0.7f);
+
+			if (!Job->bCancelRequested)
+			{
+				bSuccess = WriteExportMesh(ExtractedMesh, VertexColors, FilePath, Format, bIncludeNormals);
+				TriangleCount = ExtractedMesh.TriangleCount();
+			}
+		}
+
+		const bool bCancelled = Job->bCancelRequested;
+		if (bCancelled)
+		{
+			UE_LOG(LogTemp, Log, TEXT("ExportMeshAsync: Export to %s cancelled"), *FilePath);
+			bSuccess = false;
+		}
+		else if (bSuccess)
+		{
+			UE_LOG(LogTemp, Log, TEXT("ExportMeshAsync: Successfully exported %d triangles to %s"), TriangleCount, *FilePath);
+			ReportProgress(1.0f);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ExportMeshAsync: Failed to export %s"), *FilePath);
+		}
+
+		// 3. 回到 GameThread 通知完成 (组件可能已被销毁)
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Job, bSuccess, FilePath, TriangleCount]()
+		{
+			UGPUSDFCutter* Cutter = WeakThis.Get();
+			if (!Cutter || Cutter->ActiveExportJob != Job)
+			{
+				return;
+			}
+
+			Cutter->ActiveExportJob.Reset();
+			Cutter->OnExportCompleted.Broadcast(bSuccess, FilePath, bSuccess ? TriangleCount : 0);
+		});
+	});
+
+	return true;
+}
+
+void UGPUSDFCutter::CancelAsyncExport()
+{
+	if (ActiveExportJob.IsValid())
+	{
+		ActiveExportJob->bCancelRequested = true;
+	}
+}
+
+float UGPUSDFCutter::GetAsyncExportProgress() const
+{
+	return ActiveExportJob.IsValid() ? ActiveExportJob->Progress.load(std::memory_order_relaxed) : 0.0f;
+}
+
+void UGPUSDFCutter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// 后台任务只持有快照和共享状态，取消后自行结束，完成回调因 WeakThis 失效而被忽略
+	CancelAsyncExport();
+	ActiveExportJob.Reset();
+	CancelInitialization();
+	ActiveInitJob.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UGPUSDFCutter::BenchmarkMeshWriters(const FString& Directory, float CubeSize)
+{
+	if (CPU_SDFData.Num() == 0 || !TargetMeshComponent)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BenchmarkMeshWriters: No SDF data available or target mesh not set"));
+		return;
+	}
+
+	UE::Geometry::FDynamicMesh3 ExtractedMesh;
+	TArray<FLinearColor> VertexColors;
+	{
+		FRWScopeLock ReadLock(DataRWLock, SLT_ReadOnly);
+
+		if (!ExtractExportMesh(CPU_SDFData, SDFDimensions, VoxelSize, TargetLocalBounds, CubeSize, true,
+			bExportWithDualContouring, ExtractedMesh, VertexColors))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("BenchmarkMeshWriters: Mesh extraction failed or produced empty mesh"));
+			return;
+		}
+	}
+
+	FSDFMeshExporter::RunWriterBenchmark(ExtractedMesh, Directory, VertexColors.Num() > 0 ? &VertexColors : nullptr);
+}
+
+bool UGPUSDFCutter::ExtractMeshToDynamicMesh(
+	UDynamicMesh* TargetMesh,
+	TArray<int32>& OutMaterialIDs,
+	float CubeSize)
+{
+	OutMaterialIDs.Reset();
+
+	if (!TargetMesh || CPU_SDFData.Num() == 0 || !TargetMeshComponent)
+	{
+		return false;
+	}
+
+	FRWScopeLock ReadLock(DataRWLock, SLT_ReadOnly);
+
+	bool bSuccess = false;
+	TargetMesh->EditMesh([&](UE::Geometry::FDynamicMesh3& EditMesh)
+	{
+		if (bExportWithDualContouring)
+		{
+			FSDFMeshExporter::FDualContouringConfig DCConfig;
+			DCConfig.Stride = (CubeSize > 0.0f) ? FMath::Max(1, FMath::RoundToInt(CubeSize / VoxelSize)) : 1;
+			bSuccess = FSDFMeshExporter::ExtractMeshDualContouring(
+				CPU_SDFData, SDFDimensions, VoxelSize, TargetLocalBounds, DCConfig, EditMesh, &OutMaterialIDs);
+		}
+		else
+		{
+			FSDFMeshExporter::FMarchingCubesConfig MCConfig;
+			MCConfig.CubeSize = (CubeSize > 0.0f) ? CubeSize : VoxelSize;
+			bSuccess = FSDFMeshExporter::ExtractMeshFromSDF(
+				CPU_SDFData, SDFDimensions, VoxelSize, TargetLocalBounds, MCConfig, EditMesh, &OutMaterialIDs);
+		}
+	}, EDynamicMeshChangeType::GeneralEdit, EDynamicMeshAttributeChangeFlags::Unknown);
+
 	return bSuccess;
 }
 
@@ -941,15 +1980,16 @@ bool UGPUSDFCutter::ExtractMesh(
 	MCConfig.CubeSize = (CubeSize > 0.0f) ? CubeSize : VoxelSize;
 	MCConfig.bParallelCompute = true;
 
-	UE::Geometry::FDynamicMesh3 ExtractedMesh;
-
-	bool bSuccess = FSDFMeshExporter::ExtractMeshFromSDF(
+	// Written straight into the caller's arrays, vertex indices are compact by construction
+	const bool bSuccess = FSDFMeshExporter::ExtractCompactMeshFromSDF(
 		CPU_SDFData,
 		SDFDimensions,
 		VoxelSize,
 		TargetLocalBounds,
 		MCConfig,
-		ExtractedMesh,
+		OutVertices,
+		OutTriangles,
+		&OutNormals,
 		&OutMaterialIDs
 	);
 
@@ -958,46 +1998,5 @@ bool UGPUSDFCutter::ExtractMesh(
 		return false;
 	}
 
-	// Convert FDynamicMesh3 to arrays
-	// Build vertex ID map
-	TMap<int32, int32> VertexIDToArrayIndex;
-	int32 ArrayIndex = 0;
-
-	for (int32 VertexID : ExtractedMesh.VertexIndicesItr())
-	{
-		FVector3d Pos = ExtractedMesh.GetVertex(VertexID);
-		OutVertices.Add(FVector(Pos.X, Pos.Y, Pos.Z));
-
-		if (ExtractedMesh.HasVertexNormals())
-		{
-			FVector3f Normal = ExtractedMesh.GetVertexNormal(VertexID);
-			OutNormals.Add(FVector(Normal.X, Normal.Y, Normal.Z));
-		}
-
-		VertexIDToArrayIndex.Add(VertexID, ArrayIndex);
-		ArrayIndex++;
-	}
-
-	// Convert triangles
-	for (int32 TriID : ExtractedMesh.TriangleIndicesItr())
-	{
-		UE::Geometry::FIndex3i Tri = ExtractedMesh.GetTriangle(TriID);
-		OutTriangles.Add(VertexIDToArrayIndex[Tri.A]);
-		OutTriangles.Add(VertexIDToArrayIndex[Tri.B]);
-		OutTriangles.Add(VertexIDToArrayIndex[Tri.C]);
-	}
-
-	// Reindex material IDs to match new vertex array
-	TArray<int32> ReindexedMaterialIDs;
-	ReindexedMaterialIDs.SetNum(OutVertices.Num());
-	for (const TPair<int32, int32>& Pair : VertexIDToArrayIndex)
-	{
-		if (OutMaterialIDs.IsValidIndex(Pair.Key))
-		{
-			ReindexedMaterialIDs[Pair.Value] = OutMaterialIDs[Pair.Key];
-		}
-	}
-	OutMaterialIDs = MoveTemp(ReindexedMaterialIDs);
-
 	return OutVertices.Num() > 0;
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+// SDFCacheFile.cpp
+
+#include "SDFCacheFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+FString FSDFCacheFile::GetCachePath(const TCHAR* Category, uint64 Key)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SDFCut"), Category, FString::Printf(TEXT("%016llx.bin"), Key));
+}
+
+bool FSDFCacheFile::Write(const FString& FilePath, uint32 Magic, uint32 Version, uint64 Key, TFunctionRef<void(FArchive&)> WritePayload)
+{
+	// 先写临时文件再改名，防止中途失败留下半个缓存文件
+	const FString TempPath = FilePath + TEXT(".tmp");
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SDFCacheFile: Cannot create %s"), *TempPath);
+		return false;
+	}
+
+	FHeader Header;
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.Key = Key;
+
+	// 先占位写文件头，负载写完后回填大小
+	Writer->Serialize(&Header, sizeof(FHeader));
+	const int64 PayloadStart = Writer->Tell();
+	WritePayload(*Writer);
+	Header.PayloadSize = Writer->Tell() - PayloadStart;
+	Writer->Seek(0);
+	Writer->Serialize(&Header, sizeof(FHeader));
+
+	const bool bWriteOk = !Writer->IsError() && Writer->Close();
+	Writer.Reset();
+
+	if (!bWriteOk)
+	{
+		IFileManager::Get().Delete(*TempPath);
+		return false;
+	}
+
+	return IFileManager::Get().Move(*FilePath, *TempPath, true, true);
+}
+
+bool FSDFCacheFile::ReadMapped(const FString& FilePath, uint32 Magic, uint32 Version, uint64 Key, TFunctionRef<bool(const uint8*, int64)> ReadPayload)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*FilePath))
+	{
+		return false;
+	}
+
+	FOpenMappedResult OpenResult = PlatformFile.OpenMappedEx(*FilePath);
+	if (OpenResult.HasError())
+	{
+		return false;
+	}
+
+	TUniquePtr<IMappedFileHandle> MappedHandle = OpenResult.StealValue();
+	const int64 FileSize = MappedHandle->GetFileSize();
+	if (FileSize < (int64)sizeof(FHeader))
+	{
+		return false;
+	}
+
+	bool bResult = false;
+	{
+		// Region 必须先于 Handle 释放
+		TUniquePtr<IMappedFileRegion> Region(MappedHandle->MapRegion(0, FileSize));
+		if (!Region)
+		{
+			return false;
+		}
+
+		const uint8* Data = Region->GetMappedPtr();
+
+		FHeader Header;
+		FMemory::Memcpy(&Header, Data, sizeof(FHeader));
+
+		if (Header.Magic == Magic && Header.Version == Version && Header.Key == Key &&
+			(int64)Header.PayloadSize == FileSize - (int64)sizeof(FHeader))
+		{
+			bResult = ReadPayload(Data + sizeof(FHeader), (int64)Header.PayloadSize);
+		}
+	}
+
+	return bResult;
+}
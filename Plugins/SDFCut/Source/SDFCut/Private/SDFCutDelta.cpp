@@ -0,0 +1,125 @@
+// SDFCutDelta.cpp
+
+#include "SDFCutDelta.h"
+
+void FSDFCutDelta::AddUnchanged(int32 Count)
+{
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	if (Runs.Num() > 0 && Runs.Last().Count == 0)
+	{
+		Runs.Last().Skip += Count;
+	}
+	else
+	{
+		Runs.Add({ Count, 0 });
+	}
+}
+
+void FSDFCutDelta::AddChanged(const FFloat16Color& Old, const FFloat16Color& New)
+{
+	if (Runs.Num() == 0)
+	{
+		Runs.AddDefaulted();
+	}
+
+	Runs.Last().Count++;
+	OldValues.Add(Old);
+	NewValues.Add(New);
+}
+
+void FSDFCutDelta::BuildFromSparse(TArray<FSparseEntry>& Entries)
+{
+	Runs.Reset();
+	OldValues.Reset(Entries.Num());
+	NewValues.Reset(Entries.Num());
+
+	Entries.Sort([](const FSparseEntry& A, const FSparseEntry& B) { return A.Index < B.Index; });
+
+	int32 NextIndex = 0;
+	for (const FSparseEntry& Entry : Entries)
+	{
+		if (Entry.Index < NextIndex)
+		{
+			// 重复索引
+			continue;
+		}
+
+		AddUnchanged(Entry.Index - NextIndex);
+		AddChanged(Entry.Old, Entry.New);
+		NextIndex = Entry.Index + 1;
+	}
+}
+
+SIZE_T FSDFCutDelta::GetAllocatedSize() const
+{
+	return Runs.GetAllocatedSize() + OldValues.GetAllocatedSize() + NewValues.GetAllocatedSize();
+}
+
+FSDFCutDeltaChannel::FSubscriptionRef FSDFCutDeltaChannel::Subscribe()
+{
+	FSubscriptionRef Subscription = MakeShared<FSubscription, ESPMode::ThreadSafe>();
+
+	FRWScopeLock WriteLock(SubscribersLock, SLT_Write);
+	PruneExpiredLocked();
+	Subscribers.Add(Subscription);
+	NumSubscribers.store(Subscribers.Num(), std::memory_order_relaxed);
+
+	return Subscription;
+}
+
+void FSDFCutDeltaChannel::Unsubscribe(const FSubscriptionRef& Subscription)
+{
+	FRWScopeLock WriteLock(SubscribersLock, SLT_Write);
+	Subscribers.RemoveAll([&Subscription](const TWeakPtr<FSubscription, ESPMode::ThreadSafe>& Weak)
+	{
+		return Weak.HasSameObject(&Subscription.Get());
+	});
+	PruneExpiredLocked();
+}
+
+void FSDFCutDeltaChannel::PruneExpiredLocked()
+{
+	Subscribers.RemoveAll([](const TWeakPtr<FSubscription, ESPMode::ThreadSafe>& Weak) { return !Weak.IsValid(); });
+	NumSubscribers.store(Subscribers.Num(), std::memory_order_relaxed);
+}
+
+void FSDFCutDeltaChannel::Publish(TSharedRef<FSDFCutDelta, ESPMode::ThreadSafe> Delta)
+{
+	// 订阅者队列是单生产者的
+	check(IsInGameThread());
+
+	if (Delta->IsEmpty())
+	{
+		return;
+	}
+
+	Delta->Sequence = LastSequence.fetch_add(1, std::memory_order_relaxed) + 1;
+	Delta->Timestamp = FPlatformTime::Seconds();
+
+	const FDeltaPtr Shared = Delta;
+	bool bHasExpired = false;
+	{
+		FRWScopeLock ReadLock(SubscribersLock, SLT_ReadOnly);
+		for (const TWeakPtr<FSubscription, ESPMode::ThreadSafe>& Weak : Subscribers)
+		{
+			if (TSharedPtr<FSubscription, ESPMode::ThreadSafe> Subscription = Weak.Pin())
+			{
+				Subscription->Queue.Enqueue(Shared);
+			}
+			else
+			{
+				bHasExpired = true;
+			}
+		}
+	}
+
+	if (bHasExpired)
+	{
+		FRWScopeLock WriteLock(SubscribersLock, SLT_Write);
+		PruneExpiredLocked();
+	}
+}
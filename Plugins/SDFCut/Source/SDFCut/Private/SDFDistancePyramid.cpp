@@ -0,0 +1,338 @@
+// SDFDistancePyramid.cpp
+
+#include "SDFDistancePyramid.h"
+#include "Async/ParallelFor.h"
+
+namespace SDFDistancePyramidPrivate
+{
+	// 单元数少于该值时单线程重建 (局部更新通常只有几十个单元)
+	static constexpr int32 MinCellsForParallel = 4096;
+
+	// 跳出单元时多走的距离 (体素)，保证落入下一个单元
+	static constexpr float CellExitEpsilon = 1.0e-3f;
+
+	// AdvanceRay 的最大跳跃次数
+	static constexpr int32 MaxRaySkips = 256;
+
+	// 合并两个下界：同号取更靠近 0 的一个，异号或任一为 0 则结果为 0
+	FORCEINLINE float CombineBounds(float A, float B)
+	{
+		if (A > 0.0f && B > 0.0f)
+		{
+			return FMath::Min(A, B);
+		}
+		if (A < 0.0f && B < 0.0f)
+		{
+			return FMath::Max(A, B);
+		}
+		return 0.0f;
+	}
+}
+
+void FSDFDistancePyramid::Reset()
+{
+	Dimensions = FIntVector::ZeroValue;
+	LevelDims.Reset();
+	Levels.Reset();
+}
+
+void FSDFDistancePyramid::Build(const TArray<FFloat16Color>& Data, const FIntVector& InDimensions)
+{
+	Reset();
+
+	if (InDimensions.X <= 0 || InDimensions.Y <= 0 || InDimensions.Z <= 0 ||
+		Data.Num() != InDimensions.X * InDimensions.Y * InDimensions.Z)
+	{
+		return;
+	}
+
+	Dimensions = InDimensions;
+
+	// 第 0 层：单元 c 覆盖采样点 [2c, 2c + 2]，需要 ceil((N - 1) / 2) 个单元覆盖 [0, N - 1]
+	FIntVector Dims(
+		FMath::Max(1, FMath::DivideAndRoundUp(Dimensions.X - 1, 2)),
+		FMath::Max(1, FMath::DivideAndRoundUp(Dimensions.Y - 1, 2)),
+		FMath::Max(1, FMath::DivideAndRoundUp(Dimensions.Z - 1, 2)));
+
+	// 逐层减半，直到只剩一个单元
+	while (true)
+	{
+		LevelDims.Add(Dims);
+		Levels.AddDefaulted_GetRef().SetNumZeroed(Dims.X * Dims.Y * Dims.Z);
+
+		if (Dims.X == 1 && Dims.Y == 1 && Dims.Z == 1)
+		{
+			break;
+		}
+
+		Dims = FIntVector(
+			FMath::DivideAndRoundUp(Dims.X, 2),
+			FMath::DivideAndRoundUp(Dims.Y, 2),
+			FMath::DivideAndRoundUp(Dims.Z, 2));
+	}
+
+	for (int32 Level = 0; Level < Levels.Num(); Level++)
+	{
+		RebuildCells(Level == 0 ? &Data : nullptr, Level, FIntVector::ZeroValue, LevelDims[Level] - FIntVector(1));
+	}
+}
+
+void FSDFDistancePyramid::UpdateRegion(const TArray<FFloat16Color>& Data, const FIntVector& RegionMin, const FIntVector& RegionSize)
+{
+	if (!IsValid() || Data.Num() != Dimensions.X * Dimensions.Y * Dimensions.Z)
+	{
+		return;
+	}
+
+	if (RegionSize.X <= 0 || RegionSize.Y <= 0 || RegionSize.Z <= 0)
+	{
+		return;
+	}
+
+	// 采样点 v 属于满足 2c <= v <= 2c + 2 的第 0 层单元，即 c ∈ [ceil(v / 2) - 1, floor(v / 2)]
+	FIntVector CellMin, CellMax;
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		const int32 First = FMath::Clamp(RegionMin[Axis], 0, Dimensions[Axis] - 1);
+		const int32 Last = FMath::Clamp(RegionMin[Axis] + RegionSize[Axis] - 1, 0, Dimensions[Axis] - 1);
+		CellMin[Axis] = FMath::Clamp(((First + 1) >> 1) - 1, 0, LevelDims[0][Axis] - 1);
+		CellMax[Axis] = FMath::Clamp(Last >> 1, 0, LevelDims[0][Axis] - 1);
+	}
+
+	for (int32 Level = 0; Level < Levels.Num(); Level++)
+	{
+		RebuildCells(Level == 0 ? &Data : nullptr, Level, CellMin, CellMax);
+
+		// 上一层受影响的单元
+		CellMin = FIntVector(CellMin.X >> 1, CellMin.Y >> 1, CellMin.Z >> 1);
+		CellMax = FIntVector(CellMax.X >> 1, CellMax.Y >> 1, CellMax.Z >> 1);
+	}
+}
+
+void FSDFDistancePyramid::RebuildCells(const TArray<FFloat16Color>* Data, int32 Level, const FIntVector& CellMin, const FIntVector& CellMax)
+{
+	const FIntVector Dims = LevelDims[Level];
+	const FIntVector Count = CellMax - CellMin + FIntVector(1);
+	const int32 NumRows = Count.Y * Count.Z;
+	TArray<float>& Cells = Levels[Level];
+
+	ParallelFor(NumRows, [&](int32 Row)
+	{
+		const int32 CY = CellMin.Y + Row % Count.Y;
+		const int32 CZ = CellMin.Z + Row / Count.Y;
+		float* RowCells = &Cells[(CZ * Dims.Y + CY) * Dims.X];
+
+		for (int32 CX = CellMin.X; CX <= CellMax.X; CX++)
+		{
+			RowCells[CX] = Data ? ComputeBaseCell(*Data, CX, CY, CZ) : ComputeParentCell(Level, CX, CY, CZ);
+		}
+	}, Count.X * NumRows < SDFDistancePyramidPrivate::MinCellsForParallel ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+float FSDFDistancePyramid::ComputeBaseCell(const TArray<FFloat16Color>& Data, int32 CX, int32 CY, int32 CZ) const
+{
+	const int32 X0 = CX * 2, X1 = FMath::Min(X0 + 2, Dimensions.X - 1);
+	const int32 Y0 = CY * 2, Y1 = FMath::Min(Y0 + 2, Dimensions.Y - 1);
+	const int32 Z0 = CZ * 2, Z1 = FMath::Min(Z0 + 2, Dimensions.Z - 1);
+	const int32 SliceSize = Dimensions.X * Dimensions.Y;
+
+	float MinOutside = TNumericLimits<float>::Max();
+	float MinInside = TNumericLimits<float>::Max();
+	bool bHasOutside = false;
+	bool bHasInside = false;
+
+	for (int32 Z = Z0; Z <= Z1; Z++)
+	{
+		for (int32 Y = Y0; Y <= Y1; Y++)
+		{
+			const FFloat16Color* RowData = &Data[Z * SliceSize + Y * Dimensions.X];
+			for (int32 X = X0; X <= X1; X++)
+			{
+				const float D = RowData[X].R.GetFloat();
+				if (D > 0.0f)
+				{
+					bHasOutside = true;
+					MinOutside = FMath::Min(MinOutside, D);
+				}
+				else if (D < 0.0f)
+				{
+					bHasInside = true;
+					MinInside = FMath::Min(MinInside, -D);
+				}
+				else
+				{
+					// 采样点恰好在表面上
+					return 0.0f;
+				}
+			}
+		}
+	}
+
+	if (bHasOutside == bHasInside)
+	{
+		// 符号变化 (或 NaN 导致两者都没有)
+		return 0.0f;
+	}
+	return bHasOutside ? MinOutside : -MinInside;
+}
+
+float FSDFDistancePyramid::ComputeParentCell(int32 Level, int32 CX, int32 CY, int32 CZ) const
+{
+	const FIntVector& ChildDims = LevelDims[Level - 1];
+	const int32 X0 = CX * 2, X1 = FMath::Min(X0 + 1, ChildDims.X - 1);
+	const int32 Y0 = CY * 2, Y1 = FMath::Min(Y0 + 1, ChildDims.Y - 1);
+	const int32 Z0 = CZ * 2, Z1 = FMath::Min(Z0 + 1, ChildDims.Z - 1);
+
+	float Result = GetCell(Level - 1, X0, Y0, Z0);
+	for (int32 Z = Z0; Z <= Z1 && Result != 0.0f; Z++)
+	{
+		for (int32 Y = Y0; Y <= Y1; Y++)
+		{
+			for (int32 X = X0; X <= X1; X++)
+			{
+				Result = SDFDistancePyramidPrivate::CombineBounds(Result, GetCell(Level - 1, X, Y, Z));
+			}
+		}
+	}
+	return Result;
+}
+
+FIntVector FSDFDistancePyramid::GetCellCoord(int32 Level, const FVector& VoxelCoord) const
+{
+	const float InvCellSize = 1.0f / GetCellSize(Level);
+	const FIntVector& Dims = LevelDims[Level];
+	return FIntVector(
+		FMath::Clamp(FMath::FloorToInt(VoxelCoord.X * InvCellSize), 0, Dims.X - 1),
+		FMath::Clamp(FMath::FloorToInt(VoxelCoord.Y * InvCellSize), 0, Dims.Y - 1),
+		FMath::Clamp(FMath::FloorToInt(VoxelCoord.Z * InvCellSize), 0, Dims.Z - 1));
+}
+
+float FSDFDistancePyramid::GetDistanceLowerBound(const FVector& VoxelCoord) const
+{
+	// 每一层都是合法的下界；细层通常更紧，但粗层在大片空白区域同样有效，取最大值
+	float Bound = 0.0f;
+	for (int32 Level = 0; Level < Levels.Num(); Level++)
+	{
+		const FIntVector Cell = GetCellCoord(Level, VoxelCoord);
+		Bound = FMath::Max(Bound, FMath::Abs(GetCell(Level, Cell.X, Cell.Y, Cell.Z)));
+	}
+	return Bound;
+}
+
+bool FSDFDistancePyramid::IsRegionClear(const FBox& VoxelBox, float MinClearance) const
+{
+	if (!IsValid())
+	{
+		return false;
+	}
+
+	const int32 Top = Levels.Num() - 1;
+	return IsRegionClearRecursive(Top, GetCellCoord(Top, VoxelBox.Min), GetCellCoord(Top, VoxelBox.Max),
+		VoxelBox.Min, VoxelBox.Max, MinClearance);
+}
+
+bool FSDFDistancePyramid::IsRegionClearRecursive(int32 Level, const FIntVector& CellMin, const FIntVector& CellMax,
+	const FVector& BoxMin, const FVector& BoxMax, float MinClearance) const
+{
+	// 下一层中与包围盒相交的单元范围
+	const FIntVector ChildBoxMin = Level > 0 ? GetCellCoord(Level - 1, BoxMin) : FIntVector::ZeroValue;
+	const FIntVector ChildBoxMax = Level > 0 ? GetCellCoord(Level - 1, BoxMax) : FIntVector::ZeroValue;
+
+	for (int32 CZ = CellMin.Z; CZ <= CellMax.Z; CZ++)
+	{
+		for (int32 CY = CellMin.Y; CY <= CellMax.Y; CY++)
+		{
+			for (int32 CX = CellMin.X; CX <= CellMax.X; CX++)
+			{
+				if (GetCell(Level, CX, CY, CZ) > MinClearance)
+				{
+					continue;
+				}
+
+				if (Level == 0)
+				{
+					return false;
+				}
+
+				// 该单元不够远，只细分它与包围盒相交的子单元
+				const FIntVector ChildMin(
+					FMath::Max(CX * 2, ChildBoxMin.X),
+					FMath::Max(CY * 2, ChildBoxMin.Y),
+					FMath::Max(CZ * 2, ChildBoxMin.Z));
+				const FIntVector ChildMax(
+					FMath::Min(CX * 2 + 1, ChildBoxMax.X),
+					FMath::Min(CY * 2 + 1, ChildBoxMax.Y),
+					FMath::Min(CZ * 2 + 1, ChildBoxMax.Z));
+
+				if (!IsRegionClearRecursive(Level - 1, ChildMin, ChildMax, BoxMin, BoxMax, MinClearance))
+				{
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+float FSDFDistancePyramid::AdvanceRay(const FVector& Origin, const FVector& Direction, float StartT, float EndT, float MinClearance) const
+{
+	const float DirLength = Direction.Size();
+	if (!IsValid() || DirLength < KINDA_SMALL_NUMBER)
+	{
+		return StartT;
+	}
+
+	const float ExitEpsilonT = SDFDistancePyramidPrivate::CellExitEpsilon / DirLength;
+	const int32 Top = Levels.Num() - 1;
+
+	float T = StartT;
+	for (int32 Skip = 0; Skip < SDFDistancePyramidPrivate::MaxRaySkips && T < EndT; Skip++)
+	{
+		const FVector P = Origin + Direction * T;
+
+		// 从最粗层开始找第一个足够远的单元
+		int32 Level = Top;
+		FIntVector Cell;
+		for (; Level >= 0; Level--)
+		{
+			Cell = GetCellCoord(Level, P);
+			if (GetCell(Level, Cell.X, Cell.Y, Cell.Z) > MinClearance)
+			{
+				break;
+			}
+		}
+
+		if (Level < 0)
+		{
+			// 最细层也可能低于阈值：交给调用方精细步进
+			return T;
+		}
+
+		// 跳到单元出口 (边界单元按钳制规则向外无限延伸)
+		const FIntVector& Dims = LevelDims[Level];
+		const float CellSize = (float)GetCellSize(Level);
+		float ExitT = TNumericLimits<float>::Max();
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			const float D = Direction[Axis];
+			if (D > 0.0f && Cell[Axis] < Dims[Axis] - 1)
+			{
+				ExitT = FMath::Min(ExitT, ((Cell[Axis] + 1) * CellSize - P[Axis]) / D);
+			}
+			else if (D < 0.0f && Cell[Axis] > 0)
+			{
+				ExitT = FMath::Min(ExitT, (Cell[Axis] * CellSize - P[Axis]) / D);
+			}
+		}
+
+		if (ExitT == TNumericLimits<float>::Max())
+		{
+			// 射线永远不会离开这个单元
+			return EndT;
+		}
+
+		T += FMath::Max(ExitT, 0.0f) + ExitEpsilonT;
+	}
+
+	return FMath::Min(T, EndT);
+}
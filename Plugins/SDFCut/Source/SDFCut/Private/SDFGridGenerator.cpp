@@ -0,0 +1,494 @@
+// SDFGridGenerator.cpp
+
+#include "SDFGridGenerator.h"
+#include "DynamicMesh/DynamicMeshAABBTree3.h"
+#include "Distance/DistPoint3Triangle3.h"
+#include "Spatial/FastWinding.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+
+using namespace UE::Geometry;
+
+namespace SDFGridGeneratorPrivate
+{
+	FORCEINLINE double PointTriangleDistance(const FVector3d& Point, const FTriangle3d& Triangle)
+	{
+		TDistPoint3Triangle3<double> Query(Point, Triangle);
+		return FMath::Sqrt(Query.GetSquared());
+	}
+
+	FORCEINLINE EParallelForFlags GetParallelFlags(const FSDFGridGenerator::FConfig& Config)
+	{
+		return Config.bParallelCompute ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+	}
+}
+
+bool FSDFGridGenerator::Generate(const FDynamicMesh3& Mesh, const FSDFGridDesc& Grid, const FConfig& Config, TArray<float>& OutDistances)
+{
+	using namespace SDFGridGeneratorPrivate;
+
+	OutDistances.Reset();
+	if (!Grid.IsValid() || Mesh.TriangleCount() == 0)
+	{
+		return false;
+	}
+
+	const FIntVector Dims = Grid.Dimensions;
+	const int32 SliceSize = Dims.X * Dims.Y;
+	const int32 NumSamples = Grid.GetNumSamples();
+	const EParallelForFlags ParallelFlags = GetParallelFlags(Config);
+
+	// 0. 三角形缓存 (三角形 ID 可能不连续，这里压缩成连续下标)
+	TArray<FTriangle3d> Triangles;
+	Triangles.Reserve(Mesh.TriangleCount());
+	for (int32 TriangleID : Mesh.TriangleIndicesItr())
+	{
+		FVector3d A, B, C;
+		Mesh.GetTriVertices(TriangleID, A, B, C);
+		Triangles.Add(FTriangle3d(A, B, C));
+	}
+
+	TArray<float> Distances;
+	Distances.Init(TNumericLimits<float>::Max(), NumSamples);
+	TArray<int32> ClosestTriangle;
+	ClosestTriangle.Init(INDEX_NONE, NumSamples);
+
+	// 1. 窄带：三角形包围盒外扩 BandWidth 个采样点，按 Z 切片分桶
+	const int32 Band = FMath::Max(Config.BandWidth, 1);
+	TArray<FIntVector> RangeMin, RangeMax;
+	RangeMin.SetNumUninitialized(Triangles.Num());
+	RangeMax.SetNumUninitialized(Triangles.Num());
+
+	ParallelFor(Triangles.Num(), [&](int32 TriIndex)
+	{
+		const FTriangle3d& Tri = Triangles[TriIndex];
+		FIntVector Min, Max;
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			const double Lo = FMath::Min3(Tri.V[0][Axis], Tri.V[1][Axis], Tri.V[2][Axis]);
+			const double Hi = FMath::Max3(Tri.V[0][Axis], Tri.V[1][Axis], Tri.V[2][Axis]);
+			// 网格外的三角形被钳制到边界层，保证传播时仍然是候选
+			Min[Axis] = FMath::Clamp(FMath::FloorToInt((Lo - Grid.Origin[Axis]) / Grid.Spacing[Axis]) - Band + 1, 0, Dims[Axis] - 1);
+			Max[Axis] = FMath::Clamp(FMath::CeilToInt((Hi - Grid.Origin[Axis]) / Grid.Spacing[Axis]) + Band - 1, 0, Dims[Axis] - 1);
+		}
+		RangeMin[TriIndex] = Min;
+		RangeMax[TriIndex] = Max;
+	}, ParallelFlags);
+
+	TArray<TArray<int32>> SliceBuckets;
+	SliceBuckets.SetNum(Dims.Z);
+	for (int32 TriIndex = 0; TriIndex < Triangles.Num(); TriIndex++)
+	{
+		for (int32 Z = RangeMin[TriIndex].Z; Z <= RangeMax[TriIndex].Z; Z++)
+		{
+			SliceBuckets[Z].Add(TriIndex);
+		}
+	}
+
+	// 每个切片只由一个线程写入
+	ParallelFor(Dims.Z, [&](int32 Z)
+	{
+		for (int32 TriIndex : SliceBuckets[Z])
+		{
+			const FTriangle3d& Tri = Triangles[TriIndex];
+			for (int32 Y = RangeMin[TriIndex].Y; Y <= RangeMax[TriIndex].Y; Y++)
+			{
+				for (int32 X = RangeMin[TriIndex].X; X <= RangeMax[TriIndex].X; X++)
+				{
+					const int32 Index = Z * SliceSize + Y * Dims.X + X;
+					const float Dist = (float)PointTriangleDistance(Grid.GetSamplePosition(X, Y, Z), Tri);
+					if (Dist < Distances[Index])
+					{
+						Distances[Index] = Dist;
+						ClosestTriangle[Index] = TriIndex;
+					}
+				}
+			}
+		}
+	}, ParallelFlags);
+
+	SliceBuckets.Empty();
+
+	// 2. 快速扫描：按轴分离，每一行正反两遍传播最近三角形
+	auto TryPropagate = [&](int32 Target, int32 Source, int32 X, int32 Y, int32 Z)
+	{
+		const int32 Candidate = ClosestTriangle[Source];
+		if (Candidate == INDEX_NONE || Candidate == ClosestTriangle[Target])
+		{
+			return;
+		}
+
+		const float Dist = (float)PointTriangleDistance(Grid.GetSamplePosition(X, Y, Z), Triangles[Candidate]);
+		if (Dist < Distances[Target])
+		{
+			Distances[Target] = Dist;
+			ClosestTriangle[Target] = Candidate;
+		}
+	};
+
+	const int32 Strides[3] = { 1, Dims.X, SliceSize };
+
+	for (int32 Pass = 0; Pass < FMath::Max(Config.NumSweepPasses, 1); Pass++)
+	{
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			const int32 AxisU = (Axis + 1) % 3;
+			const int32 AxisV = (Axis + 2) % 3;
+			const int32 Length = Dims[Axis];
+			const int32 Stride = Strides[Axis];
+
+			if (Length < 2)
+			{
+				continue;
+			}
+
+			ParallelFor(Dims[AxisU] * Dims[AxisV], [&](int32 Row)
+			{
+				FIntVector Coord;
+				Coord[Axis] = 0;
+				Coord[AxisU] = Row % Dims[AxisU];
+				Coord[AxisV] = Row / Dims[AxisU];
+				const int32 RowStart = Coord.Z * SliceSize + Coord.Y * Dims.X + Coord.X;
+
+				// 正向
+				for (int32 i = 1; i < Length; i++)
+				{
+					Coord[Axis] = i;
+					TryPropagate(RowStart + i * Stride, RowStart + (i - 1) * Stride, Coord.X, Coord.Y, Coord.Z);
+				}
+				// 反向
+				for (int32 i = Length - 2; i >= 0; i--)
+				{
+					Coord[Axis] = i;
+					TryPropagate(RowStart + i * Stride, RowStart + (i + 1) * Stride, Coord.X, Coord.Y, Coord.Z);
+				}
+			}, ParallelFlags);
+		}
+	}
+
+	// 保险：三轴传播后理论上每个采样点都有最近三角形
+	ParallelFor(NumSamples, [&](int32 Index)
+	{
+		if (ClosestTriangle[Index] == INDEX_NONE)
+		{
+			Distances[Index] = Config.FarValue;
+		}
+	}, ParallelFlags);
+
+	// 3. 符号
+	ApplySigns(Mesh, Grid, Config, Distances);
+
+	OutDistances = MoveTemp(Distances);
+	return true;
+}
+
+void FSDFGridGenerator::ApplySigns(const FDynamicMesh3& Mesh, const FSDFGridDesc& Grid, const FConfig& Config, TArray<float>& InOutDistances)
+{
+	TArray<bool> Inside;
+	int32 NumFallbackRows = 0;
+	ComputeInsideMask(Mesh, Grid, Config, Inside, nullptr, &NumFallbackRows);
+
+	ParallelFor(InOutDistances.Num(), [&](int32 Index)
+	{
+		if (Inside[Index])
+		{
+			InOutDistances[Index] = -InOutDistances[Index];
+		}
+	}, SDFGridGeneratorPrivate::GetParallelFlags(Config));
+
+	if (NumFallbackRows > 0)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("SDFGridGenerator: %d / %d rows fell back to fast winding"),
+			NumFallbackRows, Grid.Dimensions.Y * Grid.Dimensions.Z);
+	}
+}
+
+void FSDFGridGenerator::ComputeInsideMask(const FDynamicMesh3& Mesh, const FSDFGridDesc& Grid, const FConfig& Config,
+	TArray<bool>& OutInside, const TFastWindingTree<FDynamicMesh3>* ExistingWinding, int32* OutNumFallbackRows)
+{
+	const FIntVector Dims = Grid.Dimensions;
+	const int32 SliceSize = Dims.X * Dims.Y;
+	const EParallelForFlags ParallelFlags = SDFGridGeneratorPrivate::GetParallelFlags(Config);
+
+	OutInside.Init(false, Grid.IsValid() ? Grid.GetNumSamples() : 0);
+	if (OutNumFallbackRows)
+	{
+		*OutNumFallbackRows = 0;
+	}
+	if (!Grid.IsValid() || Mesh.TriangleCount() == 0)
+	{
+		return;
+	}
+
+	// 每一行 (Y, Z) 是否需要逐点 Fast Winding
+	TArray<bool> RowNeedsWinding;
+	RowNeedsWinding.Init(!Config.bUseScanlineParity, Dims.Y * Dims.Z);
+
+	if (Config.bUseScanlineParity)
+	{
+		// 三角形缓存：顶点 + 是否含开放边界边 (射线穿过这种三角形时奇偶不可信)
+		struct FSignTriangle
+		{
+			FVector3d V[3];
+			bool bOpen = false;
+		};
+
+		TArray<FSignTriangle> Triangles;
+		Triangles.Reserve(Mesh.TriangleCount());
+		for (int32 TriangleID : Mesh.TriangleIndicesItr())
+		{
+			FSignTriangle& Tri = Triangles.AddDefaulted_GetRef();
+			Mesh.GetTriVertices(TriangleID, Tri.V[0], Tri.V[1], Tri.V[2]);
+
+			const FIndex3i Edges = Mesh.GetTriEdges(TriangleID);
+			Tri.bOpen = Mesh.IsBoundaryEdge(Edges.A) || Mesh.IsBoundaryEdge(Edges.B) || Mesh.IsBoundaryEdge(Edges.C);
+		}
+
+		// 每个三角形在 YZ 平面上覆盖的行范围 (FIntPoint 的 X/Y 分别对应网格的 Y/Z，多扩一行，恰好落在边上的情况交给下面的边函数判断)
+		TArray<FIntPoint> RowMin, RowMax;
+		RowMin.SetNumUninitialized(Triangles.Num());
+		RowMax.SetNumUninitialized(Triangles.Num());
+
+		TArray<TArray<int32>> SliceBuckets;
+		SliceBuckets.SetNum(Dims.Z);
+
+		for (int32 TriIndex = 0; TriIndex < Triangles.Num(); TriIndex++)
+		{
+			const FSignTriangle& Tri = Triangles[TriIndex];
+			int32 Min[2], Max[2];
+			for (int32 Axis = 1; Axis < 3; Axis++)
+			{
+				const double Lo = FMath::Min3(Tri.V[0][Axis], Tri.V[1][Axis], Tri.V[2][Axis]);
+				const double Hi = FMath::Max3(Tri.V[0][Axis], Tri.V[1][Axis], Tri.V[2][Axis]);
+				Min[Axis - 1] = FMath::Max(FMath::CeilToInt((Lo - Grid.Origin[Axis]) / Grid.Spacing[Axis]) - 1, 0);
+				Max[Axis - 1] = FMath::Min(FMath::FloorToInt((Hi - Grid.Origin[Axis]) / Grid.Spacing[Axis]) + 1, Dims[Axis] - 1);
+			}
+			RowMin[TriIndex] = FIntPoint(Min[0], Min[1]);
+			RowMax[TriIndex] = FIntPoint(Max[0], Max[1]);
+
+			for (int32 Z = Min[1]; Z <= Max[1]; Z++)
+			{
+				SliceBuckets[Z].Add(TriIndex);
+			}
+		}
+
+		ParallelFor(Dims.Z, [&](int32 Z)
+		{
+			TArray<TArray<int32>> RowTriangles;
+			RowTriangles.SetNum(Dims.Y);
+			for (int32 TriIndex : SliceBuckets[Z])
+			{
+				for (int32 Y = RowMin[TriIndex].X; Y <= RowMax[TriIndex].X; Y++)
+				{
+					RowTriangles[Y].Add(TriIndex);
+				}
+			}
+
+			const double PZ = Grid.Origin.Z + Z * Grid.Spacing.Z;
+			TArray<double, TInlineAllocator<32>> Crossings;
+
+			for (int32 Y = 0; Y < Dims.Y; Y++)
+			{
+				const double PY = Grid.Origin.Y + Y * Grid.Spacing.Y;
+				bool bAmbiguous = false;
+				Crossings.Reset();
+
+				for (int32 TriIndex : RowTriangles[Y])
+				{
+					const FSignTriangle& Tri = Triangles[TriIndex];
+					const FVector3d& A = Tri.V[0];
+					const FVector3d& B = Tri.V[1];
+					const FVector3d& C = Tri.V[2];
+
+					// YZ 平面上的边函数 (E0 对应边 AB，E1 对应 BC，E2 对应 CA)，三者之和为投影面积的两倍
+					const double E0 = (B.Y - A.Y) * (PZ - A.Z) - (B.Z - A.Z) * (PY - A.Y);
+					const double E1 = (C.Y - B.Y) * (PZ - B.Z) - (C.Z - B.Z) * (PY - B.Y);
+					const double E2 = (A.Y - C.Y) * (PZ - C.Z) - (A.Z - C.Z) * (PY - C.Y);
+					const double Area2 = E0 + E1 + E2;
+
+					// 投影退化 (三角形平行于 X 轴)：射线与其相切，不计入交点
+					if (FMath::Abs(Area2) < UE_DOUBLE_SMALL_NUMBER)
+					{
+						continue;
+					}
+
+					const double Tolerance = FMath::Abs(Area2) * 1e-9;
+					const bool bAnyPositive = E0 > Tolerance || E1 > Tolerance || E2 > Tolerance;
+					const bool bAnyNegative = E0 < -Tolerance || E1 < -Tolerance || E2 < -Tolerance;
+					if (bAnyPositive && bAnyNegative)
+					{
+						// 不相交
+						continue;
+					}
+
+					const bool bAllPositive = E0 > Tolerance && E1 > Tolerance && E2 > Tolerance;
+					const bool bAllNegative = E0 < -Tolerance && E1 < -Tolerance && E2 < -Tolerance;
+					if (!bAllPositive && !bAllNegative)
+					{
+						// 恰好擦过边或顶点
+						bAmbiguous = true;
+						break;
+					}
+
+					if (Tri.bOpen)
+					{
+						bAmbiguous = true;
+						break;
+					}
+
+					// 重心坐标插值出交点的 X
+					Crossings.Add((E1 * A.X + E2 * B.X + E0 * C.X) / Area2);
+				}
+
+				if (bAmbiguous || (Crossings.Num() & 1) != 0)
+				{
+					RowNeedsWinding[Z * Dims.Y + Y] = true;
+					continue;
+				}
+
+				if (Crossings.Num() == 0)
+				{
+					continue;
+				}
+
+				Crossings.Sort();
+
+				// 沿 X 扫过采样点，穿过奇数个交点即在内部
+				int32 NumPassed = 0;
+				bool* RowInside = OutInside.GetData() + Z * SliceSize + Y * Dims.X;
+				for (int32 X = 0; X < Dims.X; X++)
+				{
+					const double PX = Grid.Origin.X + X * Grid.Spacing.X;
+					while (NumPassed < Crossings.Num() && Crossings[NumPassed] < PX)
+					{
+						NumPassed++;
+					}
+					RowInside[X] = (NumPassed & 1) != 0;
+				}
+			}
+		}, ParallelFlags);
+	}
+
+	// 回退：对有问题的行逐点 Fast Winding
+	TArray<int32> FallbackRows;
+	for (int32 Row = 0; Row < RowNeedsWinding.Num(); Row++)
+	{
+		if (RowNeedsWinding[Row])
+		{
+			FallbackRows.Add(Row);
+		}
+	}
+
+	if (OutNumFallbackRows)
+	{
+		*OutNumFallbackRows = FallbackRows.Num();
+	}
+
+	if (FallbackRows.Num() == 0)
+	{
+		return;
+	}
+
+	TUniquePtr<FDynamicMeshAABBTree3> LocalSpatial;
+	TUniquePtr<TFastWindingTree<FDynamicMesh3>> LocalWinding;
+	const TFastWindingTree<FDynamicMesh3>* Winding = ExistingWinding;
+	if (!Winding)
+	{
+		LocalSpatial = MakeUnique<FDynamicMeshAABBTree3>(&Mesh);
+		LocalWinding = MakeUnique<TFastWindingTree<FDynamicMesh3>>(LocalSpatial.Get());
+		Winding = LocalWinding.Get();
+	}
+
+	ParallelFor(FallbackRows.Num(), [&](int32 FallbackIndex)
+	{
+		const int32 Row = FallbackRows[FallbackIndex];
+		const int32 Y = Row % Dims.Y;
+		const int32 Z = Row / Dims.Y;
+		bool* RowInside = OutInside.GetData() + Z * SliceSize + Y * Dims.X;
+		for (int32 X = 0; X < Dims.X; X++)
+		{
+			RowInside[X] = Winding->IsInside(Grid.GetSamplePosition(X, Y, Z));
+		}
+	}, ParallelFlags);
+}
+
+bool FSDFGridGenerator::GenerateExact(const FDynamicMesh3& Mesh, const FSDFGridDesc& Grid, float FarValue, TArray<float>& OutDistances)
+{
+	OutDistances.Reset();
+	if (!Grid.IsValid() || Mesh.TriangleCount() == 0)
+	{
+		return false;
+	}
+
+	const FIntVector Dims = Grid.Dimensions;
+	OutDistances.SetNumUninitialized(Grid.GetNumSamples());
+
+	FDynamicMeshAABBTree3 Spatial(&Mesh);
+	TFastWindingTree<FDynamicMesh3> Winding(&Spatial);
+
+	ParallelFor(Dims.Z, [&](int32 Z)
+	{
+		for (int32 Y = 0; Y < Dims.Y; Y++)
+		{
+			for (int32 X = 0; X < Dims.X; X++)
+			{
+				const FVector3d SamplePos = Grid.GetSamplePosition(X, Y, Z);
+
+				double NearestDistSqr;
+				const int32 NearestTriID = Spatial.FindNearestTriangle(SamplePos, NearestDistSqr);
+
+				float SignedDist = FarValue;
+				if (NearestTriID != IndexConstants::InvalidID)
+				{
+					const double NearestDist = FMath::Sqrt(NearestDistSqr);
+					SignedDist = (float)(Winding.IsInside(SamplePos) ? -NearestDist : NearestDist);
+				}
+				OutDistances[Z * Dims.X * Dims.Y + Y * Dims.X + X] = SignedDist;
+			}
+		}
+	});
+
+	return true;
+}
+
+bool FSDFGridGenerator::CompareWithExact(const FDynamicMesh3& Mesh, const FSDFGridDesc& Grid, const FConfig& Config, FCompareResult& OutResult)
+{
+	OutResult = FCompareResult();
+
+	TArray<float> Fast;
+	TArray<float> Exact;
+
+	double StartTime = FPlatformTime::Seconds();
+	if (!Generate(Mesh, Grid, Config, Fast))
+	{
+		return false;
+	}
+	OutResult.FastSeconds = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	if (!GenerateExact(Mesh, Grid, Config.FarValue, Exact))
+	{
+		return false;
+	}
+	OutResult.ExactSeconds = FPlatformTime::Seconds() - StartTime;
+
+	const FIntVector Dims = Grid.Dimensions;
+	double ErrorSum = 0.0;
+	for (int32 Index = 0; Index < Fast.Num(); Index++)
+	{
+		const double Error = FMath::Abs((double)Fast[Index] - (double)Exact[Index]);
+		ErrorSum += Error;
+		if (Error > OutResult.MaxAbsError)
+		{
+			OutResult.MaxAbsError = Error;
+			OutResult.MaxErrorSample = FIntVector(Index % Dims.X, (Index / Dims.X) % Dims.Y, Index / (Dims.X * Dims.Y));
+		}
+		if ((Fast[Index] < 0.0f) != (Exact[Index] < 0.0f))
+		{
+			OutResult.SignMismatches++;
+		}
+	}
+	OutResult.MeanAbsError = ErrorSum / FMath::Max(Fast.Num(), 1);
+
+	return true;
+}
@@ -0,0 +1,284 @@
+// SDFMarchingCubesTables.h
+// Lookup table for the grid-aligned marching cubes extractor in FSDFMeshExporter.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Cell layout:
+ *   Corner c sits at (c & 1, (c >> 1) & 1, (c >> 2) & 1), bit c of the case index is set when
+ *   the corner value is below the iso value (inside).
+ *   Edges 0-3 run along X, 4-7 along Y, 8-11 along Z:
+ *     0:(0,1) 1:(2,3) 2:(4,5)  3:(6,7)
+ *     4:(0,2) 5:(1,3) 6:(4,6)  7:(5,7)
+ *     8:(0,4) 9:(1,5) 10:(2,6) 11:(3,7)
+ *
+ * Ambiguous faces always keep inside corners separated, so neighbouring cells agree on
+ * every shared face and the result is watertight. Triangles are wound like FMarchingCubes
+ * output ((B - A) x (C - A) points towards decreasing SDF), so existing winding handling
+ * (OBJ bReverseWinding etc.) applies unchanged.
+ */
+namespace SDFMarchingCubesTables
+{
+	// Up to 5 triangles per case, edge indices terminated by -1
+	static constexpr int8 TriTable[256][16] =
+	{
+		{ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 5, 9, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 5, 8, 5, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 10, 1, 8, 1, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 1, 5, 9, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 10, 1, 8, 1, 5, 8, 5, 9, -1, -1, -1, -1, -1, -1, -1 },
+		{ 11, 5, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 0, 11, 5, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 11, 9, 0, 11, 0, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 1, 8, 1, 11, 8, 11, 9, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 11, 4, 11, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 10, 11, 8, 11, 5, 8, 5, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 11, 4, 11, 9, 4, 9, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 10, 11, 8, 11, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 8, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 4, 0, 6, 0, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 8, 2, 5, 9, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 4, 5, 6, 5, 9, 6, 9, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 1, 6, 8, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 10, 1, 6, 1, 0, 6, 0, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 1, 6, 8, 2, 5, 9, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 10, 1, 6, 1, 5, 6, 5, 9, 6, 9, 2, -1, -1, -1, -1 },
+		{ 6, 8, 2, 11, 5, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 4, 0, 6, 0, 2, 11, 5, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 8, 2, 11, 9, 0, 11, 0, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 4, 1, 6, 1, 11, 6, 11, 9, 6, 9, 2, -1, -1, -1, -1 },
+		{ 4, 10, 11, 4, 11, 5, 6, 8, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 10, 11, 6, 11, 5, 6, 5, 0, 6, 0, 2, -1, -1, -1, -1 },
+		{ 4, 10, 11, 4, 11, 9, 4, 9, 0, 6, 8, 2, -1, -1, -1, -1 },
+		{ 6, 10, 11, 6, 11, 9, 6, 9, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 9, 7, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 0, 9, 7, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 5, 7, 2, 5, 2, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 5, 8, 5, 7, 8, 7, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 1, 9, 7, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 10, 1, 8, 1, 0, 9, 7, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 1, 5, 7, 2, 5, 2, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 10, 1, 8, 1, 5, 8, 5, 7, 8, 7, 2, -1, -1, -1, -1 },
+		{ 11, 5, 1, 9, 7, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 0, 11, 5, 1, 9, 7, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 11, 7, 2, 11, 2, 0, 11, 0, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 1, 8, 1, 11, 8, 11, 7, 8, 7, 2, -1, -1, -1, -1 },
+		{ 4, 10, 11, 4, 11, 5, 9, 7, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 10, 11, 8, 11, 5, 8, 5, 0, 9, 7, 2, -1, -1, -1, -1 },
+		{ 4, 10, 11, 4, 11, 7, 4, 7, 2, 4, 2, 0, -1, -1, -1, -1 },
+		{ 8, 10, 11, 8, 11, 7, 8, 7, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 8, 9, 6, 9, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 4, 0, 6, 0, 9, 6, 9, 7, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 8, 0, 6, 0, 5, 6, 5, 7, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 4, 5, 6, 5, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 1, 6, 8, 9, 6, 9, 7, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 10, 1, 6, 1, 0, 6, 0, 9, 6, 9, 7, -1, -1, -1, -1 },
+		{ 4, 10, 1, 6, 8, 0, 6, 0, 5, 6, 5, 7, -1, -1, -1, -1 },
+		{ 6, 10, 1, 6, 1, 5, 6, 5, 7, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 8, 9, 6, 9, 7, 11, 5, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 4, 0, 6, 0, 9, 6, 9, 7, 11, 5, 1, -1, -1, -1, -1 },
+		{ 6, 8, 0, 6, 0, 1, 6, 1, 11, 6, 11, 7, -1, -1, -1, -1 },
+		{ 6, 4, 1, 6, 1, 11, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 11, 4, 11, 5, 6, 8, 9, 6, 9, 7, -1, -1, -1, -1 },
+		{ 6, 10, 11, 6, 11, 5, 6, 5, 0, 6, 0, 9, 6, 9, 7, -1 },
+		{ 4, 10, 11, 4, 11, 7, 4, 7, 6, 4, 6, 8, 4, 8, 0, -1 },
+		{ 6, 10, 11, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 3, 8, 4, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 3, 5, 9, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 3, 8, 4, 5, 8, 5, 9, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 6, 3, 4, 3, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 6, 3, 8, 3, 1, 8, 1, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 6, 3, 4, 3, 1, 5, 9, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 6, 3, 8, 3, 1, 8, 1, 5, 8, 5, 9, -1, -1, -1, -1 },
+		{ 10, 6, 3, 11, 5, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 3, 8, 4, 0, 11, 5, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 3, 11, 9, 0, 11, 0, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 3, 8, 4, 1, 8, 1, 11, 8, 11, 9, -1, -1, -1, -1 },
+		{ 4, 6, 3, 4, 3, 11, 4, 11, 5, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 6, 3, 8, 3, 11, 8, 11, 5, 8, 5, 0, -1, -1, -1, -1 },
+		{ 4, 6, 3, 4, 3, 11, 4, 11, 9, 4, 9, 0, -1, -1, -1, -1 },
+		{ 8, 6, 3, 8, 3, 11, 8, 11, 9, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 8, 2, 10, 2, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 4, 0, 10, 0, 2, 10, 2, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 8, 2, 10, 2, 3, 5, 9, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 4, 5, 10, 5, 9, 10, 9, 2, 10, 2, 3, -1, -1, -1, -1 },
+		{ 4, 8, 2, 4, 2, 3, 4, 3, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 0, 2, 3, 0, 3, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 8, 2, 4, 2, 3, 4, 3, 1, 5, 9, 0, -1, -1, -1, -1 },
+		{ 5, 9, 2, 5, 2, 3, 5, 3, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 8, 2, 10, 2, 3, 11, 5, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 4, 0, 10, 0, 2, 10, 2, 3, 11, 5, 1, -1, -1, -1, -1 },
+		{ 10, 8, 2, 10, 2, 3, 11, 9, 0, 11, 0, 1, -1, -1, -1, -1 },
+		{ 10, 4, 1, 10, 1, 11, 10, 11, 9, 10, 9, 2, 10, 2, 3, -1 },
+		{ 4, 8, 2, 4, 2, 3, 4, 3, 11, 4, 11, 5, -1, -1, -1, -1 },
+		{ 11, 5, 0, 11, 0, 2, 11, 2, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 8, 2, 4, 2, 3, 4, 3, 11, 4, 11, 9, 4, 9, 0, -1 },
+		{ 11, 9, 2, 11, 2, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 3, 9, 7, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 3, 8, 4, 0, 9, 7, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 3, 5, 7, 2, 5, 2, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 3, 8, 4, 5, 8, 5, 7, 8, 7, 2, -1, -1, -1, -1 },
+		{ 4, 6, 3, 4, 3, 1, 9, 7, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 6, 3, 8, 3, 1, 8, 1, 0, 9, 7, 2, -1, -1, -1, -1 },
+		{ 4, 6, 3, 4, 3, 1, 5, 7, 2, 5, 2, 0, -1, -1, -1, -1 },
+		{ 8, 6, 3, 8, 3, 1, 8, 1, 5, 8, 5, 7, 8, 7, 2, -1 },
+		{ 10, 6, 3, 11, 5, 1, 9, 7, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 3, 8, 4, 0, 11, 5, 1, 9, 7, 2, -1, -1, -1, -1 },
+		{ 10, 6, 3, 11, 7, 2, 11, 2, 0, 11, 0, 1, -1, -1, -1, -1 },
+		{ 10, 6, 3, 8, 4, 1, 8, 1, 11, 8, 11, 7, 8, 7, 2, -1 },
+		{ 4, 6, 3, 4, 3, 11, 4, 11, 5, 9, 7, 2, -1, -1, -1, -1 },
+		{ 8, 6, 3, 8, 3, 11, 8, 11, 5, 8, 5, 0, 9, 7, 2, -1 },
+		{ 4, 6, 3, 4, 3, 11, 4, 11, 7, 4, 7, 2, 4, 2, 0, -1 },
+		{ 8, 6, 3, 8, 3, 11, 8, 11, 7, 8, 7, 2, -1, -1, -1, -1 },
+		{ 10, 8, 9, 10, 9, 7, 10, 7, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 4, 0, 10, 0, 9, 10, 9, 7, 10, 7, 3, -1, -1, -1, -1 },
+		{ 10, 8, 0, 10, 0, 5, 10, 5, 7, 10, 7, 3, -1, -1, -1, -1 },
+		{ 10, 4, 5, 10, 5, 7, 10, 7, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 8, 9, 4, 9, 7, 4, 7, 3, 4, 3, 1, -1, -1, -1, -1 },
+		{ 9, 7, 3, 9, 3, 1, 9, 1, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 8, 0, 4, 0, 5, 4, 5, 7, 4, 7, 3, 4, 3, 1, -1 },
+		{ 5, 7, 3, 5, 3, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 8, 9, 10, 9, 7, 10, 7, 3, 11, 5, 1, -1, -1, -1, -1 },
+		{ 10, 4, 0, 10, 0, 9, 10, 9, 7, 10, 7, 3, 11, 5, 1, -1 },
+		{ 10, 8, 0, 10, 0, 1, 10, 1, 11, 10, 11, 7, 10, 7, 3, -1 },
+		{ 10, 4, 1, 10, 1, 11, 10, 11, 7, 10, 7, 3, -1, -1, -1, -1 },
+		{ 4, 8, 9, 4, 9, 7, 4, 7, 3, 4, 3, 11, 4, 11, 5, -1 },
+		{ 11, 5, 0, 11, 0, 9, 11, 9, 7, 11, 7, 3, -1, -1, -1, -1 },
+		{ 4, 8, 0, 11, 7, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 11, 7, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 7, 11, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 0, 7, 11, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 7, 11, 3, 5, 9, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 5, 8, 5, 9, 7, 11, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 1, 7, 11, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 10, 1, 8, 1, 0, 7, 11, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 1, 7, 11, 3, 5, 9, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 10, 1, 8, 1, 5, 8, 5, 9, 7, 11, 3, -1, -1, -1, -1 },
+		{ 7, 5, 1, 7, 1, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 0, 7, 5, 1, 7, 1, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 7, 9, 0, 7, 0, 1, 7, 1, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 1, 8, 1, 3, 8, 3, 7, 8, 7, 9, -1, -1, -1, -1 },
+		{ 4, 10, 3, 4, 3, 7, 4, 7, 5, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 10, 3, 8, 3, 7, 8, 7, 5, 8, 5, 0, -1, -1, -1, -1 },
+		{ 4, 10, 3, 4, 3, 7, 4, 7, 9, 4, 9, 0, -1, -1, -1, -1 },
+		{ 8, 10, 3, 8, 3, 7, 8, 7, 9, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 8, 2, 7, 11, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 4, 0, 6, 0, 2, 7, 11, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 8, 2, 7, 11, 3, 5, 9, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 4, 5, 6, 5, 9, 6, 9, 2, 7, 11, 3, -1, -1, -1, -1 },
+		{ 4, 10, 1, 6, 8, 2, 7, 11, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 10, 1, 6, 1, 0, 6, 0, 2, 7, 11, 3, -1, -1, -1, -1 },
+		{ 4, 10, 1, 6, 8, 2, 7, 11, 3, 5, 9, 0, -1, -1, -1, -1 },
+		{ 6, 10, 1, 6, 1, 5, 6, 5, 9, 6, 9, 2, 7, 11, 3, -1 },
+		{ 6, 8, 2, 7, 5, 1, 7, 1, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 4, 0, 6, 0, 2, 7, 5, 1, 7, 1, 3, -1, -1, -1, -1 },
+		{ 6, 8, 2, 7, 9, 0, 7, 0, 1, 7, 1, 3, -1, -1, -1, -1 },
+		{ 6, 4, 1, 6, 1, 3, 6, 3, 7, 6, 7, 9, 6, 9, 2, -1 },
+		{ 4, 10, 3, 4, 3, 7, 4, 7, 5, 6, 8, 2, -1, -1, -1, -1 },
+		{ 6, 10, 3, 6, 3, 7, 6, 7, 5, 6, 5, 0, 6, 0, 2, -1 },
+		{ 4, 10, 3, 4, 3, 7, 4, 7, 9, 4, 9, 0, 6, 8, 2, -1 },
+		{ 6, 10, 3, 6, 3, 7, 6, 7, 9, 6, 9, 2, -1, -1, -1, -1 },
+		{ 9, 11, 3, 9, 3, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 0, 9, 11, 3, 9, 3, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 5, 11, 3, 5, 3, 2, 5, 2, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 5, 8, 5, 11, 8, 11, 3, 8, 3, 2, -1, -1, -1, -1 },
+		{ 4, 10, 1, 9, 11, 3, 9, 3, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 10, 1, 8, 1, 0, 9, 11, 3, 9, 3, 2, -1, -1, -1, -1 },
+		{ 4, 10, 1, 5, 11, 3, 5, 3, 2, 5, 2, 0, -1, -1, -1, -1 },
+		{ 8, 10, 1, 8, 1, 5, 8, 5, 11, 8, 11, 3, 8, 3, 2, -1 },
+		{ 9, 5, 1, 9, 1, 3, 9, 3, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 0, 9, 5, 1, 9, 1, 3, 9, 3, 2, -1, -1, -1, -1 },
+		{ 2, 0, 1, 2, 1, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 4, 1, 8, 1, 3, 8, 3, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 3, 4, 3, 2, 4, 2, 9, 4, 9, 5, -1, -1, -1, -1 },
+		{ 8, 10, 3, 8, 3, 2, 8, 2, 9, 8, 9, 5, 8, 5, 0, -1 },
+		{ 4, 10, 3, 4, 3, 2, 4, 2, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 10, 3, 8, 3, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 8, 9, 6, 9, 11, 6, 11, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 4, 0, 6, 0, 9, 6, 9, 11, 6, 11, 3, -1, -1, -1, -1 },
+		{ 6, 8, 0, 6, 0, 5, 6, 5, 11, 6, 11, 3, -1, -1, -1, -1 },
+		{ 6, 4, 5, 6, 5, 11, 6, 11, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 1, 6, 8, 9, 6, 9, 11, 6, 11, 3, -1, -1, -1, -1 },
+		{ 6, 10, 1, 6, 1, 0, 6, 0, 9, 6, 9, 11, 6, 11, 3, -1 },
+		{ 4, 10, 1, 6, 8, 0, 6, 0, 5, 6, 5, 11, 6, 11, 3, -1 },
+		{ 6, 10, 1, 6, 1, 5, 6, 5, 11, 6, 11, 3, -1, -1, -1, -1 },
+		{ 6, 8, 9, 6, 9, 5, 6, 5, 1, 6, 1, 3, -1, -1, -1, -1 },
+		{ 6, 4, 0, 6, 0, 9, 6, 9, 5, 6, 5, 1, 6, 1, 3, -1 },
+		{ 6, 8, 0, 6, 0, 1, 6, 1, 3, -1, -1, -1, -1, -1, -1, -1 },
+		{ 6, 4, 1, 6, 1, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 3, 4, 3, 6, 4, 6, 8, 4, 8, 9, 4, 9, 5, -1 },
+		{ 6, 10, 3, 9, 5, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 10, 3, 4, 3, 6, 4, 6, 8, 4, 8, 0, -1, -1, -1, -1 },
+		{ 6, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 7, 10, 7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 7, 10, 7, 11, 8, 4, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 7, 10, 7, 11, 5, 9, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 7, 10, 7, 11, 8, 4, 5, 8, 5, 9, -1, -1, -1, -1 },
+		{ 4, 6, 7, 4, 7, 11, 4, 11, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 6, 7, 8, 7, 11, 8, 11, 1, 8, 1, 0, -1, -1, -1, -1 },
+		{ 4, 6, 7, 4, 7, 11, 4, 11, 1, 5, 9, 0, -1, -1, -1, -1 },
+		{ 8, 6, 7, 8, 7, 11, 8, 11, 1, 8, 1, 5, 8, 5, 9, -1 },
+		{ 10, 6, 7, 10, 7, 5, 10, 5, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 7, 10, 7, 5, 10, 5, 1, 8, 4, 0, -1, -1, -1, -1 },
+		{ 10, 6, 7, 10, 7, 9, 10, 9, 0, 10, 0, 1, -1, -1, -1, -1 },
+		{ 10, 6, 7, 10, 7, 9, 10, 9, 8, 10, 8, 4, 10, 4, 1, -1 },
+		{ 4, 6, 7, 4, 7, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 6, 7, 8, 7, 5, 8, 5, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 6, 7, 4, 7, 9, 4, 9, 0, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 6, 7, 8, 7, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 8, 2, 10, 2, 7, 10, 7, 11, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 4, 0, 10, 0, 2, 10, 2, 7, 10, 7, 11, -1, -1, -1, -1 },
+		{ 10, 8, 2, 10, 2, 7, 10, 7, 11, 5, 9, 0, -1, -1, -1, -1 },
+		{ 10, 4, 5, 10, 5, 9, 10, 9, 2, 10, 2, 7, 10, 7, 11, -1 },
+		{ 4, 8, 2, 4, 2, 7, 4, 7, 11, 4, 11, 1, -1, -1, -1, -1 },
+		{ 7, 11, 1, 7, 1, 0, 7, 0, 2, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 8, 2, 4, 2, 7, 4, 7, 11, 4, 11, 1, 5, 9, 0, -1 },
+		{ 7, 11, 1, 7, 1, 5, 7, 5, 9, 7, 9, 2, -1, -1, -1, -1 },
+		{ 10, 8, 2, 10, 2, 7, 10, 7, 5, 10, 5, 1, -1, -1, -1, -1 },
+		{ 10, 4, 0, 10, 0, 2, 10, 2, 7, 10, 7, 5, 10, 5, 1, -1 },
+		{ 10, 8, 2, 10, 2, 7, 10, 7, 9, 10, 9, 0, 10, 0, 1, -1 },
+		{ 10, 4, 1, 7, 9, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 8, 2, 4, 2, 7, 4, 7, 5, -1, -1, -1, -1, -1, -1, -1 },
+		{ 7, 5, 0, 7, 0, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 8, 2, 4, 2, 7, 4, 7, 9, 4, 9, 0, -1, -1, -1, -1 },
+		{ 7, 9, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 2, 10, 2, 9, 10, 9, 11, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 2, 10, 2, 9, 10, 9, 11, 8, 4, 0, -1, -1, -1, -1 },
+		{ 10, 6, 2, 10, 2, 0, 10, 0, 5, 10, 5, 11, -1, -1, -1, -1 },
+		{ 10, 6, 2, 10, 2, 8, 10, 8, 4, 10, 4, 5, 10, 5, 11, -1 },
+		{ 4, 6, 2, 4, 2, 9, 4, 9, 11, 4, 11, 1, -1, -1, -1, -1 },
+		{ 8, 6, 2, 8, 2, 9, 8, 9, 11, 8, 11, 1, 8, 1, 0, -1 },
+		{ 4, 6, 2, 4, 2, 0, 4, 0, 5, 4, 5, 11, 4, 11, 1, -1 },
+		{ 8, 6, 2, 5, 11, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 2, 10, 2, 9, 10, 9, 5, 10, 5, 1, -1, -1, -1, -1 },
+		{ 10, 6, 2, 10, 2, 9, 10, 9, 5, 10, 5, 1, 8, 4, 0, -1 },
+		{ 10, 6, 2, 10, 2, 0, 10, 0, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 6, 2, 10, 2, 8, 10, 8, 4, 10, 4, 1, -1, -1, -1, -1 },
+		{ 4, 6, 2, 4, 2, 9, 4, 9, 5, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 6, 2, 8, 2, 9, 8, 9, 5, 8, 5, 0, -1, -1, -1, -1 },
+		{ 4, 6, 2, 4, 2, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 8, 6, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 8, 9, 10, 9, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 4, 0, 10, 0, 9, 10, 9, 11, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 8, 0, 10, 0, 5, 10, 5, 11, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 4, 5, 10, 5, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 8, 9, 4, 9, 11, 4, 11, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 9, 11, 1, 9, 1, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 8, 0, 4, 0, 5, 4, 5, 11, 4, 11, 1, -1, -1, -1, -1 },
+		{ 5, 11, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 8, 9, 10, 9, 5, 10, 5, 1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 4, 0, 10, 0, 9, 10, 9, 5, 10, 5, 1, -1, -1, -1, -1 },
+		{ 10, 8, 0, 10, 0, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 10, 4, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 8, 9, 4, 9, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 9, 5, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ 4, 8, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+		{ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	};
+}
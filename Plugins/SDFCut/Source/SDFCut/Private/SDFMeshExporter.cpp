@@ -1,15 +1,226 @@
 // SDFMeshExporter.cpp
 
 #include "SDFMeshExporter.h"
+#include "SDFMeshWriter.h"
+#include "SDFMarchingCubesTables.h"
 #include "Generators/MarchingCubes.h"
 #include "DynamicMesh/DynamicMesh3.h"
-#include "DynamicMesh/MeshNormals.h"
 #include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
 #include "Async/ParallelFor.h"
 
 
 using namespace UE::Geometry;
 
+namespace SDFMeshExporterPrivate
+{
+	// Cell layers per parallel slab of the direct grid extractor
+	constexpr int32 DirectGridSlabDepth = 8;
+
+	// Output of one Z slab. Vertices of the first and last grid plane are generated in the
+	// same scan order by both neighbouring slabs, so they can be welded by position in the list.
+	struct FDirectGridSlab
+	{
+		TArray<FVector3d> Positions;
+		TArray<FVector3f> Normals;
+		TArray<int32> MaterialIDs;
+		TArray<FIndex3i> Triangles;     // Slab-local vertex indices
+
+		int32 BottomPlaneCount = 0;     // Vertices [0, BottomPlaneCount) lie on plane Z0
+		int32 TopPlaneStart = 0;        // Vertices [TopPlaneStart, Num) lie on plane Z1
+	};
+
+	// Extract cells [Z0, Z1) of the grid into Slab
+	static void ExtractDirectGridSlab(
+		const TArray<FFloat16Color>& SDFData,
+		const FIntVector& Dimensions,
+		float VoxelSize,
+		const FVector3d& Origin,
+		float IsoValue,
+		bool bWantMaterials,
+		int32 Z0,
+		int32 Z1,
+		FDirectGridSlab& Slab)
+	{
+		const int32 SizeX = Dimensions.X;
+		const int32 SizeY = Dimensions.Y;
+		const int32 SizeZ = Dimensions.Z;
+		const int32 PlaneSize = SizeX * SizeY;
+
+		// 1. Convert the slab (plus one plane on each side for gradients) to float once
+		const int32 LayerMin = FMath::Max(Z0 - 1, 0);
+		const int32 LayerMax = FMath::Min(Z1 + 1, SizeZ - 1);
+
+		TArray<float> Values;
+		Values.SetNumUninitialized((LayerMax - LayerMin + 1) * PlaneSize);
+		for (int32 Z = LayerMin; Z <= LayerMax; ++Z)
+		{
+			const FFloat16Color* Src = SDFData.GetData() + (int64)Z * PlaneSize;
+			float* Dst = Values.GetData() + (int64)(Z - LayerMin) * PlaneSize;
+			for (int32 i = 0; i < PlaneSize; ++i)
+			{
+				Dst[i] = Src[i].R.GetFloat();
+			}
+		}
+
+		auto Value = [&](int32 X, int32 Y, int32 Z) -> float
+		{
+			return Values[(Z - LayerMin) * PlaneSize + Y * SizeX + X];
+		};
+
+		// Central differences (one-sided at the volume border)
+		auto Gradient = [&](int32 X, int32 Y, int32 Z) -> FVector3f
+		{
+			const int32 X0 = FMath::Max(X - 1, 0), X1 = FMath::Min(X + 1, SizeX - 1);
+			const int32 Y0 = FMath::Max(Y - 1, 0), Y1 = FMath::Min(Y + 1, SizeY - 1);
+			const int32 Z0L = FMath::Max(Z - 1, 0), Z1L = FMath::Min(Z + 1, SizeZ - 1);
+			return FVector3f(
+				(Value(X1, Y, Z) - Value(X0, Y, Z)) / (float)(X1 - X0),
+				(Value(X, Y1, Z) - Value(X, Y0, Z)) / (float)(Y1 - Y0),
+				(Value(X, Y, Z1L) - Value(X, Y, Z0L)) / (float)(Z1L - Z0L));
+		};
+
+		// Add the crossing vertex on the edge A -> B (B = A + one step along Axis)
+		auto AddVertex = [&](int32 X, int32 Y, int32 Z, int32 Axis, float ValueA, float ValueB) -> int32
+		{
+			const int32 BX = X + (Axis == 0), BY = Y + (Axis == 1), BZ = Z + (Axis == 2);
+			const float T = FMath::Clamp((IsoValue - ValueA) / (ValueB - ValueA), 0.0f, 1.0f);
+
+			FVector3d VoxelCoord((double)X, (double)Y, (double)Z);
+			VoxelCoord[Axis] += T;
+			Slab.Positions.Add(Origin + VoxelCoord * VoxelSize);
+
+			// Normal follows the triangle winding (towards decreasing SDF), like QuickComputeVertexNormals on FMarchingCubes output
+			const FVector3f Grad = FMath::Lerp(Gradient(X, Y, Z), Gradient(BX, BY, BZ), T);
+			Slab.Normals.Add((-Grad).GetSafeNormal(UE_SMALL_NUMBER, FVector3f::UpVector));
+
+			if (bWantMaterials)
+			{
+				// Nearest voxel
+				const int64 Index = (T < 0.5f)
+					? (int64)Z * PlaneSize + Y * SizeX + X
+					: (int64)BZ * PlaneSize + BY * SizeX + BX;
+				Slab.MaterialIDs.Add(FMath::RoundToInt(SDFData[Index].G.GetFloat()));
+			}
+
+			return Slab.Positions.Num() - 1;
+		};
+
+		// 2. Edge -> vertex lookups: X/Y edges for the two current planes, Z edges between them.
+		//    Only crossing edges are written, and only crossing edges are read back by the table.
+		TArray<int32> XEdges[2], YEdges[2], ZEdges;
+		for (int32 Slot = 0; Slot < 2; ++Slot)
+		{
+			XEdges[Slot].SetNumUninitialized(PlaneSize);
+			YEdges[Slot].SetNumUninitialized(PlaneSize);
+		}
+		ZEdges.SetNumUninitialized(PlaneSize);
+
+		auto BuildPlaneVertices = [&](int32 Z, int32 Slot)
+		{
+			for (int32 Y = 0; Y < SizeY; ++Y)
+			{
+				for (int32 X = 0; X < SizeX; ++X)
+				{
+					const float ValueA = Value(X, Y, Z);
+					const bool bInsideA = ValueA < IsoValue;
+
+					if (X + 1 < SizeX)
+					{
+						const float ValueB = Value(X + 1, Y, Z);
+						if (bInsideA != (ValueB < IsoValue))
+						{
+							XEdges[Slot][Y * SizeX + X] = AddVertex(X, Y, Z, 0, ValueA, ValueB);
+						}
+					}
+					if (Y + 1 < SizeY)
+					{
+						const float ValueB = Value(X, Y + 1, Z);
+						if (bInsideA != (ValueB < IsoValue))
+						{
+							YEdges[Slot][Y * SizeX + X] = AddVertex(X, Y, Z, 1, ValueA, ValueB);
+						}
+					}
+				}
+			}
+		};
+
+		auto BuildZEdgeVertices = [&](int32 Z)
+		{
+			for (int32 Y = 0; Y < SizeY; ++Y)
+			{
+				for (int32 X = 0; X < SizeX; ++X)
+				{
+					const float ValueA = Value(X, Y, Z);
+					const float ValueB = Value(X, Y, Z + 1);
+					if ((ValueA < IsoValue) != (ValueB < IsoValue))
+					{
+						ZEdges[Y * SizeX + X] = AddVertex(X, Y, Z, 2, ValueA, ValueB);
+					}
+				}
+			}
+		};
+
+		// 3. Sweep the slab: plane Z0 first, then per layer Z edges, next plane, cells
+		BuildPlaneVertices(Z0, 0);
+		Slab.BottomPlaneCount = Slab.Positions.Num();
+
+		for (int32 Z = Z0; Z < Z1; ++Z)
+		{
+			const int32 Cur = (Z - Z0) & 1;
+			const int32 Next = Cur ^ 1;
+
+			BuildZEdgeVertices(Z);
+			if (Z + 1 == Z1)
+			{
+				Slab.TopPlaneStart = Slab.Positions.Num();
+			}
+			BuildPlaneVertices(Z + 1, Next);
+
+			for (int32 Y = 0; Y + 1 < SizeY; ++Y)
+			{
+				for (int32 X = 0; X + 1 < SizeX; ++X)
+				{
+					int32 CaseIndex = 0;
+					for (int32 Corner = 0; Corner < 8; ++Corner)
+					{
+						if (Value(X + (Corner & 1), Y + ((Corner >> 1) & 1), Z + ((Corner >> 2) & 1)) < IsoValue)
+						{
+							CaseIndex |= 1 << Corner;
+						}
+					}
+
+					const int8* Tris = SDFMarchingCubesTables::TriTable[CaseIndex];
+					if (Tris[0] < 0)
+					{
+						continue;
+					}
+
+					const int32 I00 = Y * SizeX + X;
+					const int32 I10 = I00 + 1;
+					const int32 I01 = I00 + SizeX;
+					const int32 I11 = I01 + 1;
+
+					// Same edge numbering as SDFMarchingCubesTables
+					const int32 EdgeVertex[12] =
+					{
+						XEdges[Cur][I00], XEdges[Cur][I01], XEdges[Next][I00], XEdges[Next][I01],
+						YEdges[Cur][I00], YEdges[Cur][I10], YEdges[Next][I00], YEdges[Next][I10],
+						ZEdges[I00], ZEdges[I10], ZEdges[I01], ZEdges[I11]
+					};
+
+					for (int32 i = 0; Tris[i] >= 0; i += 3)
+					{
+						Slab.Triangles.Add(FIndex3i(EdgeVertex[Tris[i]], EdgeVertex[Tris[i + 1]], EdgeVertex[Tris[i + 2]]));
+					}
+				}
+			}
+		}
+	}
+}
+
 bool FSDFMeshExporter::ExtractMeshFromSDF(
 	const TArray<FFloat16Color>& SDFData,
 	const FIntVector& Dimensions,
@@ -19,11 +230,56 @@ bool FSDFMeshExporter::ExtractMeshFromSDF(
 	FDynamicMesh3& OutMesh,
 	TArray<int32>* OutMaterialIDs)
 {
+	OutMesh.Clear();
+
+	TArray<FVector> Positions;
+	TArray<int32> Triangles;
+	TArray<FVector> Normals;
+	if (!ExtractCompactMeshFromSDF(SDFData, Dimensions, VoxelSize, LocalBounds, Config,
+		Positions, Triangles, &Normals, OutMaterialIDs))
+	{
+		return false;
+	}
+
+	CompactBuffersToDynamicMesh(Positions, Triangles, &Normals, OutMesh);
+	return OutMesh.TriangleCount() > 0;
+}
+
+bool FSDFMeshExporter::ExtractCompactMeshFromSDF(
+	const TArray<FFloat16Color>& SDFData,
+	const FIntVector& Dimensions,
+	float VoxelSize,
+	const FBox& LocalBounds,
+	const FMarchingCubesConfig& Config,
+	TArray<FVector>& OutPositions,
+	TArray<int32>& OutTriangles,
+	TArray<FVector>* OutNormals,
+	TArray<int32>* OutMaterialIDs)
+{
+	OutPositions.Reset();
+	OutTriangles.Reset();
+	if (OutNormals)
+	{
+		OutNormals->Reset();
+	}
+	if (OutMaterialIDs)
+	{
+		OutMaterialIDs->Reset();
+	}
+
 	if (SDFData.Num() == 0 || Dimensions.X <= 0 || Dimensions.Y <= 0 || Dimensions.Z <= 0)
 	{
 		return false;
 	}
 
+	// Grid-aligned cells: read voxels directly
+	const float RequestedCubeSize = Config.CubeSize > 0 ? Config.CubeSize : VoxelSize;
+	if (Config.bAllowDirectGrid && FMath::IsNearlyEqual(RequestedCubeSize, VoxelSize, VoxelSize * 1.0e-3f))
+	{
+		return ExtractDirectGridCompact(SDFData, Dimensions, VoxelSize, LocalBounds, Config,
+			OutPositions, OutTriangles, OutNormals, OutMaterialIDs);
+	}
+
 	// Configure marching cubes
 	FMarchingCubes MarchingCubes;
 
@@ -62,49 +318,56 @@ bool FSDFMeshExporter::ExtractMeshFromSDF(
 		return static_cast<double>(SampleSDFValue(*SDFDataPtr, *DimensionsPtr, VoxelCoord));
 	};
 
+	if (Config.CancelF)
+	{
+		MarchingCubes.CancelF = Config.CancelF;
+	}
+
 	// Generate the mesh
 	MarchingCubes.Generate();
 
-	// Copy to output mesh
-	OutMesh.Clear();
-	OutMesh.EnableVertexNormals(FVector3f::UpVector);
-
-	// Add vertices
-	for (int32 i = 0; i < MarchingCubes.Vertices.Num(); ++i)
+	if (Config.CancelF && Config.CancelF())
 	{
-		OutMesh.AppendVertex(MarchingCubes.Vertices[i]);
+		return false;
 	}
 
-	// Add triangles
-	for (int32 i = 0; i < MarchingCubes.Triangles.Num(); ++i)
+	// FMarchingCubes output is already compact: take the vertex array, copy the index triples
+	OutPositions = MoveTemp(MarchingCubes.Vertices);
+	static_assert(sizeof(FIndex3i) == 3 * sizeof(int32), "FIndex3i must be three packed int32");
+	OutTriangles.SetNumUninitialized(MarchingCubes.Triangles.Num() * 3);
+	FMemory::Memcpy(OutTriangles.GetData(), MarchingCubes.Triangles.GetData(), OutTriangles.Num() * sizeof(int32));
+
+	// Area-weighted vertex normals (same as QuickComputeVertexNormals)
+	if (OutNormals)
 	{
-		OutMesh.AppendTriangle(
-			MarchingCubes.Triangles[i].A,
-			MarchingCubes.Triangles[i].B,
-			MarchingCubes.Triangles[i].C
-		);
+		OutNormals->SetNumZeroed(OutPositions.Num());
+		for (int32 i = 0; i < OutTriangles.Num(); i += 3)
+		{
+			const int32 A = OutTriangles[i], B = OutTriangles[i + 1], C = OutTriangles[i + 2];
+			// Same orientation as VectorUtil::NormalArea ((C-A) x (B-A)); the cross product length is
+			// twice the area, so this is already area weighted
+			const FVector FaceNormal = FVector::CrossProduct(OutPositions[C] - OutPositions[A], OutPositions[B] - OutPositions[A]);
+			(*OutNormals)[A] += FaceNormal;
+			(*OutNormals)[B] += FaceNormal;
+			(*OutNormals)[C] += FaceNormal;
+		}
+		ParallelFor(OutNormals->Num(), [OutNormals](int32 VertexID)
+		{
+			(*OutNormals)[VertexID] = (*OutNormals)[VertexID].GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+		});
 	}
 
-	// Compute normals
-	FMeshNormals::QuickComputeVertexNormals(OutMesh);
-
 	// Extract material IDs for each vertex if requested
 	if (OutMaterialIDs)
 	{
-		OutMaterialIDs->SetNum(OutMesh.MaxVertexID());
+		OutMaterialIDs->SetNum(OutPositions.Num());
 
-		ParallelFor(OutMesh.MaxVertexID(), [&](int32 VertexID)
+		ParallelFor(OutPositions.Num(), [&](int32 VertexID)
 		{
-			if (!OutMesh.IsVertex(VertexID))
-			{
-				(*OutMaterialIDs)[VertexID] = 0;
-				return;
-			}
-
-			FVector3d VertexPos = OutMesh.GetVertex(VertexID);
+			const FVector& VertexPos = OutPositions[VertexID];
 
 			// Convert back to voxel space
-			FVector RelativePos = FVector(VertexPos.X, VertexPos.Y, VertexPos.Z) - LocalBounds.Min;
+			FVector RelativePos = VertexPos - LocalBounds.Min;
 			FVector VoxelCoord = RelativePos / VoxelSize;
 
 			// Sample material ID (nearest neighbor)
@@ -128,6 +391,651 @@ bool FSDFMeshExporter::ExtractMeshFromSDF(
 		});
 	}
 
+	return OutTriangles.Num() > 0;
+}
+
+void FSDFMeshExporter::CompactBuffersToDynamicMesh(
+	const TArray<FVector>& Positions,
+	const TArray<int32>& Triangles,
+	const TArray<FVector>* Normals,
+	FDynamicMesh3& OutMesh)
+{
+	OutMesh.Clear();
+
+	const bool bHasNormals = Normals && Normals->Num() == Positions.Num();
+	if (bHasNormals)
+	{
+		OutMesh.EnableVertexNormals(FVector3f::UpVector);
+	}
+
+	// Fresh mesh: vertex IDs are assigned 0..N-1 in order, so buffer indices can be used as-is
+	for (int32 i = 0; i < Positions.Num(); ++i)
+	{
+		FVertexInfo VertexInfo(Positions[i]);
+		if (bHasNormals)
+		{
+			VertexInfo.bHaveN = true;
+			VertexInfo.Normal = FVector3f((*Normals)[i]);
+		}
+		OutMesh.AppendVertex(VertexInfo);
+	}
+
+	for (int32 i = 0; i + 2 < Triangles.Num(); i += 3)
+	{
+		OutMesh.AppendTriangle(Triangles[i], Triangles[i + 1], Triangles[i + 2]);
+	}
+}
+
+void FSDFMeshExporter::DynamicMeshToCompactBuffers(
+	const FDynamicMesh3& Mesh,
+	TArray<FVector>& OutPositions,
+	TArray<int32>& OutTriangles,
+	TArray<FVector>* OutNormals,
+	const TArray<int32>* VertexMaterialIDs,
+	TArray<int32>* OutMaterialIDs)
+{
+	TArray<int32> Remap;
+	const bool bIdentity = Mesh.IsCompactV();
+	if (!bIdentity)
+	{
+		BuildCompactVertexRemap(Mesh, Remap);
+	}
+
+	OutPositions.Reset(Mesh.VertexCount());
+	if (OutNormals)
+	{
+		OutNormals->Reset(Mesh.VertexCount());
+	}
+	if (OutMaterialIDs)
+	{
+		OutMaterialIDs->Reset(Mesh.VertexCount());
+	}
+
+	for (int32 VertexID : Mesh.VertexIndicesItr())
+	{
+		OutPositions.Add(Mesh.GetVertex(VertexID));
+		if (OutNormals)
+		{
+			OutNormals->Add(Mesh.HasVertexNormals() ? FVector(Mesh.GetVertexNormal(VertexID)) : FVector::UpVector);
+		}
+		if (OutMaterialIDs)
+		{
+			OutMaterialIDs->Add(VertexMaterialIDs && VertexMaterialIDs->IsValidIndex(VertexID) ? (*VertexMaterialIDs)[VertexID] : 0);
+		}
+	}
+
+	OutTriangles.Reset(Mesh.TriangleCount() * 3);
+	for (int32 TriID : Mesh.TriangleIndicesItr())
+	{
+		const FIndex3i Tri = Mesh.GetTriangle(TriID);
+		OutTriangles.Add(bIdentity ? Tri.A : Remap[Tri.A]);
+		OutTriangles.Add(bIdentity ? Tri.B : Remap[Tri.B]);
+		OutTriangles.Add(bIdentity ? Tri.C : Remap[Tri.C]);
+	}
+}
+
+void FSDFMeshExporter::BuildCompactVertexRemap(const FDynamicMesh3& Mesh, TArray<int32>& OutRemap)
+{
+	// Dense vertex ID -> compact index (FDynamicMesh3 may have gaps)
+	OutRemap.Init(INDEX_NONE, Mesh.MaxVertexID());
+	int32 CompactIndex = 0;
+	for (int32 VertexID : Mesh.VertexIndicesItr())
+	{
+		OutRemap[VertexID] = CompactIndex++;
+	}
+}
+
+bool FSDFMeshExporter::ExtractDirectGridCompact(
+	const TArray<FFloat16Color>& SDFData,
+	const FIntVector& Dimensions,
+	float VoxelSize,
+	const FBox& LocalBounds,
+	const FMarchingCubesConfig& Config,
+	TArray<FVector>& OutPositions,
+	TArray<int32>& OutTriangles,
+	TArray<FVector>* OutNormals,
+	TArray<int32>* OutMaterialIDs)
+{
+	using namespace SDFMeshExporterPrivate;
+
+	if (Dimensions.X < 2 || Dimensions.Y < 2 || Dimensions.Z < 2 ||
+		SDFData.Num() < Dimensions.X * Dimensions.Y * Dimensions.Z)
+	{
+		return false;
+	}
+
+	const EParallelForFlags ParallelFlags = Config.bParallelCompute ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+
+	// Voxel i is sampled at LocalBounds.Min + i * VoxelSize (same mapping as SampleSDFValue)
+	const FVector3d Origin(LocalBounds.Min);
+	const int32 NumCellLayers = Dimensions.Z - 1;
+	const int32 NumSlabs = FMath::DivideAndRoundUp(NumCellLayers, DirectGridSlabDepth);
+
+	TArray<FDirectGridSlab> Slabs;
+	Slabs.SetNum(NumSlabs);
+
+	ParallelFor(NumSlabs, [&](int32 SlabIndex)
+	{
+		if (Config.CancelF && Config.CancelF())
+		{
+			return;
+		}
+
+		const int32 Z0 = SlabIndex * DirectGridSlabDepth;
+		const int32 Z1 = FMath::Min(Z0 + DirectGridSlabDepth, NumCellLayers);
+		ExtractDirectGridSlab(SDFData, Dimensions, VoxelSize, Origin, Config.IsoValue, OutMaterialIDs != nullptr,
+			Z0, Z1, Slabs[SlabIndex]);
+	}, ParallelFlags);
+
+	if (Config.CancelF && Config.CancelF())
+	{
+		return false;
+	}
+
+	// Weld slabs: the first plane of slab k is the last plane of slab k-1
+	TArray<int32> VertexOffsets;
+	TArray<int32> TriangleOffsets;
+	VertexOffsets.SetNumUninitialized(NumSlabs);
+	TriangleOffsets.SetNumUninitialized(NumSlabs);
+	int32 NumVertices = 0;
+	int32 NumTriangles = 0;
+	for (int32 SlabIndex = 0; SlabIndex < NumSlabs; ++SlabIndex)
+	{
+		const FDirectGridSlab& Slab = Slabs[SlabIndex];
+		const int32 NumShared = SlabIndex > 0 ? Slab.BottomPlaneCount : 0;
+		if (SlabIndex > 0 && !ensure(Slab.BottomPlaneCount == Slabs[SlabIndex - 1].Positions.Num() - Slabs[SlabIndex - 1].TopPlaneStart))
+		{
+			return false;
+		}
+
+		VertexOffsets[SlabIndex] = NumVertices - NumShared;
+		NumVertices += Slab.Positions.Num() - NumShared;
+
+		TriangleOffsets[SlabIndex] = NumTriangles;
+		NumTriangles += Slab.Triangles.Num();
+	}
+
+	auto ToMeshVertex = [&](int32 SlabIndex, int32 LocalIndex) -> int32
+	{
+		if (SlabIndex > 0 && LocalIndex < Slabs[SlabIndex].BottomPlaneCount)
+		{
+			// Vertex owned by the previous slab's top plane (never its bottom plane, so no recursion)
+			return VertexOffsets[SlabIndex - 1] + Slabs[SlabIndex - 1].TopPlaneStart + LocalIndex;
+		}
+		return VertexOffsets[SlabIndex] + LocalIndex;
+	};
+
+	// Each slab writes its own range of the caller's buffers
+	OutPositions.SetNumUninitialized(NumVertices);
+	OutTriangles.SetNumUninitialized(NumTriangles * 3);
+	if (OutNormals)
+	{
+		OutNormals->SetNumUninitialized(NumVertices);
+	}
+	if (OutMaterialIDs)
+	{
+		OutMaterialIDs->SetNumUninitialized(NumVertices);
+	}
+
+	ParallelFor(NumSlabs, [&](int32 SlabIndex)
+	{
+		const FDirectGridSlab& Slab = Slabs[SlabIndex];
+		const int32 FirstOwned = SlabIndex > 0 ? Slab.BottomPlaneCount : 0;
+		for (int32 i = FirstOwned; i < Slab.Positions.Num(); ++i)
+		{
+			const int32 VertexIndex = VertexOffsets[SlabIndex] + i;
+			OutPositions[VertexIndex] = Slab.Positions[i];
+			if (OutNormals)
+			{
+				(*OutNormals)[VertexIndex] = FVector(Slab.Normals[i]);
+			}
+			if (OutMaterialIDs)
+			{
+				(*OutMaterialIDs)[VertexIndex] = Slab.MaterialIDs[i];
+			}
+		}
+
+		int32* Dest = OutTriangles.GetData() + TriangleOffsets[SlabIndex] * 3;
+		for (const FIndex3i& Tri : Slab.Triangles)
+		{
+			*Dest++ = ToMeshVertex(SlabIndex, Tri.A);
+			*Dest++ = ToMeshVertex(SlabIndex, Tri.B);
+			*Dest++ = ToMeshVertex(SlabIndex, Tri.C);
+		}
+	}, ParallelFlags);
+
+	return NumTriangles > 0;
+}
+
+bool FSDFMeshExporter::ExtractMeshDualContouring(
+	const TArray<FFloat16Color>& SDFData,
+	const FIntVector& Dimensions,
+	float VoxelSize,
+	const FBox& LocalBounds,
+	const FDualContouringConfig& Config,
+	FDynamicMesh3& OutMesh,
+	TArray<int32>* OutMaterialIDs)
+{
+	const int64 NumVoxels = (int64)Dimensions.X * Dimensions.Y * Dimensions.Z;
+	if (NumVoxels <= 0 || SDFData.Num() < NumVoxels)
+	{
+		OutMesh.Clear();
+		return false;
+	}
+
+	// Split channels once: distance as float, material ID as byte
+	TArray<float> Values;
+	TArray<uint8> Materials;
+	Values.SetNumUninitialized((int32)NumVoxels);
+	Materials.SetNumUninitialized((int32)NumVoxels);
+
+	const int32 PlaneSize = Dimensions.X * Dimensions.Y;
+	ParallelFor(Dimensions.Z, [&](int32 Z)
+	{
+		const int64 Base = (int64)Z * PlaneSize;
+		for (int32 i = 0; i < PlaneSize; ++i)
+		{
+			const FFloat16Color& Voxel = SDFData[Base + i];
+			Values[Base + i] = Voxel.R.GetFloat();
+			Materials[Base + i] = (uint8)FMath::Clamp(FMath::RoundToInt(Voxel.G.GetFloat()), 0, 255);
+		}
+	}, Config.bParallelCompute ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	// Voxel i is sampled at LocalBounds.Min + i * VoxelSize (same mapping as SampleSDFValue)
+	return DualContourGrid(Values, Materials, Dimensions, VoxelSize, FVector3d(LocalBounds.Min), Config, OutMesh, OutMaterialIDs);
+}
+
+bool FSDFMeshExporter::DualContourGrid(
+	TArrayView<const float> Values,
+	TArrayView<const uint8> Materials,
+	const FIntVector& Dimensions,
+	double SampleSpacing,
+	const FVector3d& Origin,
+	const FDualContouringConfig& Config,
+	FDynamicMesh3& OutMesh,
+	TArray<int32>* OutMaterialIDs)
+{
+	OutMesh.Clear();
+
+	const int32 SizeX = Dimensions.X;
+	const int32 SizeY = Dimensions.Y;
+	const int32 SizeZ = Dimensions.Z;
+	const int64 PlaneSize = (int64)SizeX * SizeY;
+	const bool bHasMaterials = Materials.Num() > 0;
+
+	if (SizeX < 2 || SizeY < 2 || SizeZ < 2 || Values.Num() < PlaneSize * SizeZ ||
+		(bHasMaterials && Materials.Num() < PlaneSize * SizeZ))
+	{
+		return false;
+	}
+
+	const float IsoValue = Config.IsoValue;
+	const int32 Stride = FMath::Clamp(Config.Stride, 1, FMath::Min3(SizeX, SizeY, SizeZ) - 1);
+	const EParallelForFlags ParallelFlags = Config.bParallelCompute ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+
+	// Coarse lattice: points at multiples of Stride, cells between them
+	const FIntVector NumPoints((SizeX - 1) / Stride + 1, (SizeY - 1) / Stride + 1, (SizeZ - 1) / Stride + 1);
+	const FIntVector NumCells = NumPoints - FIntVector(1, 1, 1);
+
+	auto SampleIndex = [&](int32 X, int32 Y, int32 Z) -> int64
+	{
+		return (int64)Z * PlaneSize + (int64)Y * SizeX + X;
+	};
+	auto Value = [&](const FIntVector& P) -> float
+	{
+		return Values[SampleIndex(P.X, P.Y, P.Z)];
+	};
+	auto CellIndex = [&](int32 X, int32 Y, int32 Z) -> int64
+	{
+		return ((int64)Z * NumCells.Y + Y) * NumCells.X + X;
+	};
+
+	// Central differences on the full-resolution grid (one-sided at the border)
+	auto Gradient = [&](const FIntVector& P) -> FVector3d
+	{
+		FVector3d Grad;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			FIntVector Lo = P, Hi = P;
+			Lo[Axis] = FMath::Max(P[Axis] - 1, 0);
+			Hi[Axis] = FMath::Min(P[Axis] + 1, Dimensions[Axis] - 1);
+			Grad[Axis] = (Value(Hi) - Value(Lo)) / (double)(Hi[Axis] - Lo[Axis]);
+		}
+		return Grad;
+	};
+
+	// Hermite data of a coarse edge: the first sign change among its full-resolution samples
+	struct FEdgeCrossing
+	{
+		FVector3d Position;   // Grid coordinates
+		FVector3d Normal;     // Normalized gradient
+		int32 MaterialID = 0; // Material of the inside sample
+	};
+
+	auto FindCrossing = [&](const FIntVector& Start, int32 Axis, FEdgeCrossing& Out) -> bool
+	{
+		FIntVector A = Start;
+		float ValueA = Value(A);
+		for (int32 Step = 0; Step < Stride; ++Step)
+		{
+			FIntVector B = A;
+			B[Axis] += 1;
+			const float ValueB = Value(B);
+			if ((ValueA < IsoValue) != (ValueB < IsoValue))
+			{
+				const double T = FMath::Clamp((double)(IsoValue - ValueA) / (double)(ValueB - ValueA), 0.0, 1.0);
+				Out.Position = FVector3d(A.X, A.Y, A.Z);
+				Out.Position[Axis] += T;
+				Out.Normal = FMath::Lerp(Gradient(A), Gradient(B), T).GetSafeNormal();
+				if (bHasMaterials)
+				{
+					const FIntVector& Inside = (ValueA < IsoValue) ? A : B;
+					Out.MaterialID = Materials[SampleIndex(Inside.X, Inside.Y, Inside.Z)];
+				}
+				return true;
+			}
+			A = B;
+			ValueA = ValueB;
+		}
+		return false;
+	};
+
+	// Cell edges as (corner offset, axis), corners in units of Stride
+	static const FIntVector EdgeStart[12] =
+	{
+		{0,0,0}, {0,1,0}, {0,0,1}, {0,1,1},
+		{0,0,0}, {1,0,0}, {0,0,1}, {1,0,1},
+		{0,0,0}, {1,0,0}, {0,1,0}, {1,1,0}
+	};
+	static const int32 EdgeAxis[12] = { 0,0,0,0, 1,1,1,1, 2,2,2,2 };
+
+	struct FCellVertex
+	{
+		int64 CellIndex;
+		FVector3d Position;
+		FVector3f Normal;
+		int32 MaterialID;
+	};
+
+	// 1. One vertex per surface cell (parallel over cell layers)
+	TArray<TArray<FCellVertex>> LayerVertices;
+	LayerVertices.SetNum(NumCells.Z);
+
+	ParallelFor(NumCells.Z, [&](int32 CZ)
+	{
+		if (Config.CancelF && Config.CancelF())
+		{
+			return;
+		}
+
+		TArray<FCellVertex>& Vertices = LayerVertices[CZ];
+		for (int32 CY = 0; CY < NumCells.Y; ++CY)
+		{
+			for (int32 CX = 0; CX < NumCells.X; ++CX)
+			{
+				const FIntVector CellMin(CX * Stride, CY * Stride, CZ * Stride);
+
+				// Quick reject: all corners on the same side
+				int32 NumInside = 0;
+				for (int32 Corner = 0; Corner < 8; ++Corner)
+				{
+					const FIntVector P = CellMin + FIntVector(Corner & 1, (Corner >> 1) & 1, (Corner >> 2) & 1) * Stride;
+					NumInside += Value(P) < IsoValue ? 1 : 0;
+				}
+				if (NumInside == 0 || NumInside == 8)
+				{
+					continue;
+				}
+
+				// Gather Hermite data
+				FEdgeCrossing Crossings[12];
+				int32 NumCrossings = 0;
+				for (int32 Edge = 0; Edge < 12; ++Edge)
+				{
+					const FIntVector Start = CellMin + EdgeStart[Edge] * Stride;
+					FIntVector End = Start;
+					End[EdgeAxis[Edge]] += Stride;
+					if ((Value(Start) < IsoValue) != (Value(End) < IsoValue) &&
+						FindCrossing(Start, EdgeAxis[Edge], Crossings[NumCrossings]))
+					{
+						++NumCrossings;
+					}
+				}
+				if (NumCrossings == 0)
+				{
+					continue;
+				}
+
+				// QEF: minimize sum (n_i . (x - p_i))^2 + Bias * |x - c|^2 around the mass point c,
+				// i.e. (N^T N + Bias I) (x - c) = sum n_i (n_i . (p_i - c))
+				FVector3d MassPoint = FVector3d::ZeroVector;
+				FVector3d NormalSum = FVector3d::ZeroVector;
+				for (int32 i = 0; i < NumCrossings; ++i)
+				{
+					MassPoint += Crossings[i].Position;
+					NormalSum += Crossings[i].Normal;
+				}
+				MassPoint /= (double)NumCrossings;
+
+				const double Bias = FMath::Max((double)Config.MassPointBias, 1.0e-4) * NumCrossings;
+				double A00 = Bias, A01 = 0.0, A02 = 0.0, A11 = Bias, A12 = 0.0, A22 = Bias;
+				FVector3d Rhs = FVector3d::ZeroVector;
+				for (int32 i = 0; i < NumCrossings; ++i)
+				{
+					const FVector3d& N = Crossings[i].Normal;
+					A00 += N.X * N.X; A01 += N.X * N.Y; A02 += N.X * N.Z;
+					A11 += N.Y * N.Y; A12 += N.Y * N.Z; A22 += N.Z * N.Z;
+					Rhs += N * N.Dot(Crossings[i].Position - MassPoint);
+				}
+
+				// Symmetric positive definite 3x3, solved by Cramer's rule
+				const double C00 = A11 * A22 - A12 * A12;
+				const double C01 = A02 * A12 - A01 * A22;
+				const double C02 = A01 * A12 - A02 * A11;
+				const double Det = A00 * C00 + A01 * C01 + A02 * C02;
+
+				FVector3d CellPoint = MassPoint;
+				if (FMath::Abs(Det) > UE_DOUBLE_SMALL_NUMBER)
+				{
+					const double C11 = A00 * A22 - A02 * A02;
+					const double C12 = A01 * A02 - A00 * A12;
+					const double C22 = A00 * A11 - A01 * A01;
+					CellPoint += FVector3d(
+						C00 * Rhs.X + C01 * Rhs.Y + C02 * Rhs.Z,
+						C01 * Rhs.X + C11 * Rhs.Y + C12 * Rhs.Z,
+						C02 * Rhs.X + C12 * Rhs.Y + C22 * Rhs.Z) / Det;
+				}
+
+				// Keep the vertex inside its cell so neighbouring quads cannot fold over
+				const FVector3d CellLo(CellMin.X, CellMin.Y, CellMin.Z);
+				const FVector3d CellHi = CellLo + FVector3d((double)Stride);
+				CellPoint = FVector3d(
+					FMath::Clamp(CellPoint.X, CellLo.X, CellHi.X),
+					FMath::Clamp(CellPoint.Y, CellLo.Y, CellHi.Y),
+					FMath::Clamp(CellPoint.Z, CellLo.Z, CellHi.Z));
+
+				// Majority material of the crossings
+				int32 MaterialID = Crossings[0].MaterialID;
+				if (bHasMaterials)
+				{
+					int32 BestCount = 0;
+					for (int32 i = 0; i < NumCrossings; ++i)
+					{
+						int32 Count = 0;
+						for (int32 j = 0; j < NumCrossings; ++j)
+						{
+							Count += Crossings[j].MaterialID == Crossings[i].MaterialID ? 1 : 0;
+						}
+						if (Count > BestCount)
+						{
+							BestCount = Count;
+							MaterialID = Crossings[i].MaterialID;
+						}
+					}
+				}
+
+				FCellVertex& Vertex = Vertices.AddDefaulted_GetRef();
+				Vertex.CellIndex = CellIndex(CX, CY, CZ);
+				Vertex.Position = Origin + CellPoint * SampleSpacing;
+				// Same orientation as the triangle winding (towards decreasing SDF)
+				Vertex.Normal = FVector3f(-NormalSum.GetSafeNormal(UE_DOUBLE_SMALL_NUMBER, FVector3d::UnitZ()));
+				Vertex.MaterialID = MaterialID;
+			}
+		}
+	}, ParallelFlags);
+
+	if (Config.CancelF && Config.CancelF())
+	{
+		return false;
+	}
+
+	// 2. Cell -> mesh vertex. Only surface cells are ever read back, the rest stays uninitialized.
+	TArray<int32> CellToVertex;
+	CellToVertex.SetNumUninitialized(NumCells.X * NumCells.Y * NumCells.Z);
+
+	OutMesh.EnableVertexNormals(FVector3f::UpVector);
+	OutMesh.EnableTriangleGroups();
+	if (OutMaterialIDs)
+	{
+		OutMaterialIDs->Reset();
+	}
+
+	for (const TArray<FCellVertex>& Vertices : LayerVertices)
+	{
+		for (const FCellVertex& Vertex : Vertices)
+		{
+			FVertexInfo VertexInfo(Vertex.Position);
+			VertexInfo.bHaveN = true;
+			VertexInfo.Normal = Vertex.Normal;
+			CellToVertex[Vertex.CellIndex] = OutMesh.AppendVertex(VertexInfo);
+
+			if (OutMaterialIDs)
+			{
+				OutMaterialIDs->Add(Vertex.MaterialID);
+			}
+		}
+	}
+	LayerVertices.Empty();
+
+	// 3. One quad per crossing lattice edge, connecting the 4 cells around it (parallel over point layers)
+	struct FQuad
+	{
+		FIndex4i Vertices;
+		int32 GroupID;
+	};
+	TArray<TArray<FQuad>> LayerQuads;
+	LayerQuads.SetNum(NumPoints.Z);
+
+	ParallelFor(NumPoints.Z, [&](int32 PZ)
+	{
+		TArray<FQuad>& Quads = LayerQuads[PZ];
+		for (int32 PY = 0; PY < NumPoints.Y; ++PY)
+		{
+			for (int32 PX = 0; PX < NumPoints.X; ++PX)
+			{
+				const FIntVector Point(PX, PY, PZ);
+				const FIntVector Start = Point * Stride;
+				const bool bStartInside = Value(Start) < IsoValue;
+
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					// The other two axes in cyclic order, so (U x V) points along +Axis
+					const int32 U = (Axis + 1) % 3;
+					const int32 V = (Axis + 2) % 3;
+
+					// Needs a full ring of 4 cells around the edge
+					if (Point[Axis] >= NumCells[Axis] || Point[U] < 1 || Point[U] >= NumPoints[U] - 1 ||
+						Point[V] < 1 || Point[V] >= NumPoints[V] - 1)
+					{
+						continue;
+					}
+
+					FIntVector End = Start;
+					End[Axis] += Stride;
+					if (bStartInside == (Value(End) < IsoValue))
+					{
+						continue;
+					}
+
+					FIndex4i QuadVertices;
+					static const int32 RingOffsets[4][2] = { {-1, -1}, {0, -1}, {0, 0}, {-1, 0} };
+					for (int32 Corner = 0; Corner < 4; ++Corner)
+					{
+						FIntVector Cell = Point;
+						Cell[U] += RingOffsets[Corner][0];
+						Cell[V] += RingOffsets[Corner][1];
+						QuadVertices[Corner] = CellToVertex[CellIndex(Cell.X, Cell.Y, Cell.Z)];
+					}
+
+					// Ring order faces +Axis; face towards the inside (decreasing SDF) like the MC extractors
+					if (bStartInside)
+					{
+						Swap(QuadVertices.B, QuadVertices.D);
+					}
+
+					int32 GroupID = 0;
+					if (bHasMaterials)
+					{
+						FEdgeCrossing Crossing;
+						if (FindCrossing(Start, Axis, Crossing))
+						{
+							GroupID = Crossing.MaterialID;
+						}
+					}
+
+					Quads.Add({ QuadVertices, GroupID });
+				}
+			}
+		}
+	}, ParallelFlags);
+
+	// 4. Triangulate along the shorter diagonal. A cell shared by more than two surface sheets
+	//    can make an edge non-manifold; such triangles get their own copies of the vertices.
+	auto AppendTriangleSafe = [&](int32 A, int32 B, int32 C, int32 GroupID)
+	{
+		if (OutMesh.AppendTriangle(A, B, C, GroupID) >= 0)
+		{
+			return;
+		}
+
+		int32 Copies[3];
+		const int32 Source[3] = { A, B, C };
+		for (int32 i = 0; i < 3; ++i)
+		{
+			FVertexInfo VertexInfo(OutMesh.GetVertex(Source[i]));
+			VertexInfo.bHaveN = true;
+			VertexInfo.Normal = OutMesh.GetVertexNormal(Source[i]);
+			Copies[i] = OutMesh.AppendVertex(VertexInfo);
+			if (OutMaterialIDs)
+			{
+				// Copy first: Add() may reallocate and invalidate a reference into the same array
+				const int32 MaterialID = (*OutMaterialIDs)[Source[i]];
+				OutMaterialIDs->Add(MaterialID);
+			}
+		}
+		OutMesh.AppendTriangle(Copies[0], Copies[1], Copies[2], GroupID);
+	};
+
+	for (const TArray<FQuad>& Quads : LayerQuads)
+	{
+		for (const FQuad& Quad : Quads)
+		{
+			const FIndex4i& Q = Quad.Vertices;
+			const double Diagonal02 = DistanceSquared(OutMesh.GetVertex(Q.A), OutMesh.GetVertex(Q.C));
+			const double Diagonal13 = DistanceSquared(OutMesh.GetVertex(Q.B), OutMesh.GetVertex(Q.D));
+			if (Diagonal02 <= Diagonal13)
+			{
+				AppendTriangleSafe(Q.A, Q.B, Q.C, Quad.GroupID);
+				AppendTriangleSafe(Q.A, Q.C, Q.D, Quad.GroupID);
+			}
+			else
+			{
+				AppendTriangleSafe(Q.A, Q.B, Q.D, Quad.GroupID);
+				AppendTriangleSafe(Q.B, Q.C, Q.D, Quad.GroupID);
+			}
+		}
+	}
+
 	return OutMesh.TriangleCount() > 0;
 }
 
@@ -199,8 +1107,8 @@ FString FSDFMeshExporter::MeshToOBJString(
 	OBJContent += TEXT("\n");
 
 	// Build vertex index map (FDynamicMesh3 may have gaps)
-	TMap<int32, int32> VertexIDToOBJIndex;
-	int32 OBJVertexIndex = 1; // OBJ indices are 1-based
+	TArray<int32> Remap;
+	BuildCompactVertexRemap(Mesh, Remap);
 
 	// Write vertices (with optional vertex colors)
 	for (int32 VertexID : Mesh.VertexIndicesItr())
@@ -219,9 +1127,6 @@ FString FSDFMeshExporter::MeshToOBJString(
 			OBJContent += FString::Printf(TEXT("v %.6f %.6f %.6f\n"),
 				Pos.X, Pos.Y, Pos.Z);
 		}
-
-		VertexIDToOBJIndex.Add(VertexID, OBJVertexIndex);
-		OBJVertexIndex++;
 	}
 
 	OBJContent += TEXT("\n");
@@ -245,9 +1150,10 @@ FString FSDFMeshExporter::MeshToOBJString(
 	{
 		FIndex3i Tri = Mesh.GetTriangle(TriID);
 
-		int32 A = VertexIDToOBJIndex[Tri.A];
-		int32 B = VertexIDToOBJIndex[Tri.B];
-		int32 C = VertexIDToOBJIndex[Tri.C];
+		// OBJ indices are 1-based
+		int32 A = Remap[Tri.A] + 1;
+		int32 B = Remap[Tri.B] + 1;
+		int32 C = Remap[Tri.C] + 1;
 
 		// Reverse winding for right-handed coordinate system
 		if (Config.bReverseWinding)
@@ -276,8 +1182,326 @@ bool FSDFMeshExporter::WriteMeshToOBJ(
 	const FOBJExportConfig& Config,
 	const TArray<FLinearColor>* VertexColors)
 {
-	FString OBJContent = MeshToOBJString(Mesh, Config, VertexColors);
-	return FFileHelper::SaveStringToFile(OBJContent, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	return WriteMeshToFile(Mesh, FilePath, EMeshFileFormat::OBJ, Config, VertexColors);
+}
+
+bool FSDFMeshExporter::WriteMeshToFile(
+	const FDynamicMesh3& Mesh,
+	const FString& FilePath,
+	EMeshFileFormat Format,
+	const FOBJExportConfig& Config,
+	const TArray<FLinearColor>* VertexColors)
+{
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!FileWriter)
+	{
+		return false;
+	}
+
+	bool bSuccess = WriteMeshToArchive(Mesh, *FileWriter, Format, Config, VertexColors);
+	bSuccess &= FileWriter->Close();
+	return bSuccess;
+}
+
+bool FSDFMeshExporter::WriteMeshToArchive(
+	const FDynamicMesh3& Mesh,
+	FArchive& Ar,
+	EMeshFileFormat Format,
+	const FOBJExportConfig& Config,
+	const TArray<FLinearColor>* VertexColors)
+{
+	// Dense vertex ID -> compact index remap (FDynamicMesh3 may have gaps)
+	TArray<int32> Remap;
+	if (Format != EMeshFileFormat::BinarySTL)
+	{
+		BuildCompactVertexRemap(Mesh, Remap);
+	}
+
+	FSDFStreamWriter Writer(Ar);
+
+	switch (Format)
+	{
+	case EMeshFileFormat::OBJ:
+		WriteOBJStream(Writer, Mesh, Remap, Config, VertexColors);
+		break;
+	case EMeshFileFormat::BinaryPLY:
+		WritePLYStream(Writer, Mesh, Remap, Config, VertexColors);
+		break;
+	case EMeshFileFormat::BinarySTL:
+		WriteSTLStream(Writer, Mesh, Config);
+		break;
+	}
+
+	Writer.Flush();
+	return !Ar.IsError();
+}
+
+void FSDFMeshExporter::WriteOBJStream(
+	FSDFStreamWriter& Writer,
+	const FDynamicMesh3& Mesh,
+	const TArray<int32>& Remap,
+	const FOBJExportConfig& Config,
+	const TArray<FLinearColor>* VertexColors)
+{
+	// Header comment
+	Writer.WriteText("# OBJ exported from SDFCut Plugin\n# Vertices: ");
+	Writer.WriteInt(Mesh.VertexCount());
+	Writer.WriteText(", Triangles: ");
+	Writer.WriteInt(Mesh.TriangleCount());
+	Writer.WriteText("\n\n");
+
+	// Write vertices (with optional vertex colors)
+	for (int32 VertexID : Mesh.VertexIndicesItr())
+	{
+		const FVector3d Pos = Mesh.GetVertex(VertexID);
+
+		Writer.WriteText("v ");
+		Writer.WriteFloat(Pos.X, 6);
+		Writer.WriteChar(' ');
+		Writer.WriteFloat(Pos.Y, 6);
+		Writer.WriteChar(' ');
+		Writer.WriteFloat(Pos.Z, 6);
+
+		if (Config.bIncludeVertexColors && VertexColors && VertexColors->IsValidIndex(VertexID))
+		{
+			const FLinearColor& Color = (*VertexColors)[VertexID];
+			Writer.WriteChar(' ');
+			Writer.WriteFloat(Color.R, 4);
+			Writer.WriteChar(' ');
+			Writer.WriteFloat(Color.G, 4);
+			Writer.WriteChar(' ');
+			Writer.WriteFloat(Color.B, 4);
+		}
+		Writer.WriteChar('\n');
+	}
+
+	Writer.WriteChar('\n');
+
+	// Write vertex normals if requested and available
+	const bool bHasNormals = Config.bIncludeNormals && Mesh.HasVertexNormals();
+	if (bHasNormals)
+	{
+		for (int32 VertexID : Mesh.VertexIndicesItr())
+		{
+			const FVector3f Normal = Mesh.GetVertexNormal(VertexID);
+			Writer.WriteText("vn ");
+			Writer.WriteFloat(Normal.X, 6);
+			Writer.WriteChar(' ');
+			Writer.WriteFloat(Normal.Y, 6);
+			Writer.WriteChar(' ');
+			Writer.WriteFloat(Normal.Z, 6);
+			Writer.WriteChar('\n');
+		}
+		Writer.WriteChar('\n');
+	}
+
+	// Write faces (OBJ indices are 1-based)
+	auto WriteFace = [&](int32 TriID)
+	{
+		const FIndex3i Tri = Mesh.GetTriangle(TriID);
+
+		int32 Indices[3] = { Remap[Tri.A] + 1, Remap[Tri.B] + 1, Remap[Tri.C] + 1 };
+		if (Config.bReverseWinding)
+		{
+			Swap(Indices[1], Indices[2]);
+		}
+
+		Writer.WriteChar('f');
+		for (int32 Corner = 0; Corner < 3; ++Corner)
+		{
+			Writer.WriteChar(' ');
+			Writer.WriteInt(Indices[Corner]);
+			if (bHasNormals)
+			{
+				// f v1//vn1 v2//vn2 v3//vn3
+				Writer.WriteText("//");
+				Writer.WriteInt(Indices[Corner]);
+			}
+		}
+		Writer.WriteChar('\n');
+	};
+
+	if (Config.bWriteTriangleGroups && Mesh.HasTriangleGroups())
+	{
+		// One "g" section per triangle group (material)
+		TArray<int32> GroupIDs;
+		for (int32 TriID : Mesh.TriangleIndicesItr())
+		{
+			GroupIDs.AddUnique(Mesh.GetTriangleGroup(TriID));
+		}
+		GroupIDs.Sort();
+
+		for (int32 GroupID : GroupIDs)
+		{
+			Writer.WriteText("g Material_");
+			Writer.WriteInt(GroupID);
+			Writer.WriteChar('\n');
+
+			for (int32 TriID : Mesh.TriangleIndicesItr())
+			{
+				if (Mesh.GetTriangleGroup(TriID) == GroupID)
+				{
+					WriteFace(TriID);
+				}
+			}
+		}
+	}
+	else
+	{
+		for (int32 TriID : Mesh.TriangleIndicesItr())
+		{
+			WriteFace(TriID);
+		}
+	}
+}
+
+void FSDFMeshExporter::WritePLYStream(
+	FSDFStreamWriter& Writer,
+	const FDynamicMesh3& Mesh,
+	const TArray<int32>& Remap,
+	const FOBJExportConfig& Config,
+	const TArray<FLinearColor>* VertexColors)
+{
+	const bool bHasNormals = Config.bIncludeNormals && Mesh.HasVertexNormals();
+	const bool bHasColors = Config.bIncludeVertexColors && VertexColors != nullptr;
+
+	// ASCII header
+	Writer.WriteText("ply\nformat binary_little_endian 1.0\ncomment exported from SDFCut Plugin\nelement vertex ");
+	Writer.WriteInt(Mesh.VertexCount());
+	Writer.WriteText("\nproperty float x\nproperty float y\nproperty float z\n");
+	if (bHasNormals)
+	{
+		Writer.WriteText("property float nx\nproperty float ny\nproperty float nz\n");
+	}
+	if (bHasColors)
+	{
+		Writer.WriteText("property uchar red\nproperty uchar green\nproperty uchar blue\n");
+	}
+	Writer.WriteText("element face ");
+	Writer.WriteInt(Mesh.TriangleCount());
+	Writer.WriteText("\nproperty list uchar int vertex_indices\nend_header\n");
+
+	// Binary body (the plugin only targets little-endian platforms)
+	for (int32 VertexID : Mesh.VertexIndicesItr())
+	{
+		Writer.WriteValue(FVector3f(Mesh.GetVertex(VertexID)));
+
+		if (bHasNormals)
+		{
+			Writer.WriteValue(Mesh.GetVertexNormal(VertexID));
+		}
+
+		if (bHasColors)
+		{
+			const FLinearColor Color = VertexColors->IsValidIndex(VertexID) ? (*VertexColors)[VertexID] : FLinearColor::White;
+			const uint8 RGB[3] =
+			{
+				(uint8)FMath::Clamp(FMath::RoundToInt(Color.R * 255.0f), 0, 255),
+				(uint8)FMath::Clamp(FMath::RoundToInt(Color.G * 255.0f), 0, 255),
+				(uint8)FMath::Clamp(FMath::RoundToInt(Color.B * 255.0f), 0, 255)
+			};
+			Writer.WriteBytes(RGB, sizeof(RGB));
+		}
+	}
+
+	for (int32 TriID : Mesh.TriangleIndicesItr())
+	{
+		const FIndex3i Tri = Mesh.GetTriangle(TriID);
+
+		int32 Indices[3] = { Remap[Tri.A], Remap[Tri.B], Remap[Tri.C] };
+		if (Config.bReverseWinding)
+		{
+			Swap(Indices[1], Indices[2]);
+		}
+
+		Writer.WriteValue((uint8)3);
+		Writer.WriteBytes(Indices, sizeof(Indices));
+	}
+}
+
+void FSDFMeshExporter::WriteSTLStream(
+	FSDFStreamWriter& Writer,
+	const FDynamicMesh3& Mesh,
+	const FOBJExportConfig& Config)
+{
+	// 80 byte header + triangle count
+	ANSICHAR Header[80] = {};
+	FCStringAnsi::Strncpy(Header, "binary STL exported from SDFCut Plugin", UE_ARRAY_COUNT(Header));
+	Writer.WriteBytes(Header, sizeof(Header));
+	Writer.WriteValue((uint32)Mesh.TriangleCount());
+
+	for (int32 TriID : Mesh.TriangleIndicesItr())
+	{
+		const FIndex3i Tri = Mesh.GetTriangle(TriID);
+
+		FVector3f V0 = FVector3f(Mesh.GetVertex(Tri.A));
+		FVector3f V1 = FVector3f(Mesh.GetVertex(Tri.B));
+		FVector3f V2 = FVector3f(Mesh.GetVertex(Tri.C));
+		if (Config.bReverseWinding)
+		{
+			Swap(V1, V2);
+		}
+
+		// Face normal follows the written winding (counter-clockwise, right-hand rule)
+		const FVector3f Normal = FVector3f::CrossProduct(V1 - V0, V2 - V0).GetSafeNormal();
+
+		Writer.WriteValue(Normal);
+		Writer.WriteValue(V0);
+		Writer.WriteValue(V1);
+		Writer.WriteValue(V2);
+		Writer.WriteValue((uint16)0); // attribute byte count
+	}
+}
+
+void FSDFMeshExporter::RunWriterBenchmark(
+	const FDynamicMesh3& Mesh,
+	const FString& Directory,
+	const TArray<FLinearColor>* VertexColors)
+{
+	FOBJExportConfig Config;
+	Config.bIncludeNormals = true;
+	Config.bIncludeVertexColors = VertexColors != nullptr;
+
+	auto Report = [](const TCHAR* Name, const FString& Path, double Seconds)
+	{
+		const int64 FileSize = IFileManager::Get().FileSize(*Path);
+		const double MB = FileSize > 0 ? FileSize / (1024.0 * 1024.0) : 0.0;
+		UE_LOG(LogTemp, Log, TEXT("WriterBenchmark %-12s: %8.2f MB in %7.3f s  (%8.1f MB/s)"),
+			Name, MB, Seconds, Seconds > 0.0 ? MB / Seconds : 0.0);
+	};
+
+	UE_LOG(LogTemp, Log, TEXT("WriterBenchmark: %d vertices, %d triangles"), Mesh.VertexCount(), Mesh.TriangleCount());
+
+	// 1. Legacy path: whole file as one FString, converted to UTF-8 on save
+	{
+		const FString Path = FPaths::Combine(Directory, TEXT("WriterBenchmark_Legacy.obj"));
+		const double Start = FPlatformTime::Seconds();
+		const FString OBJContent = MeshToOBJString(Mesh, Config, VertexColors);
+		FFileHelper::SaveStringToFile(OBJContent, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+		Report(TEXT("LegacyOBJ"), Path, FPlatformTime::Seconds() - Start);
+	}
+
+	// 2. Streaming writers
+	struct FCase
+	{
+		const TCHAR* Name;
+		const TCHAR* FileName;
+		EMeshFileFormat Format;
+	};
+	const FCase Cases[] =
+	{
+		{ TEXT("StreamOBJ"), TEXT("WriterBenchmark_Stream.obj"), EMeshFileFormat::OBJ },
+		{ TEXT("BinaryPLY"), TEXT("WriterBenchmark.ply"), EMeshFileFormat::BinaryPLY },
+		{ TEXT("BinarySTL"), TEXT("WriterBenchmark.stl"), EMeshFileFormat::BinarySTL },
+	};
+
+	for (const FCase& Case : Cases)
+	{
+		const FString Path = FPaths::Combine(Directory, Case.FileName);
+		const double Start = FPlatformTime::Seconds();
+		WriteMeshToFile(Mesh, Path, Case.Format, Config, VertexColors);
+		Report(Case.Name, Path, FPlatformTime::Seconds() - Start);
+	}
 }
 
 TArray<FLinearColor> FSDFMeshExporter::MaterialIDsToColors(const TArray<int32>& MaterialIDs)
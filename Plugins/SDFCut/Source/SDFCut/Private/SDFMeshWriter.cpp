@@ -0,0 +1,137 @@
+// SDFMeshWriter.cpp
+
+#include "SDFMeshWriter.h"
+
+namespace SDFMeshWriterPrivate
+{
+	static constexpr uint64 PowersOf10[] =
+	{
+		1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull
+	};
+
+	// Writes the decimal digits of Value right-aligned ending at End, returns the first digit
+	FORCEINLINE ANSICHAR* WriteDigitsBackwards(ANSICHAR* End, uint64 Value)
+	{
+		do
+		{
+			*--End = (ANSICHAR)('0' + Value % 10);
+			Value /= 10;
+		}
+		while (Value != 0);
+		return End;
+	}
+}
+
+FSDFStreamWriter::FSDFStreamWriter(FArchive& InArchive)
+	: Archive(InArchive)
+{
+	Buffer.SetNumUninitialized(BufferSize);
+}
+
+FSDFStreamWriter::~FSDFStreamWriter()
+{
+	Flush();
+}
+
+void FSDFStreamWriter::WriteBytes(const void* Data, int32 NumBytes)
+{
+	const uint8* Src = static_cast<const uint8*>(Data);
+	while (NumBytes > 0)
+	{
+		if (Used == BufferSize)
+		{
+			Flush();
+		}
+
+		const int32 Chunk = FMath::Min(NumBytes, BufferSize - Used);
+		FMemory::Memcpy(Buffer.GetData() + Used, Src, Chunk);
+		Used += Chunk;
+		Src += Chunk;
+		NumBytes -= Chunk;
+	}
+}
+
+void FSDFStreamWriter::WriteText(const ANSICHAR* Text)
+{
+	WriteBytes(Text, FCStringAnsi::Strlen(Text));
+}
+
+void FSDFStreamWriter::WriteInt(int64 Value)
+{
+	ANSICHAR Temp[24];
+	ANSICHAR* End = Temp + UE_ARRAY_COUNT(Temp);
+
+	const bool bNegative = Value < 0;
+	const uint64 Magnitude = bNegative ? (uint64)(-(Value + 1)) + 1 : (uint64)Value;
+
+	ANSICHAR* Begin = SDFMeshWriterPrivate::WriteDigitsBackwards(End, Magnitude);
+	if (bNegative)
+	{
+		*--Begin = '-';
+	}
+
+	WriteBytes(Begin, (int32)(End - Begin));
+}
+
+void FSDFStreamWriter::WriteFloat(double Value, int32 Decimals)
+{
+	Decimals = FMath::Clamp(Decimals, 0, 9);
+
+	const uint64 Scale = SDFMeshWriterPrivate::PowersOf10[Decimals];
+
+	if (!FMath::IsFinite(Value) || FMath::Abs(Value) >= 1.0e12 || FMath::Abs(Value) * (double)Scale >= 1.0e18)
+	{
+		// Rare: out of the fixed-point range, let printf handle it
+		ANSICHAR Temp[64];
+		const int32 Len = FCStringAnsi::Snprintf(Temp, UE_ARRAY_COUNT(Temp), "%.*f", Decimals, FMath::IsFinite(Value) ? Value : 0.0);
+		WriteBytes(Temp, FMath::Clamp(Len, 0, (int32)UE_ARRAY_COUNT(Temp) - 1));
+		return;
+	}
+
+	const bool bNegative = Value < 0.0;
+
+	// Round once in fixed point so the integer and fraction parts stay consistent (e.g. 0.9999996 -> 1.000000)
+	const uint64 Scaled = (uint64)(FMath::Abs(Value) * (double)Scale + 0.5);
+	const uint64 IntPart = Scaled / Scale;
+	uint64 FracPart = Scaled % Scale;
+
+	// Sign + up to 13 integer digits + '.' + up to 9 fraction digits
+	ANSICHAR* Dest = Reserve(32);
+	ANSICHAR* const Start = Dest;
+
+	// Only print the sign when a non-zero value is printed (avoids "-0.000000")
+	if (bNegative && Scaled != 0)
+	{
+		*Dest++ = '-';
+	}
+
+	ANSICHAR Temp[16];
+	ANSICHAR* TempEnd = Temp + UE_ARRAY_COUNT(Temp);
+	ANSICHAR* IntBegin = SDFMeshWriterPrivate::WriteDigitsBackwards(TempEnd, IntPart);
+	const int32 IntLen = (int32)(TempEnd - IntBegin);
+	FMemory::Memcpy(Dest, IntBegin, IntLen);
+	Dest += IntLen;
+
+	if (Decimals > 0)
+	{
+		*Dest++ = '.';
+		for (int32 i = Decimals - 1; i >= 0; --i)
+		{
+			Dest[i] = (ANSICHAR)('0' + FracPart % 10);
+			FracPart /= 10;
+		}
+		Dest += Decimals;
+	}
+
+	Used += (int32)(Dest - Start);
+}
+
+void FSDFStreamWriter::Flush()
+{
+	if (Used > 0)
+	{
+		Archive.Serialize(Buffer.GetData(), Used);
+		FlushedBytes += Used;
+		Used = 0;
+	}
+}
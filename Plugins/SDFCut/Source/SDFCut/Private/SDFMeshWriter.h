@@ -0,0 +1,75 @@
+// SDFMeshWriter.h
+// Buffered writer used by FSDFMeshExporter to stream mesh files to an FArchive.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+
+/**
+ * Fixed-size buffered writer on top of an FArchive.
+ * Text is formatted straight into the buffer (ANSI), so no FString or
+ * UTF-8 conversion is ever built for the whole file.
+ * The buffer is heap allocated, so writers can live on thread-pool stacks.
+ */
+class FSDFStreamWriter
+{
+public:
+	static constexpr int32 BufferSize = 64 * 1024;
+
+	explicit FSDFStreamWriter(FArchive& InArchive);
+	~FSDFStreamWriter();
+
+	// Append raw bytes (binary formats)
+	void WriteBytes(const void* Data, int32 NumBytes);
+
+	template <typename T>
+	void WriteValue(const T& Value)
+	{
+		WriteBytes(&Value, sizeof(T));
+	}
+
+	// Append a null-terminated ANSI literal
+	void WriteText(const ANSICHAR* Text);
+
+	void WriteChar(ANSICHAR Char)
+	{
+		if (Used == BufferSize)
+		{
+			Flush();
+		}
+		Buffer.GetData()[Used++] = Char;
+	}
+
+	// Append a decimal integer
+	void WriteInt(int64 Value);
+
+	// Append a fixed-point decimal, matching printf("%.*f", Decimals, Value) for the range
+	// meshes live in (|Value| < 1e12) except that exact ties round away from zero.
+	// Larger or non-finite values fall back to printf.
+	void WriteFloat(double Value, int32 Decimals);
+
+	// Push buffered bytes to the archive
+	void Flush();
+
+	// Total bytes written through this writer (including buffered ones)
+	int64 GetBytesWritten() const { return FlushedBytes + Used; }
+
+	bool IsError() const { return Archive.IsError(); }
+
+private:
+	// Make room for at least NumBytes contiguous bytes
+	ANSICHAR* Reserve(int32 NumBytes)
+	{
+		if (Used + NumBytes > BufferSize)
+		{
+			Flush();
+		}
+		return Buffer.GetData() + Used;
+	}
+
+	FArchive& Archive;
+	TArray<ANSICHAR> Buffer;
+	int32 Used = 0;
+	int64 FlushedBytes = 0;
+};
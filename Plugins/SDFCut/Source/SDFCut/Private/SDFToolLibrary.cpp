@@ -0,0 +1,58 @@
+// SDFToolLibrary.cpp
+
+#include "SDFToolLibrary.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/VolumeTexture.h"
+
+FBox FSDFToolLibraryEntry::GetLocalBounds() const
+{
+	if (Shape.IsAnalytic())
+	{
+		return Shape.GetLocalBounds();
+	}
+	return Mesh ? Mesh->GetBoundingBox() : FBox(ForceInit);
+}
+
+void USDFToolLibrary::PostLoad()
+{
+	Super::PostLoad();
+	ResetActiveTool();
+}
+
+void USDFToolLibrary::ResetActiveTool()
+{
+	ActiveToolIndex.store(Tools.IsValidIndex(DefaultToolIndex) ? DefaultToolIndex : 0, std::memory_order_release);
+}
+
+bool USDFToolLibrary::SetActiveToolIndex(int32 Index)
+{
+	if (!Tools.IsValidIndex(Index))
+	{
+		return false;
+	}
+	ActiveToolIndex.store(Index, std::memory_order_release);
+	return true;
+}
+
+bool USDFToolLibrary::SetActiveToolByName(FName Name)
+{
+	const int32 Index = Tools.IndexOfByPredicate([Name](const FSDFToolLibraryEntry& Entry) { return Entry.Name == Name; });
+	return SetActiveToolIndex(Index);
+}
+
+bool USDFToolLibrary::AreToolTexturesResident() const
+{
+	for (const FSDFToolLibraryEntry& Entry : Tools)
+	{
+		if (Entry.Shape.IsAnalytic())
+		{
+			continue;
+		}
+		if (!Entry.SDFTexture || !Entry.SDFTexture->IsFullyStreamedIn() ||
+			!Entry.SDFTexture->GetResource() || !Entry.SDFTexture->GetResource()->GetTextureRHI().IsValid())
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,72 @@
+// SDFToolShape.cpp
+
+#include "SDFToolShape.h"
+
+FBox FSDFToolPrimitive::GetLocalBounds() const
+{
+	FVector Extent;
+	switch (Type)
+	{
+	case ESDFToolPrimitiveType::Cylinder:
+		Extent = FVector(Radius, Radius, HalfHeight);
+		break;
+	case ESDFToolPrimitiveType::Cone:
+		{
+			const float MaxRadius = FMath::Max(Radius, TipRadius);
+			Extent = FVector(MaxRadius, MaxRadius, HalfHeight);
+		}
+		break;
+	case ESDFToolPrimitiveType::Capsule:
+		Extent = FVector(Radius, Radius, HalfHeight + Radius);
+		break;
+	default:
+		Extent = FVector(Radius);
+		break;
+	}
+	return FBox(Center - Extent, Center + Extent);
+}
+
+ESDFToolKernel FSDFToolShape::GetKernel() const
+{
+	const int32 NumPrimitives = GetNumPrimitives();
+	if (NumPrimitives == 0)
+	{
+		return ESDFToolKernel::MeshTexture;
+	}
+
+	const ESDFToolPrimitiveType Type = Primitives[0].Type;
+	for (int32 i = 1; i < NumPrimitives; i++)
+	{
+		if (Primitives[i].Type != Type)
+		{
+			return ESDFToolKernel::Mixed;
+		}
+	}
+	return (ESDFToolKernel)((int32)Type + 1);
+}
+
+FBox FSDFToolShape::GetLocalBounds() const
+{
+	FBox Bounds(ForceInit);
+	for (int32 i = 0; i < GetNumPrimitives(); i++)
+	{
+		Bounds += Primitives[i].GetLocalBounds();
+	}
+
+	// 平滑并集最多向外鼓出 K / 4
+	if (Bounds.IsValid && GetNumPrimitives() > 1 && SmoothRadius > 0.0f)
+	{
+		Bounds = Bounds.ExpandBy(SmoothRadius * 0.25f);
+	}
+	return Bounds;
+}
+
+float FSDFToolShape::Evaluate(const FVector3f& LocalPos) const
+{
+	float Distance = TNumericLimits<float>::Max();
+	SDFToolShape::DispatchKernel(GetKernel(), [&](auto KernelTag)
+	{
+		Distance = SDFToolShape::Evaluate<decltype(KernelTag)::value>(*this, LocalPos);
+	});
+	return Distance;
+}
@@ -0,0 +1,248 @@
+// SDFVolumeAsset.cpp
+
+#include "SDFVolumeAsset.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Compression.h"
+#include <atomic>
+
+FIntVector USDFVolumeAsset::GetNumBricks() const
+{
+	return FIntVector(
+		FMath::DivideAndRoundUp(Dimensions.X, BrickSize),
+		FMath::DivideAndRoundUp(Dimensions.Y, BrickSize),
+		FMath::DivideAndRoundUp(Dimensions.Z, BrickSize));
+}
+
+void USDFVolumeAsset::GetBrickRegion(int32 BrickIndex, FIntVector& OutMin, FIntVector& OutSize) const
+{
+	const FIntVector NumBricks = GetNumBricks();
+	const int32 BX = BrickIndex % NumBricks.X;
+	const int32 BY = (BrickIndex / NumBricks.X) % NumBricks.Y;
+	const int32 BZ = BrickIndex / (NumBricks.X * NumBricks.Y);
+
+	OutMin = FIntVector(BX, BY, BZ) * BrickSize;
+	OutSize = FIntVector(
+		FMath::Min(BrickSize, Dimensions.X - OutMin.X),
+		FMath::Min(BrickSize, Dimensions.Y - OutMin.Y),
+		FMath::Min(BrickSize, Dimensions.Z - OutMin.Z));
+}
+
+bool USDFVolumeAsset::Build(const FIntVector& InDimensions, const FFloat16Color* Voxels, FName InCompressionFormat, float FarDistance)
+{
+	if (!Voxels || InDimensions.X <= 0 || InDimensions.Y <= 0 || InDimensions.Z <= 0 || BrickSize <= 0)
+	{
+		return false;
+	}
+
+	Dimensions = InDimensions;
+	CompressionFormat = InCompressionFormat;
+
+	const FIntVector NumBricks = GetNumBricks();
+	const int32 TotalBricks = NumBricks.X * NumBricks.Y * NumBricks.Z;
+	const int64 SliceSize = (int64)Dimensions.X * Dimensions.Y;
+
+	TArray<FBrick> NewBricks;
+	NewBricks.SetNum(TotalBricks);
+
+	// 每块单独压缩，之后再按顺序拼接
+	TArray<TArray<uint8>> BrickData;
+	BrickData.SetNum(TotalBricks);
+
+	const FFloat16 MaxDistance(FarDistance);
+	const FFloat16 MinDistance(-FarDistance);
+	std::atomic<bool> bFailed{false};
+
+	ParallelFor(TotalBricks, [&](int32 BrickIndex)
+	{
+		FIntVector Min, Size;
+		GetBrickRegion(BrickIndex, Min, Size);
+
+		// 收集块内体素 (X 最快)
+		TArray<FFloat16Color> Local;
+		Local.SetNumUninitialized(Size.X * Size.Y * Size.Z);
+		int32 Dst = 0;
+		for (int32 Z = 0; Z < Size.Z; Z++)
+		{
+			for (int32 Y = 0; Y < Size.Y; Y++)
+			{
+				const FFloat16Color* Row = Voxels + (int64)(Min.Z + Z) * SliceSize + (int64)(Min.Y + Y) * Dimensions.X + Min.X;
+				FMemory::Memcpy(&Local[Dst], Row, Size.X * sizeof(FFloat16Color));
+				Dst += Size.X;
+			}
+		}
+
+		if (FarDistance > 0.0f)
+		{
+			for (FFloat16Color& Voxel : Local)
+			{
+				const float Distance = Voxel.R.GetFloat();
+				if (Distance > FarDistance)
+				{
+					Voxel.R = MaxDistance;
+				}
+				else if (Distance < -FarDistance)
+				{
+					Voxel.R = MinDistance;
+				}
+			}
+		}
+
+		// 按位比较，所有体素相同则只记录一个值
+		bool bUniform = true;
+		for (int32 i = 1; i < Local.Num() && bUniform; i++)
+		{
+			bUniform = FMemory::Memcmp(&Local[i], &Local[0], sizeof(FFloat16Color)) == 0;
+		}
+
+		FBrick& Brick = NewBricks[BrickIndex];
+		Brick.UniformValue = Local[0];
+		if (bUniform)
+		{
+			return;
+		}
+
+		const int32 RawBytes = Local.Num() * sizeof(FFloat16Color);
+		int32 CompressedBytes = FCompression::CompressMemoryBound(CompressionFormat, RawBytes);
+		TArray<uint8>& Compressed = BrickData[BrickIndex];
+		Compressed.SetNumUninitialized(CompressedBytes);
+		if (!FCompression::CompressMemory(CompressionFormat, Compressed.GetData(), CompressedBytes, Local.GetData(), RawBytes))
+		{
+			bFailed = true;
+			return;
+		}
+		Compressed.SetNum(CompressedBytes, EAllowShrinking::No);
+		Brick.CompressedBytes = CompressedBytes;
+	});
+
+	if (bFailed)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SDFVolumeAsset: Compression with %s failed"), *CompressionFormat.ToString());
+		return false;
+	}
+
+	// 拼接负载，填写块偏移
+	int64 TotalBytes = 0;
+	NumUniformBricks = 0;
+	for (int32 i = 0; i < TotalBricks; i++)
+	{
+		NewBricks[i].Offset = (uint32)TotalBytes;
+		TotalBytes += NewBricks[i].CompressedBytes;
+		NumUniformBricks += NewBricks[i].CompressedBytes == 0 ? 1 : 0;
+	}
+
+	if (TotalBytes > MAX_uint32)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SDFVolumeAsset: Compressed payload exceeds 4 GB"));
+		return false;
+	}
+
+	Payload.Lock(LOCK_READ_WRITE);
+	uint8* PayloadData = (uint8*)Payload.Realloc(TotalBytes);
+	for (int32 i = 0; i < TotalBricks; i++)
+	{
+		if (NewBricks[i].CompressedBytes > 0)
+		{
+			FMemory::Memcpy(PayloadData + NewBricks[i].Offset, BrickData[i].GetData(), NewBricks[i].CompressedBytes);
+		}
+	}
+	Payload.Unlock();
+
+	Bricks = MoveTemp(NewBricks);
+	CompressedSize = TotalBytes;
+
+	UE_LOG(LogTemp, Log, TEXT("SDFVolumeAsset: %dx%dx%d, %d/%d uniform bricks, %.1f MB -> %.1f MB (%s)"),
+		Dimensions.X, Dimensions.Y, Dimensions.Z, NumUniformBricks, TotalBricks,
+		GetUncompressedSize() / (1024.0 * 1024.0), TotalBytes / (1024.0 * 1024.0), *CompressionFormat.ToString());
+	return true;
+}
+
+bool USDFVolumeAsset::DecompressTo(TArray<FFloat16Color>& OutVoxels)
+{
+	if (!IsValid())
+	{
+		return false;
+	}
+
+	const int64 SliceSize = (int64)Dimensions.X * Dimensions.Y;
+	OutVoxels.SetNumUninitialized(SliceSize * Dimensions.Z);
+
+	// 非编辑器下取出负载后丢弃内部副本，峰值内存 = 压缩负载 + 解压结果
+	void* CompressedData = nullptr;
+	if (Payload.GetBulkDataSize() > 0)
+	{
+		Payload.GetCopy(&CompressedData, !GIsEditor);
+		if (!CompressedData)
+		{
+			UE_LOG(LogTemp, Error, TEXT("SDFVolumeAsset: Failed to load payload of %s"), *GetName());
+			return false;
+		}
+	}
+	const uint8* PayloadData = (const uint8*)CompressedData;
+
+	struct FDecompressContext
+	{
+		TArray<FFloat16Color> Scratch;
+	};
+	TArray<FDecompressContext> Contexts;
+	std::atomic<bool> bFailed{false};
+
+	ParallelForWithTaskContext(Contexts, Bricks.Num(), [&](FDecompressContext& Context, int32 BrickIndex)
+	{
+		const FBrick& Brick = Bricks[BrickIndex];
+		FIntVector Min, Size;
+		GetBrickRegion(BrickIndex, Min, Size);
+
+		const FFloat16Color* Source = nullptr;
+		int32 SourceStride = 0;
+		if (Brick.CompressedBytes > 0)
+		{
+			Context.Scratch.SetNumUninitialized(Size.X * Size.Y * Size.Z, EAllowShrinking::No);
+			if (!FCompression::UncompressMemory(CompressionFormat, Context.Scratch.GetData(), Context.Scratch.Num() * sizeof(FFloat16Color),
+				PayloadData + Brick.Offset, Brick.CompressedBytes))
+			{
+				bFailed = true;
+				return;
+			}
+			Source = Context.Scratch.GetData();
+			SourceStride = Size.X;
+		}
+
+		// 按行写入线性数组，均匀块直接填充
+		for (int32 Z = 0; Z < Size.Z; Z++)
+		{
+			for (int32 Y = 0; Y < Size.Y; Y++)
+			{
+				FFloat16Color* Row = OutVoxels.GetData() + (int64)(Min.Z + Z) * SliceSize + (int64)(Min.Y + Y) * Dimensions.X + Min.X;
+				if (Source)
+				{
+					FMemory::Memcpy(Row, Source, Size.X * sizeof(FFloat16Color));
+					Source += SourceStride;
+				}
+				else
+				{
+					for (int32 X = 0; X < Size.X; X++)
+					{
+						Row[X] = Brick.UniformValue;
+					}
+				}
+			}
+		}
+	});
+
+	FMemory::Free(CompressedData);
+
+	if (bFailed)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SDFVolumeAsset: Corrupt brick data in %s"), *GetName());
+		return false;
+	}
+	return true;
+}
+
+void USDFVolumeAsset::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	Ar << Bricks;
+	Payload.Serialize(Ar, this);
+}
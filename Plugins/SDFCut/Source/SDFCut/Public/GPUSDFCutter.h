@@ -8,22 +8,82 @@
 #include "Components/StaticMeshComponent.h"
 #include "Engine/TextureRenderTargetVolume.h"
 #include "SDFVolumeProvider.h"
+#include "SDFDistancePyramid.h"
+#include "SDFCutDelta.h"
+#include "SDFToolShape.h"
 #include "RHIResources.h"
 #include "RenderGraphFwd.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Engine/VolumeTexture.h"
+#include "SDFVolumeAsset.h"
 #include <atomic>
 #include "GPUSDFCutter.generated.h"
 
+class USDFToolLibrary;
+
 
 class UVolumeTexture;
 class AStaticMeshActor;
+class UDynamicMesh;
+namespace UE::Geometry { class FDynamicMesh3; }
+
+/** File format for UGPUSDFCutter::ExportMesh */
+UENUM(BlueprintType)
+enum class ESDFExportFormat : uint8
+{
+	OBJ         UMETA(DisplayName = "OBJ (text)"),
+	BinaryPLY   UMETA(DisplayName = "PLY (binary)"),
+	BinarySTL   UMETA(DisplayName = "STL (binary)")
+};
+
+/** 异步导出完成 (在 GameThread 上广播) */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnSDFExportCompleted, bool, bSuccess, const FString&, FilePath, int32, TriangleCount);
+
+/** 异步导出进度 0~1 (在 GameThread 上广播) */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSDFExportProgress, float, Progress);
+
+/** 异步初始化结束 (在 GameThread 上广播)，取消或失败时 bSuccess = false */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSDFCutterReady, bool, bSuccess);
+
+/** 异步初始化进度 0~1 (在 GameThread 上广播) */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSDFCutterInitProgress, float, Progress);
 
-// 牙齿材质类型
-enum EVolumeMaterial
+/** 射线 (世界空间线段) */
+USTRUCT(BlueprintType)
+struct FSDFRay
 {
-	Enamel=0, // 牙釉质
-	Dentin=1, // 牙本质
-	Caries=2, // 龋坏部分
-	Fill=3   //  金属填充物
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GPU SDF Cutter|RayCast")
+	FVector Start = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GPU SDF Cutter|RayCast")
+	FVector End = FVector::ZeroVector;
+};
+
+/** 射线与切削体表面 (SDF = 0) 的第一个交点 */
+USTRUCT(BlueprintType)
+struct FSDFRayHit
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "GPU SDF Cutter|RayCast")
+	bool bHit = false;
+
+	// 世界空间交点
+	UPROPERTY(BlueprintReadOnly, Category = "GPU SDF Cutter|RayCast")
+	FVector Location = FVector::ZeroVector;
+
+	// 世界空间表面法线 (指向外部)
+	UPROPERTY(BlueprintReadOnly, Category = "GPU SDF Cutter|RayCast")
+	FVector Normal = FVector::ZeroVector;
+
+	// 起点到交点的世界距离 (起点已在内部时为 0)
+	UPROPERTY(BlueprintReadOnly, Category = "GPU SDF Cutter|RayCast")
+	float Distance = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GPU SDF Cutter|RayCast")
+	int32 MaterialID = INDEX_NONE;
 };
 
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
@@ -38,7 +98,9 @@ public:
 	/**
 	 * 手动初始化 SDF 切削系统（必须在所有资源加载完成后调用）
 	 * 用于子关卡场景：在子关卡加载完成后手动调用此函数
-	 * @return true 如果初始化成功，false 如果资源未就绪
+	 * 初始化分阶段进行：GameThread 上只创建 VolumeRT，体数据的读取/解压、材质统计和距离金字塔在后台任务中完成，
+	 * 完成后回到 GameThread 接管数据并上传 GPU，广播 OnCutterReady
+	 * @return true 如果初始化已开始 (或已完成)，false 如果资源未就绪
 	 */
 	UFUNCTION(BlueprintCallable, Category = "GPU SDF Cutter")
 	bool InitSDFCutter();
@@ -49,7 +111,25 @@ public:
 	UFUNCTION(BlueprintPure, Category = "GPU SDF Cutter")
 	bool IsInitialized() const { return bGPUResourcesInitialized; }
 
-	// 初始化SDF纹理
+	// 后台初始化是否正在进行
+	UFUNCTION(BlueprintPure, Category = "GPU SDF Cutter")
+	bool IsInitializing() const { return ActiveInitJob.IsValid(); }
+
+	// 后台初始化进度 (0~1)，没有进行中的初始化时返回 0
+	UFUNCTION(BlueprintPure, Category = "GPU SDF Cutter")
+	float GetInitProgress() const;
+
+	// 取消进行中的初始化 (OnCutterReady 以 false 广播，之后可以重新调用 InitSDFCutter)
+	UFUNCTION(BlueprintCallable, Category = "GPU SDF Cutter")
+	void CancelInitialization();
+
+	UPROPERTY(BlueprintAssignable, Category = "GPU SDF Cutter")
+	FOnSDFCutterReady OnCutterReady;
+
+	UPROPERTY(BlueprintAssignable, Category = "GPU SDF Cutter")
+	FOnSDFCutterInitProgress OnInitProgress;
+
+	// 初始化SDF纹理 (GameThread 阶段，之后启动后台初始化任务)
 	UFUNCTION()
 	void InitResources();
 
@@ -64,8 +144,63 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GPU SDF Cutter")
 	bool GetSDFValueAndNormal(FVector WorldLocation, float& OutSDFValue, FVector& OutNormal, int32& OutMaterialID);
 
+	/**
+	 * 对当前切削体做射线检测 (直接查询 CPU SDF 镜像，不依赖物理碰撞)
+	 * 用距离金字塔跳过远离表面的砖块，只在表面附近逐步推进，最后二分细化交点
+	 * @return 是否命中
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GPU SDF Cutter|RayCast")
+	bool RayCast(FVector Start, FVector End, FSDFRayHit& OutHit);
+
+	/**
+	 * 批量射线检测：只加一次读锁，射线之间并行
+	 * OutHits 与 Rays 一一对应
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GPU SDF Cutter|RayCast")
+	void RayCastBatch(const TArray<FSDFRay>& Rays, TArray<FSDFRayHit>& OutHits);
+
+	/**
+	 * 射线检测性能测试：在目标包围盒周围生成随机射线，
+	 * 分别测试金字塔加速与纯球面追踪，输出 rays/sec
+	 * @return 金字塔加速时的 rays/sec
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GPU SDF Cutter|RayCast")
+	float BenchmarkRayCasts(int32 NumRays = 100000);
+
+	/**
+	 * 切削增量通道：每次局部回读写入 CPU_SDFData 后，发布一条变化体素的增量记录
+	 * 网格坐标即体素坐标 (GridOrigin = 目标局部包围盒最小点，CellSize = VoxelSize)
+	 * 没有订阅者时不构建增量
+	 */
+	FSDFCutDeltaChannel& GetCutDeltaChannel() { return CutDeltaChannel; }
+
+	// 参与体积统计的最大材质 ID 数量
+	static constexpr int32 MaxTrackedMaterialIDs = 16;
+
+	/**
+	 * 计算某种材质的当前体积 (读取增量维护的计数器，O(1))
+	 * 只统计 ID 在 [0, MaxTrackedMaterialIDs) 范围内的材质
+	 * @param bSubVoxelAccurate false: 按 SDF <= 0 的整体素计数; true: 用 SDF 估计表面附近体素的占据比例，低分辨率下也更准确
+	 */
 	UFUNCTION(BlueprintCallable, Category = "SDF")
-	float CalculateCurrentVolume(int32 MaterialID, bool bWorldSpace = true);
+	float CalculateCurrentVolume(int32 MaterialID, bool bWorldSpace = true, bool bSubVoxelAccurate = false);
+
+	// 一次性获取所有材质的体积，OutVolumes[ID] 对应材质 ID (O(1))
+	UFUNCTION(BlueprintCallable, Category = "SDF")
+	void CalculateAllMaterialVolumes(TArray<float>& OutVolumes, bool bWorldSpace = true, bool bSubVoxelAccurate = false);
+
+	/**
+	 * 全量扫描 CPU_SDFData 统计每种材质在表面内部的体素数量
+	 * 按 Z 切片并行，每个线程使用独立的局部计数，最后合并
+	 * 一般不需要手动调用：初始化时会执行一次，之后由 UpdateCPUDataPartial 增量维护
+	 * @param OutCounts    输出 MaxTrackedMaterialIDs 个整体素计数
+	 * @param OutOccupancy 可选，输出 MaxTrackedMaterialIDs 个定点占据率之和 (单位 1/OccupancyFixedScale 体素)
+	 */
+	void ComputeMaterialHistogram(TArray<int64>& OutCounts, TArray<int64>* OutOccupancy = nullptr) const;
+
+	// 对任意体数据做同样的统计 (后台初始化任务使用，调用方负责数据的线程安全)
+	static void ComputeMaterialHistogram(const TArray<FFloat16Color>& SDFData, const FIntVector& Dimensions, float InVoxelSize,
+		TArray<int64>& OutCounts, TArray<int64>* OutOccupancy = nullptr);
 
 	/**
 	 * Export current SDF volume to OBJ mesh file.
@@ -101,6 +236,96 @@ public:
 		bool bIncludeMaterialColors = true
 	);
 
+	/**
+	 * Export current SDF volume to a mesh file. The file is streamed through a
+	 * fixed-size buffer, so large volumes do not build the whole file in memory.
+	 * STL carries no normals or colors.
+	 *
+	 * @param FilePath      Full path to output file
+	 * @param Format        Output file format
+	 * @param CubeSize      Size of marching cubes cells (0 = use voxel size)
+	 * @param bIncludeNormals  Include vertex normals in export
+	 * @param bIncludeMaterialColors  Encode material IDs as vertex colors
+	 * @return True if export succeeded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GPU SDF Cutter|Export")
+	bool ExportMesh(
+		const FString& FilePath,
+		ESDFExportFormat Format = ESDFExportFormat::OBJ,
+		float CubeSize = 0.0f,
+		bool bIncludeNormals = true,
+		bool bIncludeMaterialColors = true
+	);
+
+	/**
+	 * Extract the current volume once and write it with every mesh writer
+	 * (legacy OBJ string, streamed OBJ, binary PLY, binary STL) into Directory,
+	 * logging MB/s for each.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GPU SDF Cutter|Export")
+	void BenchmarkMeshWriters(const FString& Directory, float CubeSize = 0.0f);
+
+	/**
+	 * Export current SDF volume on a background task.
+	 * CPU_SDFData is snapshotted on the calling (game) thread with a single memcpy under the read lock,
+	 * so the exported volume is consistent with one point in time. This is a full-volume copy
+	 * (8 bytes per voxel, ~1 GB at 512^3) and briefly blocks cuts that need the write lock.
+	 * Extraction and file write then run on the thread pool, so cutting and haptics keep running.
+	 * Progress and completion are broadcast on the game thread (OnExportProgress / OnExportCompleted).
+	 *
+	 * @return False if no SDF data is available or another export is still running
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GPU SDF Cutter|Export")
+	bool ExportMeshAsync(
+		const FString& FilePath,
+		ESDFExportFormat Format = ESDFExportFormat::OBJ,
+		float CubeSize = 0.0f,
+		bool bIncludeNormals = true,
+		bool bIncludeMaterialColors = true
+	);
+
+	/** Request cancellation of the running async export (completion fires with bSuccess = false) */
+	UFUNCTION(BlueprintCallable, Category = "GPU SDF Cutter|Export")
+	void CancelAsyncExport();
+
+	/** Progress of the running async export (0~1), 0 if none is running */
+	UFUNCTION(BlueprintPure, Category = "GPU SDF Cutter|Export")
+	float GetAsyncExportProgress() const;
+
+	UFUNCTION(BlueprintPure, Category = "GPU SDF Cutter|Export")
+	bool IsAsyncExportRunning() const { return ActiveExportJob.IsValid(); }
+
+	/**
+	 * Use dual contouring instead of marching cubes for export.
+	 * Keeps sharp cut edges (also with CubeSize > voxel size) and groups triangles by material.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GPU SDF Cutter|Export")
+	bool bExportWithDualContouring = false;
+
+	UPROPERTY(BlueprintAssignable, Category = "GPU SDF Cutter|Export")
+	FOnSDFExportCompleted OnExportCompleted;
+
+	UPROPERTY(BlueprintAssignable, Category = "GPU SDF Cutter|Export")
+	FOnSDFExportProgress OnExportProgress;
+
+	/**
+	 * Extract mesh from current SDF data and write it into a UDynamicMesh inside EditMesh.
+	 * Skips the OBJ/PLY writers and the FDynamicMesh3 -> UDynamicMesh round trip; the marching cubes
+	 * path still builds compact vertex/index buffers first and then copies them into the mesh.
+	 * Uses dual contouring when bExportWithDualContouring is set (triangle groups = material IDs).
+	 *
+	 * @param TargetMesh     Mesh to overwrite
+	 * @param OutMaterialIDs Output per-vertex material IDs (indexed by vertex ID)
+	 * @param CubeSize       Size of marching cubes cells (0 = use voxel size)
+	 * @return True if extraction succeeded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GPU SDF Cutter|Export")
+	bool ExtractMeshToDynamicMesh(
+		UDynamicMesh* TargetMesh,
+		TArray<int32>& OutMaterialIDs,
+		float CubeSize = 0.0f
+	);
+
 	/**
 	 * Extract mesh from current SDF data (for further processing).
 	 * Returns mesh in local space of the target mesh component.
@@ -125,9 +350,27 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Textures")
 	UVolumeTexture* OriginalSDFTexture = nullptr;
 
+	// 分块压缩的 SDF 体数据，设置后替代 OriginalSDFTexture：
+	// 并行解压到 CPU 镜像，再每帧上传一层块到 VolumeRT (不需要体积纹理的平台数据)，上传完成前不切削
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Textures")
+	USDFVolumeAsset* SDFVolumeAsset = nullptr;
+
+	// 网格刀具的SDF纹理 (ToolShape 为解析形状时可不设置)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Textures")
 	UVolumeTexture* ToolSDFTexture = nullptr;
 
+	// 解析刀具形状 (球/圆柱/圆锥/胶囊的并集，刀具组件局部空间)，为空时使用 ToolSDFTexture
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GPU SDF Cutter|Tool")
+	FSDFToolShape ToolShape;
+
+	// 运行时更换刀具形状 (同时更新切削区域所用的刀具边界)
+	UFUNCTION(BlueprintCallable, Category = "GPU SDF Cutter|Tool")
+	void SetToolShape(const FSDFToolShape& NewShape);
+
+	// 常驻刀具库：设置后 ToolShape / ToolSDFTexture 跟随库的当前刀具 (每帧检查索引，换刀无需重新初始化)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GPU SDF Cutter|Tool")
+	USDFToolLibrary* ToolLibrary = nullptr;
+
 	UPROPERTY()
 	UTextureRenderTargetVolume* VolumeRT = nullptr;
 
@@ -155,7 +398,11 @@ public:
 	virtual bool WorldToVoxelSpace(const FVector& WorldLocation, FVector& OutVoxelCoord) const override;
 	virtual float SampleSDF(const FVector& VoxelCoord) const override; // 包装原有的 SampleSDFTrilinear
 	virtual int32 SampleMaterialID(const FVector& VoxelCoord) const override;
+	virtual float SampleSDFAndMaterial(const FVector& VoxelCoord, int32& OutMaterialID) const override;
 	virtual float GetVoxelSize() const override { return VoxelSize; }
+	virtual float GetWorldToSDFScale() const override;
+	virtual FTransform GetLocalToWorldTransform() const override;
+	virtual const FSDFDistancePyramid* GetDistancePyramid() const override { return DistancePyramid.IsValid() ? &DistancePyramid : nullptr; }
 	virtual FRWLock& GetDataLock() override { return DataRWLock; }
 private:
 	// 读写锁，防止切削回读时，Haptics正在读取导致崩溃
@@ -169,6 +416,9 @@ private:
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+
+	// 取消未完成的异步导出和初始化
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 
 	// 触觉参数
@@ -213,20 +463,87 @@ private:
 	// 计算切割工具尺寸信息
 	void CalculateToolDimensions();
 
+	// 刀具库的当前刀具变化时切换 ToolShape / ToolSDFTexture，返回是否发生了切换
+	bool SyncActiveTool();
+
+	// 当前应用的刀具库索引
+	int32 AppliedToolIndex = INDEX_NONE;
+
 	FTextureRHIRef OriginalSDFRHIRef;
 	FTextureRHIRef ToolSDFRHIRef;
 	FTextureRHIRef VolumeRTRHIRef;
 
-	// 初始化CPU端缓存
-	void InitCPUData();
+	// 后台初始化任务的共享状态 (GameThread 与后台任务共同持有)
+	// 后台只写入任务自己的数据，完成后在 GameThread 上移动到组件中，组件中途销毁也不受影响
+	struct FInitJob
+	{
+		std::atomic<float> Progress{0.0f};
+		std::atomic<bool> bCancelRequested{false};
+
+		// 数据源 (后台读取期间保持引用)
+		TStrongObjectPtr<UVolumeTexture> SourceTexture;
+		TStrongObjectPtr<USDFVolumeAsset> SourceAsset;
+
+		FIntVector Dimensions = FIntVector::ZeroValue;
+		float VoxelSize = 1.0f;
+
+		// 切削对象的 LocalBounds，完成时才写入组件 (在此之前 WorldToVoxelSpace 返回 false，查询不会访问尚未就绪的数据)
+		FBox TargetLocalBounds = FBox(ForceInit);
+
+		// 结果
+		TArray<FFloat16Color> SDFData;
+		TArray<int64> MaterialCounts;
+		TArray<int64> MaterialOccupancy;
+		FSDFDistancePyramid Pyramid;
+	};
+
+	// 当前正在运行的后台初始化，仅在 GameThread 上读写
+	TSharedPtr<FInitJob, ESPMode::ThreadSafe> ActiveInitJob;
+
+	// 后台阶段：读取/解压体数据到 Job->SDFData，统计材质，构建距离金字塔 (取消时提前返回 false)
+	static bool BuildInitialCPUData(FInitJob& Job, TFunctionRef<void(float)> ReportProgress);
+
+	// GameThread 阶段：接管后台结果，上传 GPU，广播 OnCutterReady
+	void FinishInitialization(const TSharedPtr<FInitJob, ESPMode::ThreadSafe>& Job, bool bSuccess);
     
 	void UpdateCPUDataPartial(FIntVector UpdateMin, FIntVector UpdateSize, TArray<FFloat16Color>& LocalData);
 	
 	// 辅助：获取体素索引
 	int32 GetVoxelIndex(int32 X, int32 Y, int32 Z) const;
 
+	// 单条射线检测 (调用方持有读锁)，bUsePyramid = false 时退化为纯球面追踪 (用于性能对比)
+	bool RayCastLocked(const FTransform& TargetTransform, const FVector& WorldStart, const FVector& WorldEnd, bool bUsePyramid, FSDFRayHit& OutHit) const;
+
+	// 批量射线检测 (自行加读锁)
+	void RayCastBatchInternal(const TArray<FSDFRay>& Rays, TArray<FSDFRayHit>& OutHits, bool bUsePyramid);
+
 	// CPU端缓存的SDF数据 (线性数组: Z * Y * X)
 	TArray<FFloat16Color> CPU_SDFData;
+
+	// CPU_SDFData 的保守距离金字塔，与其一同在 DataRWLock 下更新 (只重建脏区域)
+	FSDFDistancePyramid DistancePyramid;
+
+	// 切削增量通道 (在 UpdateCPUDataPartial 中发布)
+	FSDFCutDeltaChannel CutDeltaChannel;
+
+	// 每种材质在表面内部 (SDF <= 0) 的体素数量，受 DataRWLock 保护
+	int64 MaterialVoxelCounts[MaxTrackedMaterialIDs] = {};
+
+	// 每种材质的体素占据率之和 (定点数，避免增量更新时的浮点累积误差)
+	int64 MaterialOccupancySums[MaxTrackedMaterialIDs] = {};
+
+	// 占据率定点数的缩放 (1.0 = 一个完整体素)
+	static constexpr int64 OccupancyFixedScale = 1 << 16;
+
+	// 体素在表面内部时返回其材质 ID，否则 (或 ID 不在统计范围内) 返回 INDEX_NONE
+	static int32 GetInsideMaterialIndex(const FFloat16Color& Voxel);
+
+	// 体素的材质 ID，不在统计范围内时返回 INDEX_NONE
+	static int32 GetTrackedMaterialIndex(const FFloat16Color& Voxel);
+
+	// 体素被材质占据的比例 (定点数)：occupancy = clamp(0.5 - d / h, 0, 1)
+	// d 为体素中心的 SDF，h 为体素边长，即把体素看作被平面切开时的近似覆盖率
+	static int64 GetQuantizedOccupancy(const FFloat16Color& Voxel, float InvVoxelSize);
     
 	// 标记是否正在回读，防止重入
 	std::atomic<bool> bIsReadingBack{false};
@@ -236,4 +553,41 @@ private:
 
 	// 执行初始纹理复制
 	void ExecuteInitialTextureCopy();
+
+	// 使用 SDFVolumeAsset 时，从 CPU 镜像上传一层块 (BrickSize 层切片) 到 VolumeRT，每帧一次
+	void UploadInitialVolumeFromCPUData(FTextureRHIRef DestVolumeRHI);
+
+	// 初始上传的下一层切片起点 (仅 GameThread)
+	int32 InitialUploadSliceZ = 0;
+
+	// 异步导出任务的共享状态 (GameThread 与后台任务共同持有)
+	struct FExportJob
+	{
+		std::atomic<float> Progress{0.0f};
+		std::atomic<bool> bCancelRequested{false};
+	};
+
+	// 当前正在运行的异步导出，仅在 GameThread 上读写
+	TSharedPtr<FExportJob, ESPMode::ThreadSafe> ActiveExportJob;
+
+	// 导出步骤 1：从 SDF 数据提取网格与顶点颜色 (调用方负责数据的线程安全)
+	static bool ExtractExportMesh(
+		const TArray<FFloat16Color>& SDFData,
+		const FIntVector& Dimensions,
+		float InVoxelSize,
+		const FBox& LocalBounds,
+		float CubeSize,
+		bool bWantColors,
+		bool bDualContouring,
+		UE::Geometry::FDynamicMesh3& OutMesh,
+		TArray<FLinearColor>& OutVertexColors,
+		FExportJob* Job = nullptr);
+
+	// 导出步骤 2：写入文件
+	static bool WriteExportMesh(
+		const UE::Geometry::FDynamicMesh3& Mesh,
+		const TArray<FLinearColor>& VertexColors,
+		const FString& FilePath,
+		ESDFExportFormat Format,
+		bool bIncludeNormals);
 };
@@ -0,0 +1,42 @@
+// SDFCacheFile.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 通用的二进制缓存文件 (固定文件头 + 原始负载)
+ * 写入走普通文件写入，读取使用内存映射，避免整文件拷贝到临时缓冲。
+ * 用于探针点壳、工具SDF等"生成一次、反复使用"的数据。
+ */
+class SDFCUT_API FSDFCacheFile
+{
+public:
+	// 文件头 (所有缓存文件共用)
+	struct FHeader
+	{
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		uint64 Key = 0;
+		uint64 PayloadSize = 0;
+	};
+
+	/**
+	 * 获取缓存文件路径: <ProjectSaved>/SDFCut/<Category>/<Key>.bin
+	 * @param Category  缓存类别 (子目录名)
+	 * @param Key       内容键 (通常是输入数据的哈希)
+	 */
+	static FString GetCachePath(const TCHAR* Category, uint64 Key);
+
+	/**
+	 * 写入缓存文件
+	 * @param WritePayload  负责把负载写入 Archive 的回调
+	 * @return 写入是否成功
+	 */
+	static bool Write(const FString& FilePath, uint32 Magic, uint32 Version, uint64 Key, TFunctionRef<void(FArchive&)> WritePayload);
+
+	/**
+	 * 以内存映射方式读取缓存文件，文件头不匹配 (Magic/Version/Key) 时返回 false
+	 * @param ReadPayload  收到映射后的负载指针和大小，返回 false 表示负载无效
+	 */
+	static bool ReadMapped(const FString& FilePath, uint32 Magic, uint32 Version, uint64 Key, TFunctionRef<bool(const uint8*, int64)> ReadPayload);
+};
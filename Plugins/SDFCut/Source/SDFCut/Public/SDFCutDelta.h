@@ -0,0 +1,130 @@
+// SDFCutDelta.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+/**
+ * 一次切削修改了哪些体素 (稀疏增量记录)
+ *
+ * 区域内按 X 最快、Z 最慢的线性顺序做游程编码：每个游程先跳过 Skip 个未变化的体素，
+ * 再连续 Count 个变化的体素。变化体素的旧值/新值按游程顺序紧密存放 (R = 距离，G = 材质 ID)。
+ * 体积统计、重建网格、撤销、录制回放等可以订阅增量，而不必重新扫描整个体积。
+ */
+struct SDFCUT_API FSDFCutDelta
+{
+	struct FRun
+	{
+		int32 Skip = 0;
+		int32 Count = 0;
+	};
+
+	// 稀疏构建用的条目 (Index 为区域内线性索引，顺序任意)
+	struct FSparseEntry
+	{
+		int32 Index = 0;
+		FFloat16Color Old;
+		FFloat16Color New;
+	};
+
+	// 发布序号 (由 FSDFCutDeltaChannel::Publish 分配，从 1 开始单调递增)
+	uint64 Sequence = 0;
+
+	// 发布时间 (FPlatformTime::Seconds)
+	double Timestamp = 0.0;
+
+	// 网格坐标系 (生产者局部空间)：网格坐标 (X, Y, Z) 位于 GridOrigin + (X, Y, Z) * CellSize
+	FVector GridOrigin = FVector::ZeroVector;
+	float CellSize = 1.0f;
+
+	// 受影响区域 (网格坐标)
+	FIntVector RegionMin = FIntVector::ZeroValue;
+	FIntVector RegionSize = FIntVector::ZeroValue;
+
+	TArray<FRun> Runs;
+	TArray<FFloat16Color> OldValues;
+	TArray<FFloat16Color> NewValues;
+
+	int32 GetNumChangedVoxels() const { return NewValues.Num(); }
+
+	bool IsEmpty() const { return NewValues.Num() == 0; }
+
+	// 按区域线性顺序追加 (与 AddChanged 交替调用)
+	void AddUnchanged(int32 Count = 1);
+	void AddChanged(const FFloat16Color& Old, const FFloat16Color& New);
+
+	// 由任意顺序的稀疏条目构建 (会对 Entries 排序，重复索引只保留第一个)
+	void BuildFromSparse(TArray<FSparseEntry>& Entries);
+
+	SIZE_T GetAllocatedSize() const;
+
+	// 遍历每个变化的体素：Func(const FIntVector& GridCoord, const FFloat16Color& Old, const FFloat16Color& New)
+	template <typename FuncType>
+	void ForEachChanged(FuncType&& Func) const
+	{
+		const int32 SliceSize = RegionSize.X * RegionSize.Y;
+		int32 LinearIndex = 0;
+		int32 ValueIndex = 0;
+		for (const FRun& Run : Runs)
+		{
+			LinearIndex += Run.Skip;
+			for (int32 i = 0; i < Run.Count; i++, LinearIndex++, ValueIndex++)
+			{
+				const FIntVector Local(LinearIndex % RegionSize.X, (LinearIndex % SliceSize) / RegionSize.X, LinearIndex / SliceSize);
+				Func(RegionMin + Local, OldValues[ValueIndex], NewValues[ValueIndex]);
+			}
+		}
+	}
+};
+
+/**
+ * 切削增量的多消费者通道
+ * 每个切削器拥有自己的通道，只在游戏线程发布，因此是单生产者：每个订阅者一个 TQueue Spsc，
+ * 入队与 Dequeue 都不加锁，消费者按自己的节奏读取，互不阻塞。
+ * 增量记录以共享只读指针分发，多个订阅者之间不复制数据。
+ * 订阅者列表由读写锁保护：Publish 遍历列表时持有读锁，只有订阅/取消订阅 (很少发生) 时才有竞争。
+ */
+class SDFCUT_API FSDFCutDeltaChannel
+{
+public:
+	using FDeltaPtr = TSharedPtr<const FSDFCutDelta, ESPMode::ThreadSafe>;
+
+	class FSubscription
+	{
+	public:
+		// 取出下一条增量，队列为空时返回 false (只能由一个消费者线程调用)
+		bool Dequeue(FDeltaPtr& OutDelta) { return Queue.Dequeue(OutDelta); }
+
+		bool IsEmpty() const { return Queue.IsEmpty(); }
+
+	private:
+		friend class FSDFCutDeltaChannel;
+		TQueue<FDeltaPtr, EQueueMode::Spsc> Queue;
+	};
+
+	using FSubscriptionRef = TSharedRef<FSubscription, ESPMode::ThreadSafe>;
+
+	// 订阅：只会收到订阅之后发布的增量。订阅者释放引用后自动失效
+	FSubscriptionRef Subscribe();
+
+	void Unsubscribe(const FSubscriptionRef& Subscription);
+
+	// 是否有订阅者 (生产者据此决定是否需要构建增量)
+	bool HasSubscribers() const { return NumSubscribers.load(std::memory_order_relaxed) > 0; }
+
+	// 分配序号与时间戳后分发给所有订阅者，空增量不发布 (仅游戏线程)
+	void Publish(TSharedRef<FSDFCutDelta, ESPMode::ThreadSafe> Delta);
+
+	// 最近一次发布的序号
+	uint64 GetLastSequence() const { return LastSequence.load(std::memory_order_relaxed); }
+
+private:
+	// 清理已被释放的订阅者 (调用方持有写锁)
+	void PruneExpiredLocked();
+
+	mutable FRWLock SubscribersLock;
+	TArray<TWeakPtr<FSubscription, ESPMode::ThreadSafe>> Subscribers;
+	std::atomic<int32> NumSubscribers{0};
+	std::atomic<uint64> LastSequence{0};
+};
@@ -0,0 +1,84 @@
+// SDFDistancePyramid.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * CPU SDF 镜像的多分辨率保守距离金字塔
+ *
+ * 第 L 层的每个单元覆盖 (2 << L)^3 个体素，存储该单元内所有采样点 (含边界上与相邻单元共享的一层)
+ * 的 SDF 下界：
+ *   > 0  单元内所有采样点都在外部，值为最小距离
+ *   < 0  单元内所有采样点都在内部，值为 -最小|距离|
+ *   = 0  单元内有符号变化 (可能包含表面)
+ * 由于三线性插值只用到单元内的采样点，单元内任意位置的 SampleSDF 结果都满足同样的界。
+ * 坐标与 CPU_SDFData 一致：体素坐标，距离单位为 SDF 局部单位。
+ * 不加锁，调用方负责与 SDF 数据同步 (UGPUSDFCutter 在 DataRWLock 下维护)。
+ */
+class SDFCUT_API FSDFDistancePyramid
+{
+public:
+	// 全量构建 (Data 为 Z * Y * X 线性数组，R 通道为 SDF)
+	void Build(const TArray<FFloat16Color>& Data, const FIntVector& Dimensions);
+
+	// 体素区域 [RegionMin, RegionMin + RegionSize) 被修改后，只重建受影响的单元及其上层
+	void UpdateRegion(const TArray<FFloat16Color>& Data, const FIntVector& RegionMin, const FIntVector& RegionSize);
+
+	void Reset();
+
+	bool IsValid() const { return Levels.Num() > 0; }
+
+	int32 GetNumLevels() const { return Levels.Num(); }
+
+	// 单元边长 (体素)
+	static int32 GetCellSize(int32 Level) { return 2 << Level; }
+
+	/**
+	 * 点的 |SDF| 保守下界 (取所有层中最紧的一个)
+	 * 返回 0 表示附近可能有表面，需要精确采样
+	 */
+	float GetDistanceLowerBound(const FVector& VoxelCoord) const;
+
+	/**
+	 * 区域内是否所有采样点的 SDF 都大于 MinClearance (从粗到细逐层细分判断)
+	 * @param VoxelBox     体素空间的包围盒 (超出体积的部分按边界钳制)
+	 * @param MinClearance SDF 局部单位
+	 */
+	bool IsRegionClear(const FBox& VoxelBox, float MinClearance) const;
+
+	/**
+	 * 沿射线跳过不可能让 SDF 降到 MinClearance 以下的单元
+	 * 在最粗的满足条件的单元里直接跳到单元出口，否则原地返回，由调用方精细步进
+	 * @param Origin     射线起点 (体素坐标)
+	 * @param Direction  每单位 T 对应的体素坐标增量 (不要求归一化)
+	 * @param StartT     起始参数
+	 * @param EndT       最大参数
+	 * @return           第一个可能低于 MinClearance 的位置参数 (>= StartT)，一路畅通时返回 EndT
+	 */
+	float AdvanceRay(const FVector& Origin, const FVector& Direction, float StartT, float EndT, float MinClearance) const;
+
+private:
+	// 计算第 0 层单元的值 (直接读取 SDF 数据)
+	float ComputeBaseCell(const TArray<FFloat16Color>& Data, int32 CX, int32 CY, int32 CZ) const;
+
+	// 由下一层的 2x2x2 个子单元合并出第 Level 层单元的值
+	float ComputeParentCell(int32 Level, int32 CX, int32 CY, int32 CZ) const;
+
+	// 重建第 Level 层中 [CellMin, CellMax] (含) 范围内的单元
+	void RebuildCells(const TArray<FFloat16Color>* Data, int32 Level, const FIntVector& CellMin, const FIntVector& CellMax);
+
+	// 体素坐标所在单元 (钳制到有效范围)
+	FIntVector GetCellCoord(int32 Level, const FVector& VoxelCoord) const;
+
+	float GetCell(int32 Level, int32 CX, int32 CY, int32 CZ) const
+	{
+		const FIntVector& Dims = LevelDims[Level];
+		return Levels[Level][(CZ * Dims.Y + CY) * Dims.X + CX];
+	}
+
+	bool IsRegionClearRecursive(int32 Level, const FIntVector& CellMin, const FIntVector& CellMax, const FVector& BoxMin, const FVector& BoxMax, float MinClearance) const;
+
+	FIntVector Dimensions = FIntVector::ZeroValue;
+	TArray<FIntVector> LevelDims;
+	TArray<TArray<float>> Levels;
+};
@@ -0,0 +1,110 @@
+// SDFGridGenerator.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DynamicMesh/DynamicMesh3.h"
+#include "Spatial/FastWinding.h"
+
+/**
+ * 规则网格上的采样点定义：采样点 (X, Y, Z) 位于 Origin + (X, Y, Z) * Spacing
+ * 输出数组按 Z * (NX * NY) + Y * NX + X 线性排列 (与体积纹理一致)
+ */
+struct FSDFGridDesc
+{
+	FVector3d Origin = FVector3d::Zero();
+	FVector3d Spacing = FVector3d::One();
+	FIntVector Dimensions = FIntVector::ZeroValue;
+
+	int32 GetNumSamples() const { return Dimensions.X * Dimensions.Y * Dimensions.Z; }
+
+	FVector3d GetSamplePosition(int32 X, int32 Y, int32 Z) const
+	{
+		return Origin + FVector3d(X * Spacing.X, Y * Spacing.Y, Z * Spacing.Z);
+	}
+
+	bool IsValid() const
+	{
+		return Dimensions.X > 0 && Dimensions.Y > 0 && Dimensions.Z > 0 &&
+			Spacing.X > 0.0 && Spacing.Y > 0.0 && Spacing.Z > 0.0;
+	}
+};
+
+/**
+ * 网格 -> SDF 体积生成器 (窄带 + 快速扫描)
+ *
+ * 1. 窄带：每个三角形只在自身包围盒外扩 BandWidth 个采样点的范围内计算精确点-三角形距离，
+ *    同时记录最近三角形；按 Z 切片分桶，切片之间并行，无写冲突
+ * 2. 扫描：沿 X/Y/Z 轴逐行正反两遍，把相邻采样点的最近三角形传播过来并重新计算精确距离，
+ *    行与行之间并行
+ * 3. 符号：沿 X 轴整行做射线奇偶判断 (一行只需求一次与三角形的交点)，行与行之间并行；
+ *    射线碰到开放边界上的三角形、恰好擦过边/顶点或交点数为奇数的行，退回逐点 Fast Winding
+ *
+ * 相比逐采样点的 AABB 最近点查询，复杂度从 O(采样点 * log 三角形) 降到 O(窄带 + 采样点)，
+ * 窄带内的距离是精确的，窄带外是基于传播的最近三角形的距离 (误差通常远小于一个采样间距)。
+ */
+class SDFCUT_API FSDFGridGenerator
+{
+public:
+	struct FConfig
+	{
+		// 窄带半宽 (采样点个数)
+		int32 BandWidth = 2;
+
+		// 三轴扫描的轮数 (2 轮已足以覆盖对角方向的传播)
+		int32 NumSweepPasses = 2;
+
+		// 网格中没有任何三角形时 (或未被传播到) 的距离值
+		float FarValue = TNumericLimits<float>::Max();
+
+		bool bParallelCompute = true;
+
+		// true: 按行奇偶判断内外 (只对有问题的行使用 Fast Winding)；false: 每个采样点都用 Fast Winding
+		bool bUseScanlineParity = true;
+	};
+
+	// 与 Generate 的对比结果
+	struct FCompareResult
+	{
+		double FastSeconds = 0.0;
+		double ExactSeconds = 0.0;
+
+		// |Fast - Exact| 的最大值与平均值 (网格单位)
+		double MaxAbsError = 0.0;
+		double MeanAbsError = 0.0;
+
+		// 最大误差所在的采样点
+		FIntVector MaxErrorSample = FIntVector::ZeroValue;
+
+		// 内外判断不一致的采样点数
+		int32 SignMismatches = 0;
+	};
+
+	/**
+	 * 生成有符号距离 (内部为负)
+	 * @return 网格或网格描述无效时返回 false
+	 */
+	static bool Generate(const UE::Geometry::FDynamicMesh3& Mesh, const FSDFGridDesc& Grid, const FConfig& Config, TArray<float>& OutDistances);
+
+	/**
+	 * 参考实现：每个采样点一次 AABB 最近点查询 + 一次 Fast Winding 查询 (原有的做法)
+	 */
+	static bool GenerateExact(const UE::Geometry::FDynamicMesh3& Mesh, const FSDFGridDesc& Grid, float FarValue, TArray<float>& OutDistances);
+
+	/**
+	 * 分别运行 Generate 与 GenerateExact，统计耗时和误差
+	 */
+	static bool CompareWithExact(const UE::Geometry::FDynamicMesh3& Mesh, const FSDFGridDesc& Grid, const FConfig& Config, FCompareResult& OutResult);
+
+	/**
+	 * 计算每个采样点是否在网格内部 (见第 3 步)
+	 * @param ExistingWinding  调用方已有的 Fast Winding 树 (基于同一个 Mesh)，用于回退的行；为空时按需构建
+	 * @param OutNumFallbackRows  可选，输出回退到 Fast Winding 的行数
+	 */
+	static void ComputeInsideMask(const UE::Geometry::FDynamicMesh3& Mesh, const FSDFGridDesc& Grid, const FConfig& Config,
+		TArray<bool>& OutInside, const UE::Geometry::TFastWindingTree<UE::Geometry::FDynamicMesh3>* ExistingWinding = nullptr,
+		int32* OutNumFallbackRows = nullptr);
+
+private:
+	// 第 3 步：给无符号距离加上符号
+	static void ApplySigns(const UE::Geometry::FDynamicMesh3& Mesh, const FSDFGridDesc& Grid, const FConfig& Config, TArray<float>& InOutDistances);
+};
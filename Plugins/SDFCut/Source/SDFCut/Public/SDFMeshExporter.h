@@ -6,6 +6,9 @@
 #include "CoreMinimal.h"
 #include "DynamicMesh/DynamicMesh3.h"
 
+class FArchive;
+class FSDFStreamWriter;
+
 /**
  * Utility class for extracting meshes from SDF volumes and exporting to OBJ format.
  * Designed for runtime use - no editor dependencies.
@@ -27,6 +30,23 @@ public:
 
 		// Use parallel computation (recommended for large volumes)
 		bool bParallelCompute = true;
+
+		// When CubeSize matches VoxelSize, read voxels directly on the SDF grid instead of
+		// sampling a trilinear implicit function (same surface, much faster)
+		bool bAllowDirectGrid = true;
+
+		// Optional: polled during extraction, return true to abort (extraction then fails)
+		TFunction<bool()> CancelF;
+	};
+
+	/**
+	 * Output file formats supported by the streaming writer
+	 */
+	enum class EMeshFileFormat : uint8
+	{
+		OBJ,        // Text, positions/normals/colors
+		BinaryPLY,  // Binary little-endian PLY, positions/normals/colors
+		BinarySTL   // Binary STL, positions + face normals only
 	};
 
 	/**
@@ -42,6 +62,32 @@ public:
 
 		// Reverse winding order (UE uses left-handed, OBJ typically right-handed)
 		bool bReverseWinding = true;
+
+		// OBJ only: write triangle groups (e.g. per-material groups from dual contouring) as "g" sections
+		bool bWriteTriangleGroups = true;
+	};
+
+	/**
+	 * Configuration for dual contouring mesh extraction
+	 */
+	struct FDualContouringConfig
+	{
+		// Iso-surface level (typically 0.0 for SDF)
+		float IsoValue = 0.0f;
+
+		// Cell size in voxels. Edge crossings and normals are still located on the
+		// full-resolution grid, so sharp cut edges survive at coarser cell sizes.
+		int32 Stride = 1;
+
+		// Pull of each cell vertex towards the mass point of its edge crossings.
+		// Small values keep sharp features, larger values keep flat/degenerate cells stable.
+		float MassPointBias = 0.05f;
+
+		// Use parallel computation (recommended for large volumes)
+		bool bParallelCompute = true;
+
+		// Optional: polled during extraction, return true to abort (extraction then fails)
+		TFunction<bool()> CancelF;
 	};
 
 	/**
@@ -66,6 +112,111 @@ public:
 		TArray<int32>* OutMaterialIDs = nullptr
 	);
 
+	/**
+	 * Extract mesh from SDF volume into compact, welded buffers.
+	 * Vertices are numbered 0..N-1 by construction and referenced directly by OutTriangles,
+	 * so no vertex-ID remapping or second copy is needed. Arrays are caller-owned and reused.
+	 *
+	 * @param SDFData         Raw SDF data array (R=distance, G=materialID)
+	 * @param Dimensions      3D dimensions of the SDF volume
+	 * @param VoxelSize       Size of each voxel in local units
+	 * @param LocalBounds     Local space bounds of the volume
+	 * @param Config          Marching cubes configuration
+	 * @param OutPositions    Output vertex positions
+	 * @param OutTriangles    Output triangle indices (3 indices per triangle)
+	 * @param OutNormals      Output vertex normals (optional)
+	 * @param OutMaterialIDs  Output per-vertex material IDs (optional)
+	 * @return True if extraction succeeded
+	 */
+	static bool ExtractCompactMeshFromSDF(
+		const TArray<FFloat16Color>& SDFData,
+		const FIntVector& Dimensions,
+		float VoxelSize,
+		const FBox& LocalBounds,
+		const FMarchingCubesConfig& Config,
+		TArray<FVector>& OutPositions,
+		TArray<int32>& OutTriangles,
+		TArray<FVector>* OutNormals = nullptr,
+		TArray<int32>* OutMaterialIDs = nullptr
+	);
+
+	/**
+	 * Build an FDynamicMesh3 from compact buffers. Vertex IDs equal buffer indices,
+	 * so per-vertex arrays (material IDs, colors) stay valid for the mesh.
+	 */
+	static void CompactBuffersToDynamicMesh(
+		const TArray<FVector>& Positions,
+		const TArray<int32>& Triangles,
+		const TArray<FVector>* Normals,
+		UE::Geometry::FDynamicMesh3& OutMesh
+	);
+
+	/**
+	 * Copy an FDynamicMesh3 into compact buffers. Compact meshes (e.g. fresh extraction
+	 * results) are copied index-for-index; meshes with gaps go through a dense remap array.
+	 *
+	 * @param VertexMaterialIDs  Optional per-vertex-ID material IDs to carry over into OutMaterialIDs
+	 */
+	static void DynamicMeshToCompactBuffers(
+		const UE::Geometry::FDynamicMesh3& Mesh,
+		TArray<FVector>& OutPositions,
+		TArray<int32>& OutTriangles,
+		TArray<FVector>* OutNormals = nullptr,
+		const TArray<int32>* VertexMaterialIDs = nullptr,
+		TArray<int32>* OutMaterialIDs = nullptr
+	);
+
+	/**
+	 * Extract mesh from SDF volume using dual contouring.
+	 * One vertex per surface cell is placed by minimizing the distance to the tangent planes
+	 * of its edge crossings (QEF), which keeps sharp cut edges that marching cubes rounds off.
+	 * Each triangle's group is the material ID (G channel) of the voxel inside the surface, so
+	 * material boundaries follow mesh edges and the mesh carries per-material polygroups.
+	 *
+	 * @param SDFData         Raw SDF data array (R=distance, G=materialID)
+	 * @param Dimensions      3D dimensions of the SDF volume
+	 * @param VoxelSize       Size of each voxel in local units
+	 * @param LocalBounds     Local space bounds of the volume
+	 * @param Config          Dual contouring configuration
+	 * @param OutMesh         Output dynamic mesh (triangle groups = material IDs)
+	 * @param OutMaterialIDs  Output per-vertex material IDs (optional, majority of the cell's crossings)
+	 * @return True if extraction succeeded
+	 */
+	static bool ExtractMeshDualContouring(
+		const TArray<FFloat16Color>& SDFData,
+		const FIntVector& Dimensions,
+		float VoxelSize,
+		const FBox& LocalBounds,
+		const FDualContouringConfig& Config,
+		UE::Geometry::FDynamicMesh3& OutMesh,
+		TArray<int32>* OutMaterialIDs = nullptr
+	);
+
+	/**
+	 * Dual contouring over a dense float grid (X fastest, then Y, then Z).
+	 * Sample (X, Y, Z) is located at Origin + (X, Y, Z) * SampleSpacing.
+	 *
+	 * @param Values          Scalar field, inside where Value < IsoValue
+	 * @param Materials       Optional per-sample material IDs (empty = all triangles in group 0)
+	 * @param Dimensions      Grid dimensions
+	 * @param SampleSpacing   Distance between samples
+	 * @param Origin          Position of sample (0, 0, 0)
+	 * @param Config          Dual contouring configuration
+	 * @param OutMesh         Output dynamic mesh
+	 * @param OutMaterialIDs  Output per-vertex material IDs (optional)
+	 * @return True if extraction succeeded
+	 */
+	static bool DualContourGrid(
+		TArrayView<const float> Values,
+		TArrayView<const uint8> Materials,
+		const FIntVector& Dimensions,
+		double SampleSpacing,
+		const FVector3d& Origin,
+		const FDualContouringConfig& Config,
+		UE::Geometry::FDynamicMesh3& OutMesh,
+		TArray<int32>* OutMaterialIDs = nullptr
+	);
+
 	/**
 	 * Export FDynamicMesh3 to OBJ format string
 	 *
@@ -81,7 +232,7 @@ public:
 	);
 
 	/**
-	 * Write mesh directly to OBJ file
+	 * Write mesh directly to OBJ file (streamed, see WriteMeshToFile)
 	 *
 	 * @param Mesh            Input mesh
 	 * @param FilePath        Output file path
@@ -96,6 +247,48 @@ public:
 		const TArray<FLinearColor>* VertexColors = nullptr
 	);
 
+	/**
+	 * Stream mesh to a file in the given format.
+	 * Numbers are formatted into a fixed 64KB buffer that is flushed to the file archive,
+	 * so memory use does not grow with mesh size.
+	 *
+	 * @param Mesh            Input mesh
+	 * @param FilePath        Output file path
+	 * @param Format          Output format
+	 * @param Config          Export configuration (normals/colors/winding; STL ignores normals/colors)
+	 * @param VertexColors    Optional per-vertex colors
+	 * @return True if file was written successfully
+	 */
+	static bool WriteMeshToFile(
+		const UE::Geometry::FDynamicMesh3& Mesh,
+		const FString& FilePath,
+		EMeshFileFormat Format,
+		const FOBJExportConfig& Config,
+		const TArray<FLinearColor>* VertexColors = nullptr
+	);
+
+	/**
+	 * Stream mesh to an archive in the given format
+	 * @return True if no archive error occurred
+	 */
+	static bool WriteMeshToArchive(
+		const UE::Geometry::FDynamicMesh3& Mesh,
+		FArchive& Ar,
+		EMeshFileFormat Format,
+		const FOBJExportConfig& Config,
+		const TArray<FLinearColor>* VertexColors = nullptr
+	);
+
+	/**
+	 * Write the mesh once with each writer (legacy FString OBJ, streamed OBJ, binary PLY,
+	 * binary STL) into Directory and log size, time and MB/s for each.
+	 */
+	static void RunWriterBenchmark(
+		const UE::Geometry::FDynamicMesh3& Mesh,
+		const FString& Directory,
+		const TArray<FLinearColor>* VertexColors = nullptr
+	);
+
 	/**
 	 * Convert material IDs to vertex colors for visualization
 	 *
@@ -105,6 +298,23 @@ public:
 	static TArray<FLinearColor> MaterialIDsToColors(const TArray<int32>& MaterialIDs);
 
 private:
+	// Grid-aligned marching cubes: one vertex per voxel edge crossing, Z slabs extracted in parallel
+	// and written straight into the compact output buffers
+	static bool ExtractDirectGridCompact(
+		const TArray<FFloat16Color>& SDFData,
+		const FIntVector& Dimensions,
+		float VoxelSize,
+		const FBox& LocalBounds,
+		const FMarchingCubesConfig& Config,
+		TArray<FVector>& OutPositions,
+		TArray<int32>& OutTriangles,
+		TArray<FVector>* OutNormals,
+		TArray<int32>* OutMaterialIDs
+	);
+
+	// Helper: Dense vertex ID -> compact index map (INDEX_NONE for unused IDs)
+	static void BuildCompactVertexRemap(const UE::Geometry::FDynamicMesh3& Mesh, TArray<int32>& OutRemap);
+
 	// Helper: Sample SDF value at a position from the data array (trilinear interpolation)
 	static float SampleSDFValue(
 		const TArray<FFloat16Color>& SDFData,
@@ -114,4 +324,12 @@ private:
 
 	// Helper: Get voxel index from 3D coordinates
 	static int32 GetVoxelIndex(int32 X, int32 Y, int32 Z, const FIntVector& Dimensions);
+
+	// Streaming writers, one per format. Remap maps vertex ID -> compact index (-1 for gaps).
+	static void WriteOBJStream(FSDFStreamWriter& Writer, const UE::Geometry::FDynamicMesh3& Mesh, const TArray<int32>& Remap,
+		const FOBJExportConfig& Config, const TArray<FLinearColor>* VertexColors);
+	static void WritePLYStream(FSDFStreamWriter& Writer, const UE::Geometry::FDynamicMesh3& Mesh, const TArray<int32>& Remap,
+		const FOBJExportConfig& Config, const TArray<FLinearColor>* VertexColors);
+	static void WriteSTLStream(FSDFStreamWriter& Writer, const UE::Geometry::FDynamicMesh3& Mesh,
+		const FOBJExportConfig& Config);
 };
@@ -0,0 +1,91 @@
+// SDFToolLibrary.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SDFToolShape.h"
+#include <atomic>
+#include "SDFToolLibrary.generated.h"
+
+class UStaticMesh;
+class UVolumeTexture;
+
+/**
+ * 刀具库中的一把刀具
+ * Mesh 用于显示、触觉点壳采样以及 (非解析形状时) 生成网格 SDF；
+ * Shape 非空时切削使用解析 SDF，否则 GPUSDFCutter 使用 SDFTexture
+ */
+USTRUCT(BlueprintType)
+struct SDFCUT_API FSDFToolLibraryEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tool")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tool")
+	UStaticMesh* Mesh = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tool")
+	UVolumeTexture* SDFTexture = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tool")
+	FSDFToolShape Shape;
+
+	// 刀具局部空间包围盒 (解析形状优先，否则取网格包围盒)
+	FBox GetLocalBounds() const;
+};
+
+/**
+ * 常驻刀具库
+ *
+ * 所有刀具的 SDF (纹理或解析描述) 与触觉点壳在初始化时一次性准备好，
+ * 换刀只修改 ActiveToolIndex (原子变量)，可以在触觉线程调用，不加锁、不分配内存。
+ * 各使用方 (GPUSDFCutter / VoxelCutComponent / HapticProbeComponent) 在自己的线程上
+ * 发现索引变化后切换到预先准备好的数据。
+ * 当前刀具保存在资产上，由共享同一刀具库的使用方共同使用；使用方在 BeginPlay 时恢复为
+ * DefaultToolIndex，因此上一次 PIE 中的换刀不会带到下一次。
+ */
+UCLASS(BlueprintType)
+class SDFCUT_API USDFToolLibrary : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tool Library")
+	TArray<FSDFToolLibraryEntry> Tools;
+
+	// 加载后的初始刀具
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tool Library", meta = (ClampMin = "0"))
+	int32 DefaultToolIndex = 0;
+
+	virtual void PostLoad() override;
+
+	// 恢复为 DefaultToolIndex (游戏线程，使用方在 BeginPlay 时调用)
+	void ResetActiveTool();
+
+	int32 GetNumTools() const { return Tools.Num(); }
+
+	const FSDFToolLibraryEntry* GetTool(int32 Index) const { return Tools.IsValidIndex(Index) ? &Tools[Index] : nullptr; }
+
+	const FSDFToolLibraryEntry* GetActiveTool() const { return GetTool(GetActiveToolIndex()); }
+
+	// 当前刀具索引 (任意线程)
+	UFUNCTION(BlueprintPure, Category = "Tool Library")
+	int32 GetActiveToolIndex() const { return ActiveToolIndex.load(std::memory_order_acquire); }
+
+	// 换刀 (任意线程，包括触觉线程)，索引无效时返回 false
+	UFUNCTION(BlueprintCallable, Category = "Tool Library")
+	bool SetActiveToolIndex(int32 Index);
+
+	// 按名称换刀 (游戏线程)
+	UFUNCTION(BlueprintCallable, Category = "Tool Library")
+	bool SetActiveToolByName(FName Name);
+
+	// 所有网格 SDF 纹理是否已完全流式加载 (换刀前纹理必须常驻)
+	UFUNCTION(BlueprintPure, Category = "Tool Library")
+	bool AreToolTexturesResident() const;
+
+private:
+	std::atomic<int32> ActiveToolIndex{0};
+};
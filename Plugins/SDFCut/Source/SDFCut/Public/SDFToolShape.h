@@ -0,0 +1,230 @@
+// SDFToolShape.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include <type_traits>
+#include "SDFToolShape.generated.h"
+
+/**
+ * 解析刀具图元 (刀具局部空间，轴向为局部 Z 轴)
+ */
+UENUM(BlueprintType)
+enum class ESDFToolPrimitiveType : uint8
+{
+	Sphere,
+	Cylinder,
+	Cone,
+	Capsule
+};
+
+USTRUCT(BlueprintType)
+struct SDFCUT_API FSDFToolPrimitive
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tool Shape")
+	ESDFToolPrimitiveType Type = ESDFToolPrimitiveType::Sphere;
+
+	// 图元中心 (刀具局部空间)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tool Shape")
+	FVector Center = FVector::ZeroVector;
+
+	// 半径 (圆锥为 -Z 端的底面半径)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tool Shape", meta = (ClampMin = "0.0"))
+	float Radius = 1.0f;
+
+	// 沿局部 Z 轴的半长 (圆柱/圆锥/胶囊)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tool Shape", meta = (ClampMin = "0.0"))
+	float HalfHeight = 0.0f;
+
+	// 圆锥 +Z 端的顶面半径
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tool Shape", meta = (ClampMin = "0.0"))
+	float TipRadius = 0.0f;
+
+	FBox GetLocalBounds() const;
+};
+
+/**
+ * 切削核类型，与着色器排列 TOOL_SHAPE 的取值一致 (见 SDFToolShape.ush)
+ * 所有图元类型相同时使用对应的特化核，否则使用 Mixed (逐图元分支)
+ */
+enum class ESDFToolKernel : int32
+{
+	MeshTexture = 0,
+	Sphere,
+	Cylinder,
+	Cone,
+	Capsule,
+	Mixed,
+	Num
+};
+
+/**
+ * 刀具形状描述：若干解析图元的 (平滑) 并集
+ * 没有图元时表示使用网格生成的 SDF 纹理 (任意形状的回退路径)
+ */
+USTRUCT(BlueprintType)
+struct SDFCUT_API FSDFToolShape
+{
+	GENERATED_BODY()
+
+	// 着色器常量中图元数组的长度
+	static constexpr int32 MaxPrimitives = 4;
+
+	// 解析图元 (最多 MaxPrimitives 个，为空时使用网格 SDF 纹理)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tool Shape")
+	TArray<FSDFToolPrimitive> Primitives;
+
+	// 平滑并集半径 (0 = 硬并集)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tool Shape", meta = (ClampMin = "0.0"))
+	float SmoothRadius = 0.0f;
+
+	bool IsAnalytic() const { return Primitives.Num() > 0; }
+
+	int32 GetNumPrimitives() const { return FMath::Min(Primitives.Num(), MaxPrimitives); }
+
+	ESDFToolKernel GetKernel() const;
+
+	// 刀具局部空间包围盒 (含平滑并集的外扩)
+	FBox GetLocalBounds() const;
+
+	// 刀具局部空间的有符号距离 (按 GetKernel 分派到特化实现)
+	float Evaluate(const FVector3f& LocalPos) const;
+
+	/**
+	 * 写入着色器常量 (两个切削着色器的 Uniform Buffer 使用相同的成员名)
+	 * ToolPrimitiveA = (Center.xyz, Radius)，ToolPrimitiveB = (HalfHeight, TipRadius, Type, 0)
+	 */
+	template <typename UniformBufferType>
+	void SetShaderParameters(UniformBufferType& OutParameters) const
+	{
+		const int32 NumPrimitives = GetNumPrimitives();
+		for (int32 i = 0; i < MaxPrimitives; i++)
+		{
+			OutParameters.ToolPrimitiveA[i] = i < NumPrimitives ? GetPrimitiveA(Primitives[i]) : FVector4f::Zero();
+			OutParameters.ToolPrimitiveB[i] = i < NumPrimitives ? GetPrimitiveB(Primitives[i]) : FVector4f::Zero();
+		}
+		OutParameters.NumToolPrimitives = NumPrimitives;
+		OutParameters.ToolSmoothRadius = SmoothRadius;
+	}
+
+private:
+	static FVector4f GetPrimitiveA(const FSDFToolPrimitive& Primitive)
+	{
+		return FVector4f(FVector3f(Primitive.Center), Primitive.Radius);
+	}
+
+	static FVector4f GetPrimitiveB(const FSDFToolPrimitive& Primitive)
+	{
+		return FVector4f(Primitive.HalfHeight, Primitive.TipRadius, (float)(uint8)Primitive.Type, 0.0f);
+	}
+};
+
+namespace SDFToolShape
+{
+	// 多项式平滑并集
+	FORCEINLINE float SmoothUnion(float A, float B, float K)
+	{
+		if (K <= 0.0f)
+		{
+			return FMath::Min(A, B);
+		}
+		const float H = FMath::Clamp(0.5f + 0.5f * (B - A) / K, 0.0f, 1.0f);
+		return FMath::Lerp(B, A, H) - K * H * (1.0f - H);
+	}
+
+	FORCEINLINE float SphereSDF(const FVector3f& P, float Radius)
+	{
+		return P.Length() - Radius;
+	}
+
+	FORCEINLINE float CylinderSDF(const FVector3f& P, float Radius, float HalfHeight)
+	{
+		const FVector2f D(FVector2f(P.X, P.Y).Length() - Radius, FMath::Abs(P.Z) - HalfHeight);
+		return FMath::Min(FMath::Max(D.X, D.Y), 0.0f) + FVector2f(FMath::Max(D.X, 0.0f), FMath::Max(D.Y, 0.0f)).Length();
+	}
+
+	// 截头圆锥：-Z 端半径 Radius，+Z 端半径 TipRadius
+	FORCEINLINE float ConeSDF(const FVector3f& P, float Radius, float TipRadius, float HalfHeight)
+	{
+		const FVector2f Q(FVector2f(P.X, P.Y).Length(), P.Z);
+		const FVector2f K1(TipRadius, HalfHeight);
+		const FVector2f K2(TipRadius - Radius, 2.0f * HalfHeight);
+		const FVector2f CA(Q.X - FMath::Min(Q.X, Q.Y < 0.0f ? Radius : TipRadius), FMath::Abs(Q.Y) - HalfHeight);
+		const float T = FMath::Clamp(FVector2f::DotProduct(K1 - Q, K2) / FMath::Max(K2.SizeSquared(), UE_SMALL_NUMBER), 0.0f, 1.0f);
+		const FVector2f CB = Q - K1 + K2 * T;
+		const float Sign = (CB.X < 0.0f && CA.Y < 0.0f) ? -1.0f : 1.0f;
+		return Sign * FMath::Sqrt(FMath::Min(CA.SizeSquared(), CB.SizeSquared()));
+	}
+
+	FORCEINLINE float CapsuleSDF(FVector3f P, float Radius, float HalfHeight)
+	{
+		P.Z -= FMath::Clamp(P.Z, -HalfHeight, HalfHeight);
+		return P.Length() - Radius;
+	}
+
+	// 单个图元，Kernel 为编译期常量 (Mixed 时按图元类型运行期分支)
+	template <ESDFToolKernel Kernel>
+	FORCEINLINE float EvaluatePrimitive(const FSDFToolPrimitive& Primitive, const FVector3f& LocalPos)
+	{
+		const FVector3f P = LocalPos - FVector3f(Primitive.Center);
+
+		if constexpr (Kernel == ESDFToolKernel::Sphere)
+		{
+			return SphereSDF(P, Primitive.Radius);
+		}
+		else if constexpr (Kernel == ESDFToolKernel::Cylinder)
+		{
+			return CylinderSDF(P, Primitive.Radius, Primitive.HalfHeight);
+		}
+		else if constexpr (Kernel == ESDFToolKernel::Cone)
+		{
+			return ConeSDF(P, Primitive.Radius, Primitive.TipRadius, Primitive.HalfHeight);
+		}
+		else if constexpr (Kernel == ESDFToolKernel::Capsule)
+		{
+			return CapsuleSDF(P, Primitive.Radius, Primitive.HalfHeight);
+		}
+		else
+		{
+			switch (Primitive.Type)
+			{
+			case ESDFToolPrimitiveType::Cylinder: return CylinderSDF(P, Primitive.Radius, Primitive.HalfHeight);
+			case ESDFToolPrimitiveType::Cone:     return ConeSDF(P, Primitive.Radius, Primitive.TipRadius, Primitive.HalfHeight);
+			case ESDFToolPrimitiveType::Capsule:  return CapsuleSDF(P, Primitive.Radius, Primitive.HalfHeight);
+			default:                              return SphereSDF(P, Primitive.Radius);
+			}
+		}
+	}
+
+	template <ESDFToolKernel Kernel>
+	FORCEINLINE float Evaluate(const FSDFToolShape& Shape, const FVector3f& LocalPos)
+	{
+		const int32 NumPrimitives = Shape.GetNumPrimitives();
+		float Distance = EvaluatePrimitive<Kernel>(Shape.Primitives[0], LocalPos);
+		for (int32 i = 1; i < NumPrimitives; i++)
+		{
+			Distance = SmoothUnion(Distance, EvaluatePrimitive<Kernel>(Shape.Primitives[i], LocalPos), Shape.SmoothRadius);
+		}
+		return Distance;
+	}
+
+	/**
+	 * 把运行期的核类型分派到编译期常量，用于在整个切削循环外只分支一次：
+	 * DispatchKernel(Shape.GetKernel(), [&](auto KernelTag) { constexpr ESDFToolKernel K = decltype(KernelTag)::value; ... });
+	 * MeshTexture 没有解析核，调用方需先检查 IsAnalytic
+	 */
+	template <typename FuncType>
+	FORCEINLINE void DispatchKernel(ESDFToolKernel Kernel, FuncType&& Func)
+	{
+		switch (Kernel)
+		{
+		case ESDFToolKernel::Sphere:   Func(std::integral_constant<ESDFToolKernel, ESDFToolKernel::Sphere>()); break;
+		case ESDFToolKernel::Cylinder: Func(std::integral_constant<ESDFToolKernel, ESDFToolKernel::Cylinder>()); break;
+		case ESDFToolKernel::Cone:     Func(std::integral_constant<ESDFToolKernel, ESDFToolKernel::Cone>()); break;
+		case ESDFToolKernel::Capsule:  Func(std::integral_constant<ESDFToolKernel, ESDFToolKernel::Capsule>()); break;
+		case ESDFToolKernel::Mixed:    Func(std::integral_constant<ESDFToolKernel, ESDFToolKernel::Mixed>()); break;
+		default: break;
+		}
+	}
+}
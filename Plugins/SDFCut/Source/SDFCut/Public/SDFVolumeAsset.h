@@ -0,0 +1,89 @@
+// SDFVolumeAsset.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Serialization/BulkData.h"
+#include "SDFVolumeAsset.generated.h"
+
+/**
+ * 分块压缩的 SDF 体数据资产 (RGBA16F：R = 距离，G = 材质 ID，与 OriginalSDFTexture 的格式相同)
+ *
+ * 体数据按 BrickSize^3 分块 (X 最快)：
+ *  - 所有体素完全相同的块 (远离表面、距离被截断的内部/外部区域) 只在块表中保存一个值
+ *  - 其余块各自独立压缩 (LZ4 / Oodle)，因此可以并行解压
+ * 运行时直接解压到切削器的 CPU 镜像，再从镜像分块上传到 GPU 体纹理，
+ * 不需要 UVolumeTexture 的平台数据，也没有完整体数据的中间拷贝。
+ */
+UCLASS(BlueprintType)
+class SDFCUT_API USDFVolumeAsset : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// 体数据尺寸 (体素)
+	UPROPERTY(VisibleAnywhere, Category = "SDF Volume")
+	FIntVector Dimensions = FIntVector::ZeroValue;
+
+	// 块边长 (体素)
+	UPROPERTY(VisibleAnywhere, Category = "SDF Volume")
+	int32 BrickSize = 16;
+
+	// 压缩格式 (NAME_LZ4 / NAME_Oodle)
+	UPROPERTY(VisibleAnywhere, Category = "SDF Volume")
+	FName CompressionFormat = NAME_LZ4;
+
+	// 被省略的均匀块数量 (仅用于显示)
+	UPROPERTY(VisibleAnywhere, Category = "SDF Volume")
+	int32 NumUniformBricks = 0;
+
+	// 压缩后负载大小 (字节，仅用于显示)
+	UPROPERTY(VisibleAnywhere, Category = "SDF Volume")
+	int64 CompressedSize = 0;
+
+	/**
+	 * 由线性体数据 (Z * Y * X) 构建，按块并行压缩
+	 * @param FarDistance  > 0 时先把 |R| 截断到该值 (体素单位同 R 通道)，远场块因此变为均匀块；0 为不截断
+	 */
+	bool Build(const FIntVector& InDimensions, const FFloat16Color* Voxels, FName InCompressionFormat = NAME_LZ4, float FarDistance = 0.0f);
+
+	/**
+	 * 并行解压到线性体数据 (Z * Y * X)，OutVoxels 会被调整为 Dimensions 的体素数
+	 * 非编辑器下解压后释放压缩负载的内存 (需要时会从磁盘重新读取)
+	 */
+	bool DecompressTo(TArray<FFloat16Color>& OutVoxels);
+
+	bool IsValid() const { return Dimensions.X > 0 && Dimensions.Y > 0 && Dimensions.Z > 0 && Bricks.Num() == GetNumBricks().X * GetNumBricks().Y * GetNumBricks().Z; }
+
+	// 各轴的块数量
+	FIntVector GetNumBricks() const;
+
+	// 未压缩体数据大小 (字节)
+	int64 GetUncompressedSize() const { return (int64)Dimensions.X * Dimensions.Y * Dimensions.Z * sizeof(FFloat16Color); }
+
+	virtual void Serialize(FArchive& Ar) override;
+
+private:
+	// 块表，CompressedBytes == 0 表示均匀块 (值为 UniformValue)
+	struct FBrick
+	{
+		uint32 Offset = 0;
+		uint32 CompressedBytes = 0;
+		FFloat16Color UniformValue;
+
+		friend FArchive& operator<<(FArchive& Ar, FBrick& Brick)
+		{
+			Ar << Brick.Offset << Brick.CompressedBytes;
+			Ar << Brick.UniformValue.R << Brick.UniformValue.G << Brick.UniformValue.B << Brick.UniformValue.A;
+			return Ar;
+		}
+	};
+
+	TArray<FBrick> Bricks;
+
+	// 所有非均匀块的压缩数据，按块表顺序拼接
+	FByteBulkData Payload;
+
+	// 块在体数据中的起点与 (边界处裁剪后的) 尺寸
+	void GetBrickRegion(int32 BrickIndex, FIntVector& OutMin, FIntVector& OutSize) const;
+};
@@ -3,6 +3,20 @@
 
 #include "CoreMinimal.h"
 
+// 牙齿材质类型
+enum EVolumeMaterial
+{
+	Enamel=0, // 牙釉质
+	Dentin=1, // 牙本质
+	Caries=2, // 龋坏部分
+	Fill=3   //  金属填充物
+};
+
+// 材质数量，用于按 EVolumeMaterial 索引的定长查找表
+constexpr int32 NumVolumeMaterials = Fill + 1;
+
+class FSDFDistancePyramid;
+
 /** 
  * 纯C++接口，用于高性能SDF查询 
  * 避免使用 UInterface 带来的 Cast 开销
@@ -21,9 +35,21 @@ public:
 	// 采样 材质 ID
 	virtual int32 SampleMaterialID(const FVector& VoxelCoord) const = 0;
 
+	// 一次读取同时得到 SDF (Trilinear) 和材质 ID (最近邻)，复用同一组角点
+	virtual float SampleSDFAndMaterial(const FVector& VoxelCoord, int32& OutMaterialID) const = 0;
+
 	// 获取体素尺寸 (用于深度计算)
 	virtual float GetVoxelSize() const = 0;
 
+	// 世界距离 -> SDF 距离的换算系数 (SDF 存储在目标网格局部空间，取最保守的缩放轴)
+	virtual float GetWorldToSDFScale() const = 0;
+
+	// SDF 所在局部空间 -> 世界空间的变换 (用于梯度方向转换、相对位姿计算)
+	virtual FTransform GetLocalToWorldTransform() const = 0;
+
+	// 保守距离金字塔 (用于射线大步跳跃、粗检测)，需在持有读锁时使用；不提供时返回 nullptr
+	virtual const FSDFDistancePyramid* GetDistancePyramid() const { return nullptr; }
+
 	// 获取读写锁 (用于线程安全)
 	virtual FRWLock& GetDataLock() = 0;
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "GlobalShader.h"
 #include "ShaderParameterStruct.h"
 #include "RenderGraphResources.h"
+#include "SDFToolShape.h"
 
 // 局部更新参数
 BEGIN_UNIFORM_BUFFER_STRUCT(FCutUB, )
@@ -21,6 +22,12 @@ BEGIN_UNIFORM_BUFFER_STRUCT(FCutUB, )
 	// 更新区域（物体局部坐标系的体素范围）
 	SHADER_PARAMETER(FIntVector, UpdateRegionMin)
 	SHADER_PARAMETER(FIntVector, UpdateRegionMax)
+
+	// 解析刀具图元 (TOOL_SHAPE != 0 时使用，见 FSDFToolShape::SetShaderParameters)
+	SHADER_PARAMETER_ARRAY(FVector4f, ToolPrimitiveA, [FSDFToolShape::MaxPrimitives])
+	SHADER_PARAMETER_ARRAY(FVector4f, ToolPrimitiveB, [FSDFToolShape::MaxPrimitives])
+	SHADER_PARAMETER(int32, NumToolPrimitives)
+	SHADER_PARAMETER(float, ToolSmoothRadius)
 END_UNIFORM_BUFFER_STRUCT()
 
 // Compute Shader声明
@@ -30,6 +37,10 @@ public:
 	DECLARE_GLOBAL_SHADER(FUpdateSDFCS);
 	SHADER_USE_PARAMETER_STRUCT(FUpdateSDFCS, FGlobalShader);
 
+	// 刀具形状排列 (取值为 ESDFToolKernel)
+	class FToolShapeDim : SHADER_PERMUTATION_INT("TOOL_SHAPE", (int32)ESDFToolKernel::Num);
+	using FPermutationDomain = TShaderPermutationDomain<FToolShapeDim>;
+
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
 		SHADER_PARAMETER_RDG_UNIFORM_BUFFER(FCutUB, Params)
 		SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture3D<float>, InputSDF)
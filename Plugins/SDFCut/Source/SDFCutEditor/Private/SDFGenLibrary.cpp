@@ -4,11 +4,107 @@
 #include "SDFGenLibrary.h"
 #include "MeshDescriptionToDynamicMesh.h"
 #include "AssetRegistry/AssetRegistryModule.h"
-#include "DynamicMesh/DynamicMeshAABBTree3.h"
-#include "Spatial/FastWinding.h"
+#include "SDFGridGenerator.h"
+#include "SDFVolumeAsset.h"
 
 using namespace UE::Geometry;
 
+namespace SDFGenLibraryPrivate
+{
+    // StaticMesh LOD0 -> DynamicMesh3
+    static bool ConvertStaticMesh(UStaticMesh* InputMesh, FDynamicMesh3& OutMesh)
+    {
+        // 获取 LOD 0 的 MeshDescription
+        const FMeshDescription* MeshDesc = InputMesh->GetMeshDescription(0);
+        if (!MeshDesc)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Cannot get MeshDescription from StaticMesh. Ensure 'Allow CPU Access' is on if shipping."));
+            return false;
+        }
+
+        FMeshDescriptionToDynamicMesh Converter;
+        Converter.Convert(MeshDesc, OutMesh);
+        return true;
+    }
+
+    // 包围盒 -> 立方体包围盒上的采样网格 (采样点位于体素中心)
+    static bool MakeCubicGrid(const FBox& Bounds, int32 ResolutionXY, int32 Slices, float BoundsScale, FSDFGridDesc& OutGrid)
+    {
+        FVector Center = Bounds.GetCenter();
+        FVector OriginalExtent = Bounds.GetExtent();
+
+        double MaxHalfSize = OriginalExtent.GetMax();
+        FVector CubicExtent = FVector(MaxHalfSize) * BoundsScale;
+
+        FVector MinPos = Center - CubicExtent;
+        FVector Size = CubicExtent * 2.0f;
+
+        FVector VoxelSize;
+        VoxelSize.X = Size.X / (float)ResolutionXY;
+        VoxelSize.Y = Size.Y / (float)ResolutionXY;
+        VoxelSize.Z = Size.Z / (float)Slices;
+
+        OutGrid.Origin = MinPos + VoxelSize * 0.5;
+        OutGrid.Spacing = VoxelSize;
+        OutGrid.Dimensions = FIntVector(ResolutionXY, ResolutionXY, Slices);
+        return OutGrid.IsValid();
+    }
+
+    // StaticMesh LOD0 -> DynamicMesh3，并计算网格包围盒上的采样网格
+    static bool BuildMeshAndGrid(UStaticMesh* InputMesh, int32 ResolutionXY, int32 Slices, float BoundsScale,
+        FDynamicMesh3& OutMesh, FSDFGridDesc& OutGrid)
+    {
+        return ConvertStaticMesh(InputMesh, OutMesh) && MakeCubicGrid(InputMesh->GetBoundingBox(), ResolutionXY, Slices, BoundsScale, OutGrid);
+    }
+
+    // 创建 (或覆盖) RGBA16F 体积纹理资源，R = 距离，G = 材质 ID
+    static UVolumeTexture* CreateVolumeTextureAsset(const FString& PackagePath, const FString& AssetName,
+        int32 ResolutionXY, int32 Slices, const TArray<FFloat16Color>& RawSDFData)
+    {
+        FString VolAssetName = AssetName;
+        if (!VolAssetName.EndsWith(TEXT("_Vol")))
+        {
+            VolAssetName += TEXT("_Vol");
+        }
+
+        FString VolPackageName = PackagePath + VolAssetName;
+
+        // 检查是否已经存在一个不同类型的资产 (防止 Crash)
+        UObject* ExistingObject = StaticFindObject(UObject::StaticClass(), nullptr, *VolPackageName);
+        if (ExistingObject && ExistingObject->GetClass() != UVolumeTexture::StaticClass())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Name collision detected! Appending GUID to avoid crash."));
+            VolAssetName += TEXT("_") + FGuid::NewGuid().ToString().Left(4);
+            VolPackageName = PackagePath + VolAssetName;
+        }
+
+        UPackage* Package = CreatePackage(*VolPackageName);
+        Package->FullyLoad();
+
+        UVolumeTexture* NewTexture = NewObject<UVolumeTexture>(Package, *VolAssetName, RF_Public | RF_Standalone | RF_MarkAsRootSet);
+        
+        // 设置纹理属性
+        NewTexture->Source.Init(ResolutionXY, ResolutionXY, Slices, 1, ETextureSourceFormat::TSF_RGBA16F);
+        NewTexture->SRGB = false;
+        NewTexture->CompressionSettings = TC_HDR; // 高精度
+        NewTexture->MipGenSettings = TMGS_NoMipmaps; // 通常SDF不需要Mipmap，或者根据需求开启
+        NewTexture->Filter = TF_Trilinear;
+
+        // 填充纹理数据
+        uint8* MipData = NewTexture->Source.LockMip(0);
+        // TSF_R32F 对应 float，直接内存拷贝
+        FMemory::Memcpy(MipData, RawSDFData.GetData(), RawSDFData.Num() * sizeof(FFloat16Color));
+        NewTexture->Source.UnlockMip(0);
+
+        // 更新资源并保存
+        NewTexture->UpdateResource();
+        Package->MarkPackageDirty();
+        FAssetRegistryModule::AssetCreated(NewTexture);
+
+        return NewTexture;
+    }
+}
+
 UVolumeTexture* USDFGenLibrary::GenerateSDFFromStaticMesh(UStaticMesh* InputMesh, FString PackagePath,
                                                           FString AssetName, int32 ResolutionXY, int32 Slices, float BoundsScale,int32 MaterialID, bool bGenerate2D)
 {
@@ -28,130 +124,42 @@ UVolumeTexture* USDFGenLibrary::GenerateSDFFromStaticMesh(UStaticMesh* InputMesh
         PackagePath += TEXT("/");
     }
 
-    // 1. 获取 MeshDescription 并转换为 DynamicMesh3
+    // 1~3. 转换网格并计算体素网格参数
     // -----------------------------------------------------------------------
     UE::Geometry::FDynamicMesh3 DynMesh;
-    FMeshDescriptionToDynamicMesh Converter;
-    
-    // 获取 LOD 0 的 MeshDescription
-    const FMeshDescription* MeshDesc = InputMesh->GetMeshDescription(0);
-    if (!MeshDesc)
+    FSDFGridDesc Grid;
+    if (!SDFGenLibraryPrivate::BuildMeshAndGrid(InputMesh, ResolutionXY, Slices, BoundsScale, DynMesh, Grid))
     {
-        UE_LOG(LogTemp, Error, TEXT("Cannot get MeshDescription from StaticMesh. Ensure 'Allow CPU Access' is on if shipping."));
         return nullptr;
     }
 
-    Converter.Convert(MeshDesc, DynMesh);
-
-    // 2. 构建空间查询结构 (AABB Tree 和 Winding Number Engine)
-    // -----------------------------------------------------------------------
-    // AABB Tree 用于快速查找最近点距离
-    FDynamicMeshAABBTree3 AABBTree(&DynMesh);
-
-    TFastWindingTree<FDynamicMesh3> FastWinding(&AABBTree);
-
-
-    // 3. 计算体素网格参数
+    // 4. 计算 SDF (窄带 + 快速扫描，见 FSDFGridGenerator)
     // -----------------------------------------------------------------------
-    FBox Bounds = InputMesh->GetBoundingBox();
-    FVector Center = Bounds.GetCenter();
-    FVector OriginalExtent = Bounds.GetExtent();
-
-    double MaxHalfSize = OriginalExtent.GetMax();
-    FVector CubicExtent = FVector(MaxHalfSize) * BoundsScale;
-
-    FVector MinPos = Center - CubicExtent;
-    FVector Size = CubicExtent * 2.0f;
-
-    FVector VoxelSize;
-    VoxelSize.X = Size.X / (float)ResolutionXY;
-    VoxelSize.Y = Size.Y / (float)ResolutionXY;
-    VoxelSize.Z = Size.Z / (float)Slices;
+    TArray<float> Distances;
+    if (!FSDFGridGenerator::Generate(DynMesh, Grid, FSDFGridGenerator::FConfig(), Distances))
+    {
+        UE_LOG(LogTemp, Error, TEXT("SDF generation failed (mesh has no triangles?)"));
+        return nullptr;
+    }
 
-    int32 TotalVoxels = ResolutionXY * ResolutionXY * Slices;
+    const int32 TotalVoxels = Distances.Num();
     TArray<FFloat16Color> RawSDFData;
     RawSDFData.SetNumUninitialized(TotalVoxels);
 
-    // 4. 并行计算 SDF
-    // -----------------------------------------------------------------------
     ParallelFor(TotalVoxels, [&](int32 Index)
     {
-        // 将 1D Index 转换为 3D 坐标索引
-        int32 Z = Index / (ResolutionXY * ResolutionXY);
-        int32 Temp = Index % (ResolutionXY * ResolutionXY);
-        int32 Y = Temp / ResolutionXY;
-        int32 X = Temp % ResolutionXY;
-
-        // 计算当前体素在世界空间的位置 (采样中心点)
-        FVector3d SamplePos;
-        SamplePos.X = MinPos.X + (X + 0.5) * VoxelSize.X;
-        SamplePos.Y = MinPos.Y + (Y + 0.5) * VoxelSize.Y;
-        SamplePos.Z = MinPos.Z + (Z + 0.5) * VoxelSize.Z;
-
-        // 1. 计算距离平方
-        FVector3d NearestSurfPoint  = AABBTree.FindNearestPoint(SamplePos);
-        // FVector3d 支持直接相减和 SquaredLength()
-       double DistSq = (SamplePos - NearestSurfPoint).SquaredLength();
-       float Distance = (float)FMath::Sqrt(DistSq);
-
-        // 2. 计算 Winding Number (判断内外)
-        bool bIsInside = FastWinding.IsInside(SamplePos);
-
         // SDF 定义: 内部为负，外部为正
-        if (bIsInside)
-        {
-            Distance *= -1.0f;
-        }
-        
+        const float Distance = Distances[Index];
+        const bool bIsInside = Distance < 0.0f;
         float VoxelMatID = bIsInside ? (float)MaterialID : 0.0f; 
 
         // 存储数据
         RawSDFData[Index] = FFloat16Color(FLinearColor(Distance, VoxelMatID, 0.0f, 1.0f));
     });
 
-    // 5. 创建 Volume Texture 资源
-    // -----------------------------------------------------------------------
-    FString VolAssetName = AssetName;
-    if (!VolAssetName.EndsWith(TEXT("_Vol")))
-    {
-        VolAssetName += TEXT("_Vol");
-    }
-
-    FString VolPackageName = PackagePath + VolAssetName;
-
-    // 检查是否已经存在一个不同类型的资产 (防止 Crash)
-    UObject* ExistingObject = StaticFindObject(UObject::StaticClass(), nullptr, *VolPackageName);
-    if (ExistingObject && ExistingObject->GetClass() != UVolumeTexture::StaticClass())
-    {
-        UE_LOG(LogTemp, Warning, TEXT("Name collision detected! Appending GUID to avoid crash."));
-        VolAssetName += TEXT("_") + FGuid::NewGuid().ToString().Left(4);
-        VolPackageName = PackagePath + VolAssetName;
-    }
-
-    UPackage* Package = CreatePackage(*VolPackageName);
-    Package->FullyLoad();
-
-    UVolumeTexture* NewTexture = NewObject<UVolumeTexture>(Package, *VolAssetName, RF_Public | RF_Standalone | RF_MarkAsRootSet);
-    
-    // 设置纹理属性
-    NewTexture->Source.Init(ResolutionXY, ResolutionXY, Slices, 1, ETextureSourceFormat::TSF_RGBA16F);
-    NewTexture->SRGB = false;
-    NewTexture->CompressionSettings = TC_HDR; // 高精度
-    NewTexture->MipGenSettings = TMGS_NoMipmaps; // 通常SDF不需要Mipmap，或者根据需求开启
-    NewTexture->Filter = TF_Trilinear;
-
-    // 6. 填充纹理数据
-    // -----------------------------------------------------------------------
-    uint8* MipData = NewTexture->Source.LockMip(0);
-    // TSF_R32F 对应 float，直接内存拷贝
-    FMemory::Memcpy(MipData, RawSDFData.GetData(), RawSDFData.Num() * sizeof(FFloat16Color));
-    NewTexture->Source.UnlockMip(0);
-
-    // 7. 更新资源并保存
+    // 5~7. 创建 Volume Texture 资源，填充数据并保存
     // -----------------------------------------------------------------------
-    NewTexture->UpdateResource();
-    Package->MarkPackageDirty();
-    FAssetRegistryModule::AssetCreated(NewTexture);
+    UVolumeTexture* NewTexture = SDFGenLibraryPrivate::CreateVolumeTextureAsset(PackagePath, AssetName, ResolutionXY, Slices, RawSDFData);
 
     // =========================================================
     // 6. 保存 2D Texture Atlas (POT 修正版)
@@ -256,182 +264,652 @@ UVolumeTexture* USDFGenLibrary::GenerateSDFFromStaticMesh(UStaticMesh* InputMesh
 }
 
 
-void USDFGenLibrary::BakeBrushToVolume(UObject* WorldContextObject, UVolumeTexture* TargetTexture, AActor* VolumeActor, AActor* BrushActor, int32 MaterialID, bool bErase)
+UVolumeTexture* USDFGenLibrary::GenerateLayeredSDF(const TArray<FSDFBakeLayer>& Layers, FString PackagePath, FString AssetName,
+                                                   int32 ResolutionXY, int32 Slices, float BoundsScale)
 {
-    if (!TargetTexture || !VolumeActor || !BrushActor) return;
-    UWorld* World = WorldContextObject->GetWorld();
-    if (!World) return;
+    if (Layers.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("GenerateLayeredSDF: no layers"));
+        return nullptr;
+    }
+    if (AssetName.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("AssetName is null!"));
+        return nullptr;
+    }
+    if (!PackagePath.EndsWith(TEXT("/")))
+    {
+        PackagePath += TEXT("/");
+    }
 
-    UStaticMeshComponent* VolMeshComp = VolumeActor->FindComponentByClass<UStaticMeshComponent>();
-    if (!VolMeshComp || !VolMeshComp->GetStaticMesh()) return;
+    const double StartTime = FPlatformTime::Seconds();
 
-    // --- 1. 准备空间数据 ---
-    FBox MeshLocalBounds = VolMeshComp->GetStaticMesh()->GetBoundingBox();
-    FVector LocalMin = MeshLocalBounds.Min;
-    FVector LocalSize = MeshLocalBounds.GetSize();
-    
-    LocalSize.X = FMath::Max(LocalSize.X, 1.0f);
-    LocalSize.Y = FMath::Max(LocalSize.Y, 1.0f);
-    LocalSize.Z = FMath::Max(LocalSize.Z, 1.0f);
+    // 1. 转换每一层的网格到体积空间，合并包围盒
+    // -----------------------------------------------------------------------
+    const int32 NumLayers = Layers.Num();
+    TArray<FDynamicMesh3> LayerMeshes;
+    LayerMeshes.SetNum(NumLayers);
+    FBox Bounds(ForceInit);
+    bool bHasDistanceLayer = false;
 
-    FTransform VolLocalToWorld = VolMeshComp->GetComponentTransform();
-    FTransform VolWorldToLocal = VolLocalToWorld.Inverse();
-    
-    FBox BrushWorldBox = BrushActor->GetComponentsBoundingBox();
-    FBox BrushLocalBox = BrushWorldBox.TransformBy(VolWorldToLocal);
+    for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+    {
+        const FSDFBakeLayer& Layer = Layers[LayerIndex];
+        if (!Layer.Mesh)
+        {
+            UE_LOG(LogTemp, Error, TEXT("GenerateLayeredSDF: layer %d has no mesh"), LayerIndex);
+            return nullptr;
+        }
 
-    FVector UVMin = (BrushLocalBox.Min - LocalMin) / LocalSize;
-    FVector UVMax = (BrushLocalBox.Max - LocalMin) / LocalSize;
+        FDynamicMesh3& Mesh = LayerMeshes[LayerIndex];
+        if (!SDFGenLibraryPrivate::ConvertStaticMesh(Layer.Mesh, Mesh))
+        {
+            return nullptr;
+        }
 
-    int32 SizeX = TargetTexture->GetSizeX();
-    int32 SizeY = TargetTexture->GetSizeY();
-    int32 SizeZ = TargetTexture->GetSizeZ();
+        if (!Layer.Transform.Equals(FTransform::Identity))
+        {
+            for (int32 VertexID : Mesh.VertexIndicesItr())
+            {
+                Mesh.SetVertex(VertexID, Layer.Transform.TransformPosition(Mesh.GetVertex(VertexID)));
+            }
+            // 镜像变换会翻转三角形朝向，Winding 的符号随之取反
+            if (Layer.Transform.GetDeterminant() < 0.0f)
+            {
+                Mesh.ReverseOrientation(false);
+            }
+        }
 
-    int32 StartX = FMath::Clamp(FMath::FloorToInt(UVMin.X * SizeX), 0, SizeX - 1);
-    int32 EndX   = FMath::Clamp(FMath::CeilToInt(UVMax.X * SizeX), 0, SizeX - 1);
-    int32 StartY = FMath::Clamp(FMath::FloorToInt(UVMin.Y * SizeY), 0, SizeY - 1);
-    int32 EndY   = FMath::Clamp(FMath::CeilToInt(UVMax.Y * SizeY), 0, SizeY - 1);
-    int32 StartZ = FMath::Clamp(FMath::FloorToInt(UVMin.Z * SizeZ), 0, SizeZ - 1);
-    int32 EndZ   = FMath::Clamp(FMath::CeilToInt(UVMax.Z * SizeZ), 0, SizeZ - 1);
+        const FAxisAlignedBox3d MeshBounds = Mesh.GetBounds();
+        Bounds += FBox(MeshBounds.Min, MeshBounds.Max);
+        bHasDistanceLayer |= Layer.bContributesToDistance;
+    }
 
-    if (StartX > EndX || StartY > EndY || StartZ > EndZ) return;
+    if (!bHasDistanceLayer)
+    {
+        UE_LOG(LogTemp, Error, TEXT("GenerateLayeredSDF: at least one layer must contribute to the distance channel"));
+        return nullptr;
+    }
 
-    // --- 2. 计算平滑参数 ---
-    FVector VoxelSizeWorldVec = VolLocalToWorld.TransformVector(LocalSize / FVector(SizeX, SizeY, SizeZ));
-    float AvgVoxelSize = VoxelSizeWorldVec.GetAbs().GetMax(); 
-    
-    // 保持 1.5 到 2.0 的平滑半径，配合法线修正后效果会非常均匀
-    float SmoothWorldRadius = AvgVoxelSize * 1.5f; 
+    FSDFGridDesc Grid;
+    if (!SDFGenLibraryPrivate::MakeCubicGrid(Bounds, ResolutionXY, Slices, BoundsScale, Grid))
+    {
+        return nullptr;
+    }
 
-    // --- 3. 锁定内存 ---
-    FFloat16Color* MipDataF16 = (FFloat16Color*)TargetTexture->Source.LockMip(0);
-    if (!MipDataF16) return;
+    // 2. 每层一次距离场计算 (每层只构建一次加速结构，层内并行)
+    // -----------------------------------------------------------------------
+    TArray<TArray<float>> LayerDistances;
+    LayerDistances.SetNum(NumLayers);
+    for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+    {
+        if (!FSDFGridGenerator::Generate(LayerMeshes[LayerIndex], Grid, FSDFGridGenerator::FConfig(), LayerDistances[LayerIndex]))
+        {
+            UE_LOG(LogTemp, Error, TEXT("GenerateLayeredSDF: SDF generation failed for layer %d (mesh has no triangles?)"), LayerIndex);
+            return nullptr;
+        }
+        LayerMeshes[LayerIndex].Clear();
+    }
+
+    // 3. 一次并行合成距离与材质通道
+    //    R = 参与距离的各层的并集 (最小距离)；G = 按层顺序覆盖，后面的层覆盖前面的层
+    // -----------------------------------------------------------------------
+    const int32 TotalVoxels = Grid.GetNumSamples();
+    const float MinSpacing = (float)Grid.Spacing.GetMin();
+    TArray<FFloat16Color> RawSDFData;
+    RawSDFData.SetNumUninitialized(TotalVoxels);
+
+    ParallelFor(TotalVoxels, [&](int32 Index)
+    {
+        float Distance = TNumericLimits<float>::Max();
+        float VoxelMatID = 0.0f;
+
+        for (int32 LayerIndex = 0; LayerIndex < NumLayers; LayerIndex++)
+        {
+            const FSDFBakeLayer& Layer = Layers[LayerIndex];
+            const float LayerDistance = LayerDistances[LayerIndex][Index];
+
+            if (Layer.bContributesToDistance)
+            {
+                Distance = FMath::Min(Distance, LayerDistance);
+            }
+
+            if (LayerDistance < 0.0f)
+            {
+                // 与 BakeBrushToVolume 相同的 SmoothStep 过渡，半径为 0 时是硬边界
+                float Alpha = 1.0f;
+                if (Layer.MaterialSmoothVoxels > 0.0f)
+                {
+                    Alpha = FMath::Clamp(-LayerDistance / (Layer.MaterialSmoothVoxels * MinSpacing), 0.0f, 1.0f);
+                    Alpha = Alpha * Alpha * (3.0f - 2.0f * Alpha);
+                }
+                VoxelMatID = FMath::Lerp(VoxelMatID, (float)Layer.MaterialID, Alpha);
+            }
+        }
+
+        RawSDFData[Index] = FFloat16Color(FLinearColor(Distance, VoxelMatID, 0.0f, 1.0f));
+    });
 
-    FThreadSafeCounter TotalWritesCounter;
+    // 4. 创建 Volume Texture 资源 (只写入一次)
+    // -----------------------------------------------------------------------
+    UVolumeTexture* NewTexture = SDFGenLibraryPrivate::CreateVolumeTextureAsset(PackagePath, AssetName, ResolutionXY, Slices, RawSDFData);
+
+    UE_LOG(LogTemp, Log, TEXT("Layered SDF %s (%dx%dx%d, %d layers) baked in %.2f ms"),
+        *AssetName, ResolutionXY, ResolutionXY, Slices, NumLayers, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    return NewTexture;
+}
 
-    // --- 4. 并行计算 ---
-    int32 NumZSlices = EndZ - StartZ + 1;
 
-    ParallelFor(NumZSlices, [&](int32 LoopIndex)
+float USDFGenLibrary::BenchmarkSDFGeneration(UStaticMesh* InputMesh, int32 ResolutionXY, int32 Slices, float BoundsScale)
+{
+    if (!InputMesh)
     {
-        int32 z = StartZ + LoopIndex;
+        UE_LOG(LogTemp, Error, TEXT("Input Mesh is null!"));
+        return -1.0f;
+    }
 
-        FCollisionQueryParams QueryParams;
-        QueryParams.bTraceComplex = true; // 必须开启，以获取准确的三角面法线
-        QueryParams.AddIgnoredActor(VolumeActor); 
-        
-        TArray<FHitResult> HitsPos;
-        TArray<FHitResult> HitsNeg;
-        HitsPos.Reserve(8);
-        HitsNeg.Reserve(8);
+    UE::Geometry::FDynamicMesh3 DynMesh;
+    FSDFGridDesc Grid;
+    if (!SDFGenLibraryPrivate::BuildMeshAndGrid(InputMesh, ResolutionXY, Slices, BoundsScale, DynMesh, Grid))
+    {
+        return -1.0f;
+    }
+
+    FSDFGridGenerator::FCompareResult Result;
+    if (!FSDFGridGenerator::CompareWithExact(DynMesh, Grid, FSDFGridGenerator::FConfig(), Result))
+    {
+        UE_LOG(LogTemp, Error, TEXT("SDF benchmark failed (mesh has no triangles?)"));
+        return -1.0f;
+    }
+
+    const double MinSpacing = Grid.Spacing.GetMin();
+    UE_LOG(LogTemp, Log, TEXT("SDF Benchmark %s (%dx%dx%d, %d tris): narrow band + sweep %.2f ms, exact %.2f ms (%.1fx), max error %.4f (%.3f voxel) at %s, mean error %.5f, sign mismatches %d"),
+        *InputMesh->GetName(), Grid.Dimensions.X, Grid.Dimensions.Y, Grid.Dimensions.Z, DynMesh.TriangleCount(),
+        Result.FastSeconds * 1000.0, Result.ExactSeconds * 1000.0, Result.ExactSeconds / FMath::Max(Result.FastSeconds, 1.0e-9),
+        Result.MaxAbsError, Result.MaxAbsError / MinSpacing, *Result.MaxErrorSample.ToString(), Result.MeanAbsError, Result.SignMismatches);
 
-        auto CheckAxisAndGetDist = [&](const FVector& TargetPos, const FVector& Direction, float& OutCurrentMinDist) -> bool
+    return (float)Result.MaxAbsError;
+}
+
+namespace SDFGenLibraryPrivate
+{
+    // 笔刷影响的体素区域 (体积纹理坐标，闭区间) 及体积的空间参数
+    struct FBrushBakeRegion
+    {
+        FIntVector TextureSize;
+        FIntVector Start;
+        FIntVector End;
+
+        FVector LocalMin;           // 体积网格的局部包围盒
+        FVector LocalSize;
+        FTransform VolLocalToWorld;
+
+        float SmoothWorldRadius = 1.0f;
+
+        FIntVector GetDimensions() const { return End - Start + FIntVector(1); }
+        int32 GetNumVoxels() const { const FIntVector D = GetDimensions(); return D.X * D.Y * D.Z; }
+
+        // 区域内坐标 -> 区域数组下标
+        int32 GetRegionIndex(int32 X, int32 Y, int32 Z) const
         {
-            HitsPos.Reset();
-            HitsNeg.Reset();
+            const FIntVector D = GetDimensions();
+            return ((Z - Start.Z) * D.Y + (Y - Start.Y)) * D.X + (X - Start.X);
+        }
 
-            FVector StartPos = TargetPos + (Direction * 100000.0f);
-            FVector StartNeg = TargetPos - (Direction * 100000.0f);
+        // 体素中心的体积局部坐标
+        FVector GetVoxelLocalPos(int32 X, int32 Y, int32 Z) const
+        {
+            const FVector UVW = FVector(X + 0.5f, Y + 0.5f, Z + 0.5f) / FVector(TextureSize);
+            return LocalMin + LocalSize * UVW;
+        }
+    };
 
-            World->LineTraceMultiByChannel(HitsPos, StartPos, TargetPos, ECC_Visibility, QueryParams);
-            World->LineTraceMultiByChannel(HitsNeg, StartNeg, TargetPos, ECC_Visibility, QueryParams);
+    static bool ComputeBrushRegion(UVolumeTexture* TargetTexture, AActor* VolumeActor, AActor* BrushActor, FBrushBakeRegion& OutRegion)
+    {
+        UStaticMeshComponent* VolMeshComp = VolumeActor->FindComponentByClass<UStaticMeshComponent>();
+        if (!VolMeshComp || !VolMeshComp->GetStaticMesh()) return false;
 
-            int32 CountPos = 0;
-            float LocalMinDist = FLT_MAX;
+        // --- 1. 准备空间数据 ---
+        FBox MeshLocalBounds = VolMeshComp->GetStaticMesh()->GetBoundingBox();
+        OutRegion.LocalMin = MeshLocalBounds.Min;
+        OutRegion.LocalSize = MeshLocalBounds.GetSize();
 
-            // --- 正向射线处理 ---
-            for (const FHitResult& Hit : HitsPos) 
-            { 
-                if (Hit.GetActor() == BrushActor) 
-                {
-                    CountPos++;
-                    float RawDist = FVector::Dist(Hit.ImpactPoint, TargetPos);
-                    
-                    // [核心修正]：计算垂直距离 (Perpendicular Distance)
-                    // Dot(RayDir, Normal) 得到夹角的余弦值
-                    // 距离 * 余弦值 = 垂直于平面的距离
-                    float CosTheta = FMath::Abs(FVector::DotProduct(Direction, Hit.ImpactNormal));
-                    
-                    // 保护性 Clamp，防止法线异常导致距离归零
-                    CosTheta = FMath::Max(CosTheta, 0.05f); 
-
-                    float PerpDist = RawDist * CosTheta;
-
-                    if (PerpDist < LocalMinDist) LocalMinDist = PerpDist;
-                }
+        OutRegion.LocalSize.X = FMath::Max(OutRegion.LocalSize.X, 1.0f);
+        OutRegion.LocalSize.Y = FMath::Max(OutRegion.LocalSize.Y, 1.0f);
+        OutRegion.LocalSize.Z = FMath::Max(OutRegion.LocalSize.Z, 1.0f);
+
+        OutRegion.VolLocalToWorld = VolMeshComp->GetComponentTransform();
+        FTransform VolWorldToLocal = OutRegion.VolLocalToWorld.Inverse();
+
+        FBox BrushWorldBox = BrushActor->GetComponentsBoundingBox();
+        FBox BrushLocalBox = BrushWorldBox.TransformBy(VolWorldToLocal);
+
+        FVector UVMin = (BrushLocalBox.Min - OutRegion.LocalMin) / OutRegion.LocalSize;
+        FVector UVMax = (BrushLocalBox.Max - OutRegion.LocalMin) / OutRegion.LocalSize;
+
+        const FIntVector Size(TargetTexture->GetSizeX(), TargetTexture->GetSizeY(), TargetTexture->GetSizeZ());
+        OutRegion.TextureSize = Size;
+
+        OutRegion.Start.X = FMath::Clamp(FMath::FloorToInt(UVMin.X * Size.X), 0, Size.X - 1);
+        OutRegion.End.X   = FMath::Clamp(FMath::CeilToInt(UVMax.X * Size.X), 0, Size.X - 1);
+        OutRegion.Start.Y = FMath::Clamp(FMath::FloorToInt(UVMin.Y * Size.Y), 0, Size.Y - 1);
+        OutRegion.End.Y   = FMath::Clamp(FMath::CeilToInt(UVMax.Y * Size.Y), 0, Size.Y - 1);
+        OutRegion.Start.Z = FMath::Clamp(FMath::FloorToInt(UVMin.Z * Size.Z), 0, Size.Z - 1);
+        OutRegion.End.Z   = FMath::Clamp(FMath::CeilToInt(UVMax.Z * Size.Z), 0, Size.Z - 1);
+
+        if (OutRegion.Start.X > OutRegion.End.X || OutRegion.Start.Y > OutRegion.End.Y || OutRegion.Start.Z > OutRegion.End.Z) return false;
+
+        // --- 2. 计算平滑参数 ---
+        FVector VoxelSizeWorldVec = OutRegion.VolLocalToWorld.TransformVector(OutRegion.LocalSize / FVector(Size));
+        float AvgVoxelSize = VoxelSizeWorldVec.GetAbs().GetMax();
+
+        // 保持 1.5 到 2.0 的平滑半径，配合法线修正后效果会非常均匀
+        OutRegion.SmoothWorldRadius = AvgVoxelSize * 1.5f;
+        return true;
+    }
+
+    // 内部体素到表面的距离 -> 材质权重 (SmoothStep)
+    static float BrushDistanceToAlpha(float DistToSurface, float SmoothWorldRadius)
+    {
+        float Alpha = FMath::Clamp(DistToSurface / SmoothWorldRadius, 0.0f, 1.0f);
+        return Alpha * Alpha * (3.0f - 2.0f * Alpha);
+    }
+
+    /**
+     * 把笔刷 Actor 上所有 StaticMeshComponent 的网格合并到 "按世界尺度缩放的体积局部空间"
+     * (体积局部坐标 * |缩放|)：该空间与世界空间只差一个刚体变换 (可能带镜像)，距离仍是世界单位
+     */
+    static bool BuildBrushMesh(AActor* BrushActor, const FTransform& VolLocalToWorld, FDynamicMesh3& OutMesh)
+    {
+        const FTransform VolWorldToLocal = VolLocalToWorld.Inverse();
+        const FVector VolScale = VolLocalToWorld.GetScale3D();
+        const FVector AbsScale = VolScale.GetAbs();
+
+        TArray<UStaticMeshComponent*> Components;
+        BrushActor->GetComponents(Components);
+
+        for (UStaticMeshComponent* Component : Components)
+        {
+            const UStaticMesh* Mesh = Component ? Component->GetStaticMesh() : nullptr;
+            const FMeshDescription* MeshDesc = Mesh ? Mesh->GetMeshDescription(0) : nullptr;
+            if (!MeshDesc)
+            {
+                continue;
             }
 
-            int32 CountNeg = 0;
-            // --- 负向射线处理 ---
-            for (const FHitResult& Hit : HitsNeg) 
-            { 
-                if (Hit.GetActor() == BrushActor) 
-                {
-                    CountNeg++;
-                    float RawDist = FVector::Dist(Hit.ImpactPoint, TargetPos);
-                    
-                    // [核心修正] 同上
-                    float CosTheta = FMath::Abs(FVector::DotProduct(Direction, Hit.ImpactNormal));
-                    CosTheta = FMath::Max(CosTheta, 0.05f);
+            FDynamicMesh3 ComponentMesh;
+            FMeshDescriptionToDynamicMesh Converter;
+            Converter.Convert(MeshDesc, ComponentMesh);
 
-                    float PerpDist = RawDist * CosTheta;
+            const FTransform ComponentToWorld = Component->GetComponentTransform();
 
-                    if (PerpDist < LocalMinDist) LocalMinDist = PerpDist;
-                }
+            // 网格局部 -> 缩放后的体积局部空间的行列式为负时三角形朝向翻转，需要反转以保持 Winding 的符号
+            const bool bFlipOrientation = (ComponentToWorld.GetDeterminant() * (VolScale.X * VolScale.Y * VolScale.Z)) < 0.0;
+
+            TArray<int32> VertexMap;
+            VertexMap.Init(IndexConstants::InvalidID, ComponentMesh.MaxVertexID());
+            for (int32 VertexID : ComponentMesh.VertexIndicesItr())
+            {
+                const FVector WorldPos = ComponentToWorld.TransformPosition(ComponentMesh.GetVertex(VertexID));
+                VertexMap[VertexID] = OutMesh.AppendVertex(VolWorldToLocal.TransformPosition(WorldPos) * AbsScale);
             }
 
-            bool bInside = (CountPos % 2 != 0) && (CountNeg % 2 != 0);
-            
-            if (bInside)
+            for (int32 TriangleID : ComponentMesh.TriangleIndicesItr())
             {
-                // 只有当我们确定在内部时，这个轴向测量的距离才是有效的“最近表面距离”的候选者
-                if (LocalMinDist < OutCurrentMinDist)
+                const FIndex3i Source = ComponentMesh.GetTriangle(TriangleID);
+                FIndex3i Triangle(VertexMap[Source.A], VertexMap[Source.B], VertexMap[Source.C]);
+                if (bFlipOrientation)
+                {
+                    Swap(Triangle.B, Triangle.C);
+                }
+
+                // 多个组件合并后可能出现非流形边，此时复制顶点 (距离场只关心三角形本身)
+                if (OutMesh.AppendTriangle(Triangle) < 0)
                 {
-                    OutCurrentMinDist = LocalMinDist;
+                    const FIndex3i Duplicated(
+                        OutMesh.AppendVertex(OutMesh.GetVertex(Triangle.A)),
+                        OutMesh.AppendVertex(OutMesh.GetVertex(Triangle.B)),
+                        OutMesh.AppendVertex(OutMesh.GetVertex(Triangle.C)));
+                    OutMesh.AppendTriangle(Duplicated);
                 }
             }
+        }
+
+        return OutMesh.TriangleCount() > 0;
+    }
 
-            return bInside;
-        };
+    /**
+     * 基于网格的笔刷求值：在笔刷区域的体素中心上生成有符号距离 (窄带 + 扫描，见 FSDFGridGenerator)
+     * @param OutAlpha  区域内每个体素的材质权重，笔刷外部为 -1
+     */
+    static bool EvaluateBrushByMesh(const FBrushBakeRegion& Region, AActor* BrushActor, TArray<float>& OutAlpha)
+    {
+        FDynamicMesh3 BrushMesh;
+        if (!BuildBrushMesh(BrushActor, Region.VolLocalToWorld, BrushMesh))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("BakeBrushToVolume: BrushActor %s has no StaticMeshComponent with mesh data"), *BrushActor->GetName());
+            return false;
+        }
+
+        const FVector AbsScale = Region.VolLocalToWorld.GetScale3D().GetAbs();
+        const FVector LocalVoxelSize = Region.LocalSize / FVector(Region.TextureSize);
+
+        FSDFGridDesc Grid;
+        Grid.Origin = Region.GetVoxelLocalPos(Region.Start.X, Region.Start.Y, Region.Start.Z) * AbsScale;
+        Grid.Spacing = LocalVoxelSize * AbsScale;
+        Grid.Dimensions = Region.GetDimensions();
+        if (!Grid.IsValid())
+        {
+            return false;
+        }
+
+        // 平滑半径 1.5 个体素，窄带取 3 个体素保证平滑范围内的距离都是精确值
+        FSDFGridGenerator::FConfig Config;
+        Config.BandWidth = 3;
+
+        TArray<float> Distances;
+        if (!FSDFGridGenerator::Generate(BrushMesh, Grid, Config, Distances))
+        {
+            return false;
+        }
+
+        OutAlpha.SetNumUninitialized(Distances.Num());
+        ParallelFor(Distances.Num(), [&](int32 Index)
+        {
+            const float Distance = Distances[Index];
+            OutAlpha[Index] = Distance < 0.0f ? BrushDistanceToAlpha(-Distance, Region.SmoothWorldRadius) : -1.0f;
+        });
+        return true;
+    }
+
+    /**
+     * 原有的基于物理射线的笔刷求值 (每个体素 3 个轴向、正反各一条穿过整个场景的射线)
+     * 依赖笔刷的碰撞设置，只保留用于 BenchmarkBrushBake 的对比
+     */
+    static void EvaluateBrushByTraces(UWorld* World, const FBrushBakeRegion& Region, AActor* VolumeActor, AActor* BrushActor, TArray<float>& OutAlpha)
+    {
+        OutAlpha.Init(-1.0f, Region.GetNumVoxels());
+
+        int32 NumZSlices = Region.End.Z - Region.Start.Z + 1;
 
-        for (int y = StartY; y <= EndY; y++)
+        ParallelFor(NumZSlices, [&](int32 LoopIndex)
         {
-            for (int x = StartX; x <= EndX; x++)
+            int32 z = Region.Start.Z + LoopIndex;
+
+            FCollisionQueryParams QueryParams;
+            QueryParams.bTraceComplex = true; // 必须开启，以获取准确的三角面法线
+            QueryParams.AddIgnoredActor(VolumeActor); 
+            
+            TArray<FHitResult> HitsPos;
+            TArray<FHitResult> HitsNeg;
+            HitsPos.Reserve(8);
+            HitsNeg.Reserve(8);
+
+            auto CheckAxisAndGetDist = [&](const FVector& TargetPos, const FVector& Direction, float& OutCurrentMinDist) -> bool
             {
-                FVector UVW = FVector(x + 0.5f, y + 0.5f, z + 0.5f) / FVector(SizeX, SizeY, SizeZ);
-                FVector LocalPos = LocalMin + (LocalSize * UVW);
-                FVector VoxelWorldPos = VolLocalToWorld.TransformPosition(LocalPos);
+                HitsPos.Reset();
+                HitsNeg.Reset();
 
-                int32 PassCount = 0;
-                float MinDistToSurface = FLT_MAX; 
+                FVector StartPos = TargetPos + (Direction * 100000.0f);
+                FVector StartNeg = TargetPos - (Direction * 100000.0f);
 
-                if (CheckAxisAndGetDist(VoxelWorldPos, FVector(0, 0, 1), MinDistToSurface)) PassCount++;
-                if (CheckAxisAndGetDist(VoxelWorldPos, FVector(1, 0, 0), MinDistToSurface)) PassCount++;
-                if (CheckAxisAndGetDist(VoxelWorldPos, FVector(0, 1, 0), MinDistToSurface)) PassCount++;
+                World->LineTraceMultiByChannel(HitsPos, StartPos, TargetPos, ECC_Visibility, QueryParams);
+                World->LineTraceMultiByChannel(HitsNeg, StartNeg, TargetPos, ECC_Visibility, QueryParams);
 
-                if (PassCount >= 1)
+                int32 CountPos = 0;
+                float LocalMinDist = FLT_MAX;
+
+                // --- 正向射线处理 ---
+                for (const FHitResult& Hit : HitsPos) 
+                { 
+                    if (Hit.GetActor() == BrushActor) 
+                    {
+                        CountPos++;
+                        float RawDist = FVector::Dist(Hit.ImpactPoint, TargetPos);
+                        
+                        // [核心修正]：计算垂直距离 (Perpendicular Distance)
+                        // Dot(RayDir, Normal) 得到夹角的余弦值
+                        // 距离 * 余弦值 = 垂直于平面的距离
+                        float CosTheta = FMath::Abs(FVector::DotProduct(Direction, Hit.ImpactNormal));
+                        
+                        // 保护性 Clamp，防止法线异常导致距离归零
+                        CosTheta = FMath::Max(CosTheta, 0.05f); 
+
+                        float PerpDist = RawDist * CosTheta;
+
+                        if (PerpDist < LocalMinDist) LocalMinDist = PerpDist;
+                    }
+                }
+
+                int32 CountNeg = 0;
+                // --- 负向射线处理 ---
+                for (const FHitResult& Hit : HitsNeg) 
+                { 
+                    if (Hit.GetActor() == BrushActor) 
+                    {
+                        CountNeg++;
+                        float RawDist = FVector::Dist(Hit.ImpactPoint, TargetPos);
+                        
+                        // [核心修正] 同上
+                        float CosTheta = FMath::Abs(FVector::DotProduct(Direction, Hit.ImpactNormal));
+                        CosTheta = FMath::Max(CosTheta, 0.05f);
+
+                        float PerpDist = RawDist * CosTheta;
+
+                        if (PerpDist < LocalMinDist) LocalMinDist = PerpDist;
+                    }
+                }
+
+                bool bInside = (CountPos % 2 != 0) && (CountNeg % 2 != 0);
+                
+                if (bInside)
                 {
-                    int32 Index = z * SizeX * SizeY + y * SizeX + x;
-                    
-                    float SafeDist = (MinDistToSurface == FLT_MAX) ? 0.0f : MinDistToSurface;
-                    
-                    // 计算 Alpha
-                    float Alpha = FMath::Clamp(SafeDist / SmoothWorldRadius, 0.0f, 1.0f);
-                    
-                    // 使用更平滑的 Hermite 插值 (SmoothStep)
-                    Alpha = Alpha * Alpha * (3.0f - 2.0f * Alpha);
+                    // 只有当我们确定在内部时，这个轴向测量的距离才是有效的“最近表面距离”的候选者
+                    if (LocalMinDist < OutCurrentMinDist)
+                    {
+                        OutCurrentMinDist = LocalMinDist;
+                    }
+                }
+
+                return bInside;
+            };
+
+            for (int y = Region.Start.Y; y <= Region.End.Y; y++)
+            {
+                for (int x = Region.Start.X; x <= Region.End.X; x++)
+                {
+                    FVector VoxelWorldPos = Region.VolLocalToWorld.TransformPosition(Region.GetVoxelLocalPos(x, y, z));
+
+                    int32 PassCount = 0;
+                    float MinDistToSurface = FLT_MAX; 
 
-                    float FinalValue = (float)MaterialID * Alpha;
-                    MipDataF16[Index].G = FFloat16(bErase ? 0.0f : FinalValue);
-                    TotalWritesCounter.Increment();
+                    if (CheckAxisAndGetDist(VoxelWorldPos, FVector(0, 0, 1), MinDistToSurface)) PassCount++;
+                    if (CheckAxisAndGetDist(VoxelWorldPos, FVector(1, 0, 0), MinDistToSurface)) PassCount++;
+                    if (CheckAxisAndGetDist(VoxelWorldPos, FVector(0, 1, 0), MinDistToSurface)) PassCount++;
+
+                    if (PassCount >= 1)
+                    {
+                        float SafeDist = (MinDistToSurface == FLT_MAX) ? 0.0f : MinDistToSurface;
+                        OutAlpha[Region.GetRegionIndex(x, y, z)] = BrushDistanceToAlpha(SafeDist, Region.SmoothWorldRadius);
+                    }
                 }
             }
-        }
-    });
+        });
+    }
+
+    // 把笔刷权重写入 G 通道：按 8^3 砖块并行，每个砖块在纹理内存中的写入互不重叠
+    static int32 WriteBrushAlpha(FFloat16Color* MipDataF16, const FBrushBakeRegion& Region, const TArray<float>& Alpha, int32 MaterialID, bool bErase)
+    {
+        constexpr int32 BrickSize = 8;
+        const FIntVector Dims = Region.GetDimensions();
+        const FIntVector NumBricks(
+            FMath::DivideAndRoundUp(Dims.X, BrickSize),
+            FMath::DivideAndRoundUp(Dims.Y, BrickSize),
+            FMath::DivideAndRoundUp(Dims.Z, BrickSize));
+
+        FThreadSafeCounter TotalWritesCounter;
+
+        ParallelFor(NumBricks.X * NumBricks.Y * NumBricks.Z, [&](int32 BrickIndex)
+        {
+            const int32 BX = BrickIndex % NumBricks.X;
+            const int32 BY = (BrickIndex / NumBricks.X) % NumBricks.Y;
+            const int32 BZ = BrickIndex / (NumBricks.X * NumBricks.Y);
+
+            const FIntVector BrickMin = Region.Start + FIntVector(BX, BY, BZ) * BrickSize;
+            const FIntVector BrickMax(
+                FMath::Min(BrickMin.X + BrickSize - 1, Region.End.X),
+                FMath::Min(BrickMin.Y + BrickSize - 1, Region.End.Y),
+                FMath::Min(BrickMin.Z + BrickSize - 1, Region.End.Z));
+
+            int32 NumWrites = 0;
+            for (int32 z = BrickMin.Z; z <= BrickMax.Z; z++)
+            {
+                for (int32 y = BrickMin.Y; y <= BrickMax.Y; y++)
+                {
+                    for (int32 x = BrickMin.X; x <= BrickMax.X; x++)
+                    {
+                        const float VoxelAlpha = Alpha[Region.GetRegionIndex(x, y, z)];
+                        if (VoxelAlpha < 0.0f)
+                        {
+                            continue;
+                        }
+
+                        int32 Index = z * Region.TextureSize.X * Region.TextureSize.Y + y * Region.TextureSize.X + x;
+                        float FinalValue = (float)MaterialID * VoxelAlpha;
+                        MipDataF16[Index].G = FFloat16(bErase ? 0.0f : FinalValue);
+                        NumWrites++;
+                    }
+                }
+            }
+            TotalWritesCounter.Add(NumWrites);
+        });
+
+        return TotalWritesCounter.GetValue();
+    }
+}
+
+void USDFGenLibrary::BakeBrushToVolume(UObject* WorldContextObject, UVolumeTexture* TargetTexture, AActor* VolumeActor, AActor* BrushActor, int32 MaterialID, bool bErase)
+{
+    if (!TargetTexture || !VolumeActor || !BrushActor) return;
+
+    SDFGenLibraryPrivate::FBrushBakeRegion Region;
+    if (!SDFGenLibraryPrivate::ComputeBrushRegion(TargetTexture, VolumeActor, BrushActor, Region)) return;
+
+    // --- 1. 由笔刷网格计算区域内的有符号距离 (不经过物理场景，与碰撞设置无关) ---
+    const double StartTime = FPlatformTime::Seconds();
+    TArray<float> Alpha;
+    if (!SDFGenLibraryPrivate::EvaluateBrushByMesh(Region, BrushActor, Alpha)) return;
+
+    // --- 2. 锁定内存并写入 ---
+    FFloat16Color* MipDataF16 = (FFloat16Color*)TargetTexture->Source.LockMip(0);
+    if (!MipDataF16) return;
+
+    const int32 NumWrites = SDFGenLibraryPrivate::WriteBrushAlpha(MipDataF16, Region, Alpha, MaterialID, bErase);
 
     TargetTexture->Source.UnlockMip(0);
     TargetTexture->UpdateResource();
     TargetTexture->MarkPackageDirty();
+
+    UE_LOG(LogTemp, Log, TEXT("[VolumeTools] 笔刷 %s 烘焙完成: 区域 %s, 写入 %d 个体素, 耗时 %.2f 毫秒"),
+        *BrushActor->GetName(), *Region.GetDimensions().ToString(), NumWrites, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+float USDFGenLibrary::BenchmarkBrushBake(UObject* WorldContextObject, UVolumeTexture* TargetTexture, AActor* VolumeActor, AActor* BrushActor)
+{
+    if (!WorldContextObject || !TargetTexture || !VolumeActor || !BrushActor) return -1.0f;
+    UWorld* World = WorldContextObject->GetWorld();
+    if (!World) return -1.0f;
+
+    SDFGenLibraryPrivate::FBrushBakeRegion Region;
+    if (!SDFGenLibraryPrivate::ComputeBrushRegion(TargetTexture, VolumeActor, BrushActor, Region)) return -1.0f;
+
+    TArray<float> TraceAlpha;
+    const double TraceStart = FPlatformTime::Seconds();
+    SDFGenLibraryPrivate::EvaluateBrushByTraces(World, Region, VolumeActor, BrushActor, TraceAlpha);
+    const double TraceSeconds = FPlatformTime::Seconds() - TraceStart;
+
+    TArray<float> MeshAlpha;
+    const double MeshStart = FPlatformTime::Seconds();
+    if (!SDFGenLibraryPrivate::EvaluateBrushByMesh(Region, BrushActor, MeshAlpha)) return -1.0f;
+    const double MeshSeconds = FPlatformTime::Seconds() - MeshStart;
+
+    // 内外判断不一致的体素数，以及两边都在内部时材质权重的最大差异
+    int32 InsideMismatches = 0;
+    int32 NumInside = 0;
+    float MaxAlphaError = 0.0f;
+    for (int32 i = 0; i < MeshAlpha.Num(); i++)
+    {
+        const bool bTraceInside = TraceAlpha[i] >= 0.0f;
+        const bool bMeshInside = MeshAlpha[i] >= 0.0f;
+        NumInside += bMeshInside ? 1 : 0;
+        if (bTraceInside != bMeshInside)
+        {
+            InsideMismatches++;
+        }
+        else if (bMeshInside)
+        {
+            MaxAlphaError = FMath::Max(MaxAlphaError, FMath::Abs(TraceAlpha[i] - MeshAlpha[i]));
+        }
+    }
+
+    const double Speedup = TraceSeconds / FMath::Max(MeshSeconds, 1.0e-9);
+    UE_LOG(LogTemp, Log, TEXT("Brush Bake Benchmark %s (region %s, %d voxels): line traces %.2f ms, mesh SDF %.2f ms (%.1fx), inside %d, inside mismatches %d, max alpha difference %.3f"),
+        *BrushActor->GetName(), *Region.GetDimensions().ToString(), Region.GetNumVoxels(),
+        TraceSeconds * 1000.0, MeshSeconds * 1000.0, Speedup, NumInside, InsideMismatches, MaxAlphaError);
+
+    return (float)Speedup;
+}
+
+USDFVolumeAsset* USDFGenLibrary::CreateSDFVolumeAsset(UVolumeTexture* SourceTexture, FString PackagePath, FString AssetName,
+    float FarDistance, bool bUseOodle)
+{
+    if (!SourceTexture) return nullptr;
+
+    if (SourceTexture->Source.GetFormat() != ETextureSourceFormat::TSF_RGBA16F)
+    {
+        UE_LOG(LogTemp, Error, TEXT("CreateSDFVolumeAsset: %s is not RGBA16F"), *SourceTexture->GetName());
+        return nullptr;
+    }
+
+    const FIntVector Dimensions(SourceTexture->Source.GetSizeX(), SourceTexture->Source.GetSizeY(), SourceTexture->Source.GetNumSlices());
+
+    FString VolAssetName = AssetName;
+    if (!VolAssetName.EndsWith(TEXT("_SDFVol")))
+    {
+        VolAssetName += TEXT("_SDFVol");
+    }
+
+    FString VolPackageName = PackagePath + VolAssetName;
+
+    // 检查是否已经存在一个不同类型的资产 (防止 Crash)
+    UObject* ExistingObject = StaticFindObject(UObject::StaticClass(), nullptr, *VolPackageName);
+    if (ExistingObject && ExistingObject->GetClass() != USDFVolumeAsset::StaticClass())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Name collision detected! Appending GUID to avoid crash."));
+        VolAssetName += TEXT("_") + FGuid::NewGuid().ToString().Left(4);
+        VolPackageName = PackagePath + VolAssetName;
+    }
+
+    UPackage* Package = CreatePackage(*VolPackageName);
+    Package->FullyLoad();
+
+    USDFVolumeAsset* NewAsset = NewObject<USDFVolumeAsset>(Package, *VolAssetName, RF_Public | RF_Standalone);
+
+    const FFloat16Color* SourceData = (const FFloat16Color*)SourceTexture->Source.LockMipReadOnly(0);
+    const bool bBuilt = SourceData && NewAsset->Build(Dimensions, SourceData, bUseOodle ? NAME_Oodle : NAME_LZ4, FarDistance);
+    SourceTexture->Source.UnlockMip(0);
+
+    if (!bBuilt)
+    {
+        UE_LOG(LogTemp, Error, TEXT("CreateSDFVolumeAsset: Failed to build %s"), *VolAssetName);
+        return nullptr;
+    }
+
+    Package->MarkPackageDirty();
+    FAssetRegistryModule::AssetCreated(NewAsset);
+
+    return NewAsset;
 }
 
 void USDFGenLibrary::FillVolumeTextureGChannel(UVolumeTexture* TargetTexture, float FillValue)
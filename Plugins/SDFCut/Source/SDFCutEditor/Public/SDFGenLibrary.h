@@ -7,6 +7,36 @@
 #include "Engine/VolumeTexture.h"
 #include "SDFGenLibrary.generated.h"
 
+class USDFVolumeAsset;
+
+/**
+ * 分层烘焙中的一层 (例如牙釉质 / 牙本质 / 龋坏)
+ */
+USTRUCT(BlueprintType)
+struct SDFCUTEDITOR_API FSDFBakeLayer
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SDF Tools")
+	UStaticMesh* Mesh = nullptr;
+
+	// 该层内部写入的材质 ID (G 通道)，后面的层覆盖前面的层
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SDF Tools")
+	int32 MaterialID = 0;
+
+	// 网格到体积空间的变换 (各层网格在同一坐标系下制作时保持单位变换)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SDF Tools")
+	FTransform Transform;
+
+	// 是否参与距离通道 (R 通道 = 所有参与层的并集)，内部区域 (如龋坏) 可以只写材质
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SDF Tools")
+	bool bContributesToDistance = true;
+
+	// 材质边界的过渡宽度 (体素数)，0 为硬边界
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SDF Tools", meta = (ClampMin = "0.0"))
+	float MaterialSmoothVoxels = 0.0f;
+};
+
 /**
  * 
  */
@@ -36,17 +66,74 @@ public:
 		bool bGenerate2D = false
 	);
 	
+	/**
+	 * 多材质分层烘焙：按顺序给定若干 (网格, 材质 ID) 层，一次生成距离 (R) 与材质 (G) 通道并只写一次纹理
+	 * 每层只计算一次距离场，之后在一次并行遍历中合成，替代 GenerateSDFFromStaticMesh + 多次 BakeBrushToVolume / FillVolumeTextureGChannel
+	 * @param Layers       烘焙层 (顺序即覆盖顺序)
+	 * @param PackagePath  保存路径 (例如 "/Game/Textures/")
+	 * @param AssetName    资源名称
+	 * @param BoundsScale  所有层合并包围盒的缩放系数
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SDF Tools")
+	static UVolumeTexture* GenerateLayeredSDF(
+		const TArray<FSDFBakeLayer>& Layers,
+		FString PackagePath,
+		FString AssetName,
+		int32 ResolutionXY = 128,
+		int32 Slices = 128,
+		float BoundsScale = 1.1f
+	);
+
+	/**
+	 * 对比新旧两种 SDF 生成方式：窄带 + 快速扫描 vs 逐体素 AABB 最近点 + Fast Winding
+	 * 输出两者耗时、最大/平均误差与内外判断不一致的体素数 (日志)
+	 * @return 最大绝对误差 (网格单位)，失败时返回 -1
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SDF Tools")
+	static float BenchmarkSDFGeneration(
+		UStaticMesh* InputMesh,
+		int32 ResolutionXY = 64,
+		int32 Slices = 64,
+		float BoundsScale = 1.1f
+	);
+
 	/**
    * 将 BrushActor 的形状“烘焙”到 VolumeTexture 的 G 通道中
    * @param TargetTexture   目标体积纹理
    * @param VolumeActor     场景中承载该纹理的 Actor (用于确定体积的世界坐标范围)
-   * @param BrushActor      作为笔刷的 Actor (必须有碰撞体，且是封闭模型)
+   * 笔刷内外与到表面的距离由笔刷 StaticMeshComponent 的网格直接计算 (FSDFGridGenerator)，不依赖碰撞设置
+   * @param BrushActor      作为笔刷的 Actor (StaticMeshComponent 的网格需要是封闭模型)
    * @param MaterialID      要写入的材质 ID
    * @param bErase          如果是 true，则写入 0 (或者擦除)
    */
 	UFUNCTION(BlueprintCallable, Category = "Volume Tools", meta = (WorldContext = "WorldContextObject"))
 	static void BakeBrushToVolume(UObject* WorldContextObject, UVolumeTexture* TargetTexture, AActor* VolumeActor, AActor* BrushActor, int32 MaterialID, bool bErase);
+
+	/**
+	 * 对比笔刷烘焙的两种方式：原有的物理射线 (每体素 6 条 LineTraceMulti) vs 基于笔刷网格的有符号距离
+	 * 只计算不写入纹理，输出两者耗时、内外判断不一致的体素数与材质权重的最大差异 (日志)
+	 * @return 网格方式相对射线方式的加速比，失败时返回 -1
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Volume Tools", meta = (WorldContext = "WorldContextObject"))
+	static float BenchmarkBrushBake(UObject* WorldContextObject, UVolumeTexture* TargetTexture, AActor* VolumeActor, AActor* BrushActor);
 	
+	/**
+	 * 将 RGBA16F 体积纹理转换为分块压缩的 SDFVolumeAsset (供 GPUSDFCutter 替代 OriginalSDFTexture)
+	 * @param SourceTexture - 源体积纹理 (读取 Source 数据，格式必须为 RGBA16F)
+	 * @param PackagePath - 保存路径 (例如 "/Game/SDF/")
+	 * @param AssetName - 资源名称 (自动追加 "_SDFVol")
+	 * @param FarDistance - > 0 时把 |R| 截断到该值，远场块变为均匀块不再存储；0 为无损
+	 * @param bUseOodle - 使用 Oodle (更小、解压同样快)，否则使用 LZ4
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SDF Tools")
+	static USDFVolumeAsset* CreateSDFVolumeAsset(
+		UVolumeTexture* SourceTexture,
+		FString PackagePath = TEXT("/Game/SDF/"),
+		FString AssetName = TEXT("SDF_Volume"),
+		float FarDistance = 0.0f,
+		bool bUseOodle = false
+	);
+
 	UFUNCTION(BlueprintCallable, Category = "Volume Texture Tools")
 	static void FillVolumeTextureGChannel(UVolumeTexture* TargetTexture, float FillValue);
 };
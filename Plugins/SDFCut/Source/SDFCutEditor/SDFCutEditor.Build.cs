@@ -40,7 +40,8 @@ public class SDFCutEditor : ModuleRules
 				"CoreUObject",
 				"Engine",
 				"Renderer",	
-				"MeshConversion"
+				"MeshConversion",
+				"SDFCut"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -3,6 +3,8 @@
 
 #include "HapticProbeComponent.h"
 #include "GPUSDFCutter.h"
+#include "SDFDistancePyramid.h"
+#include "SDFToolLibrary.h"
 #include "DrawDebugHelpers.h" 
 
 
@@ -16,13 +18,17 @@ void UHapticProbeComponent::BeginPlay()
 	Super::BeginPlay();
 	SetSDFVolumeProvider();
 	
-	// 初始化材质系数 
-	MaterialStiffnessScales.Add(0, 1.0f); // 牙釉质 (硬)
-	MaterialStiffnessScales.Add(1, 0.6f); // 牙本质 (中)
-	MaterialStiffnessScales.Add(2, 0.2f); // 龋坏 (软)
-	MaterialStiffnessScales.Add(3, 0.8f); // 填充物(较硬)
-	
-	UpdateProbeMesh();
+	// 有刀具库时一次性准备所有刀具的点壳，否则只采样当前网格
+	// 刀具库是共享资产，先恢复默认刀具，上一次 PIE 的换刀结果不能带到本次
+	if (ToolLibrary)
+	{
+		ToolLibrary->ResetActiveTool();
+		PreloadToolLibrary();
+	}
+	else
+	{
+		UpdateProbeMesh();
+	}
 
 	// 获取RayStart
 	RayStart = Cast<USceneComponent>(RayStartPointRef.GetComponent(GetOwner()));
@@ -54,6 +60,18 @@ bool UHapticProbeComponent::CalculateForce(FVector& OutForce, FVector& OutTorque
 {
     if (!SDFProvider) return false;
 
+    // 游戏线程替换点壳时短暂持有该锁，其余时间无竞争
+    FScopeLock ShellLock(&ProbeShellLock);
+
+    // 换刀：只交换常驻点壳，不采样、不分配
+    SyncActiveTool();
+
+    if (RenderMode == EHapticRenderMode::GodObject)
+    {
+        return CalculateGodObjectForce(OutForce, OutTorque);
+    }
+    bProxyValid = false;
+
     // [开始计时]
     double StartTime = FPlatformTime::Seconds();
 
@@ -74,16 +92,135 @@ bool UHapticProbeComponent::CalculateForce(FVector& OutForce, FVector& OutTorque
     // 步骤 1: 收集几何信息 (Gather Geometry)
     // =========================================================
     
-    // 预分配数据容器
+    // 1.1 层次剔除：用簇中心的一次 SDF 采样排除整簇采样点
+    // 若 SDF(中心) > 簇半径，则簇内任何点都不可能陷入物体
+    const float ProbeScale = ProbeCompTransform.GetScale3D().GetAbs().GetMax();
+    const float WorldToSDF = SDFProvider->GetWorldToSDFScale();
+    // 三线性插值 + 半精度带来的误差余量
+    const float CullMargin = VoxelSize * 0.5f;
+
+    // 1.2 时间相干性：估计自上一次查询以来任意采样点的最大位移
+    const FTransform TargetTransform = SDFProvider->GetLocalToWorldTransform();
+    const FTransform ProbeToTarget = ProbeCompTransform.GetRelativeTransform(TargetTransform);
+
+    float FrameMotion = TNumericLimits<float>::Max();
+    if (bUseWarmStart && ContactCache.bValid && LocalClusters.Num() > 0 &&
+        ContactCache.ClusterClearance.Num() == LocalClusters.Num() &&
+        ProbeToTarget.GetScale3D().Equals(ContactCache.LastProbeToTarget.GetScale3D()))
+    {
+        // 上一次的相对位姿放到当前目标位置下比较，目标移动也计入
+        const FTransform PrevProbeTransform = ContactCache.LastProbeToTarget * TargetTransform;
+        const FProbePointCluster& Root = LocalClusters[0];
+        const float ShellRadius = (FVector(Root.Center).Size() + Root.Radius) * ProbeScale;
+
+        FrameMotion = FVector::Dist(PrevProbeTransform.GetLocation(), ProbeLocation)
+            + PrevProbeTransform.GetRotation().AngularDistance(ProbeCompTransform.GetRotation()) * ShellRadius;
+    }
+
+    const bool bWarmStart = FrameMotion <= WarmStartMaxMotion;
+    if (bWarmStart)
+    {
+        ContactCache.AccumulatedMotion += FrameMotion;
+    }
+    else
+    {
+        // 运动过大 (或首次查询)：丢弃缓存，完整查询
+        ContactCache.Reset(LocalClusters.Num());
+    }
+    ContactCache.bValid = true;
+    ContactCache.LastProbeToTarget = ProbeToTarget;
+
+    // 1.2.1 金字塔粗检测：整个探针外接球覆盖的体素区域 SDF 全部为正时，不可能有任何采样点陷入物体
+    if (const FSDFDistancePyramid* Pyramid = SDFProvider->GetDistancePyramid(); Pyramid && LocalClusters.Num() > 0)
+    {
+        const FProbePointCluster& Root = LocalClusters[0];
+        FVector RootVoxelCoord;
+        if (SDFProvider->WorldToVoxelSpace(ProbeCompTransform.TransformPosition(FVector(Root.Center)), RootVoxelCoord))
+        {
+            const float RadiusVoxels = (Root.Radius * ProbeScale * WorldToSDF + CullMargin) / VoxelSize;
+            const FBox VoxelBox(RootVoxelCoord - FVector(RadiusVoxels), RootVoxelCoord + FVector(RadiusVoxels));
+            if (Pyramid->IsRegionClear(VoxelBox, 0.0f))
+            {
+                LastContactStiffnessScale = 1.0f;
+                LastContactCutResistance = 0.0f;
+                return false;
+            }
+        }
+    }
+
+    // 1.3 遍历层次结构，收集需要逐点采样的点
+    TArray<int32, TInlineAllocator<256>> ActivePoints;
+    int32 CullSampleCount = 0;
+
+    if (bUseClusterCulling && LocalClusters.Num() > 0)
+    {
+        TArray<int32, TInlineAllocator<64>> Stack;
+        Stack.Push(0);
+
+        while (Stack.Num() > 0)
+        {
+            const int32 ClusterIndex = Stack.Pop(EAllowShrinking::No);
+            const FProbePointCluster& Cluster = LocalClusters[ClusterIndex];
+            float& CachedClearance = ContactCache.ClusterClearance[ClusterIndex];
+
+            // 上次剔除时的间隙还没被运动量耗尽，无需采样
+            if (bWarmStart && CachedClearance > ContactCache.AccumulatedMotion)
+            {
+                continue;
+            }
+
+            CachedClearance = -1.0f;
+
+            FVector VoxelCoord;
+            if (SDFProvider->WorldToVoxelSpace(ProbeCompTransform.TransformPosition(FVector(Cluster.Center)), VoxelCoord))
+            {
+                CullSampleCount++;
+                const float ClusterRadiusSDF = Cluster.Radius * ProbeScale * WorldToSDF;
+                const float CenterSDF = SDFProvider->SampleSDF(VoxelCoord);
+                if (CenterSDF > ClusterRadiusSDF + CullMargin)
+                {
+                    // 记录间隙 (世界单位)，供后续查询复用
+                    CachedClearance = (CenterSDF - ClusterRadiusSDF - CullMargin) / WorldToSDF + ContactCache.AccumulatedMotion;
+                    continue;
+                }
+            }
+            // 簇中心在体积外时无法判断，继续细分
+
+            if (Cluster.IsLeaf())
+            {
+                for (int32 i = Cluster.FirstPoint; i < Cluster.FirstPoint + Cluster.NumPoints; i++)
+                {
+                    ActivePoints.Add(i);
+                }
+            }
+            else
+            {
+                Stack.Push(Cluster.FirstChild);
+                Stack.Push(Cluster.SecondChild);
+            }
+        }
+    }
+    else
+    {
+        ActivePoints.SetNumUninitialized(NumPoints);
+        for (int32 i = 0; i < NumPoints; i++)
+        {
+            ActivePoints[i] = i;
+        }
+    }
+
+    const int32 NumActivePoints = ActivePoints.Num();
+
+    // 预分配数据容器 (只为未被剔除的点分配)
     TArray<FGeoSampleData> SampleResults;
-    SampleResults.SetNum(NumPoints);
+    SampleResults.SetNum(NumActivePoints);
 
     // 阈值：决定是否开启多线程
-    bool bUseParallel = (NumPoints > 64) && !bVisualizeSamplePoints;
+    bool bUseParallel = (NumActivePoints > 64) && !bVisualizeSamplePoints;
 
     auto GatherFunction = [&](int32 Idx)
     {
-        const FVector& LocalPt = LocalSamplePoints[Idx];
+        const FVector& LocalPt = LocalSamplePoints[ActivePoints[Idx]];
         FVector WorldPt = ProbeCompTransform.TransformPosition(LocalPt);
         FVector VoxelCoord;
 
@@ -91,23 +228,16 @@ bool UHapticProbeComponent::CalculateForce(FVector& OutForce, FVector& OutTorque
 
         if (SDFProvider->WorldToVoxelSpace(WorldPt, VoxelCoord))
         {
-            float SDFVal = SDFProvider->SampleSDF(VoxelCoord);
+            // SDF 与材质 ID 一次读取
+            int32 MaterialID = 0;
+            float SDFVal = SDFProvider->SampleSDFAndMaterial(VoxelCoord, MaterialID);
 
             if (SDFVal < 0.0f) // 碰撞
             {
                 // 计算梯度 (法线方向)
-                const float H = 1.0f; 
-                float DX_P = SDFProvider->SampleSDF(VoxelCoord + FVector(H, 0, 0));
-                float DX_N = SDFProvider->SampleSDF(VoxelCoord - FVector(H, 0, 0));
-                float DY_P = SDFProvider->SampleSDF(VoxelCoord + FVector(0, H, 0));
-                float DY_N = SDFProvider->SampleSDF(VoxelCoord - FVector(0, H, 0));
-                float DZ_P = SDFProvider->SampleSDF(VoxelCoord + FVector(0, 0, H));
-                float DZ_N = SDFProvider->SampleSDF(VoxelCoord - FVector(0, 0, H));
-
-                FVector Gradient(DX_P - DX_N, DY_P - DY_N, DZ_P - DZ_N);
-                
-                SampleResults[Idx].Gradient = Gradient.GetSafeNormal();
+                SampleResults[Idx].Gradient = SampleGradient(VoxelCoord).GetSafeNormal();
                 SampleResults[Idx].Depth = -SDFVal * VoxelSize;
+                SampleResults[Idx].MaterialID = MaterialID;
                 SampleResults[Idx].bIsValid = true;
             }
         }
@@ -115,11 +245,17 @@ bool UHapticProbeComponent::CalculateForce(FVector& OutForce, FVector& OutTorque
 
     if (bUseParallel)
     {
-        ParallelFor(NumPoints, GatherFunction);
+        ParallelFor(NumActivePoints, GatherFunction);
     }
     else
     {
-        for (int32 i = 0; i < NumPoints; i++) GatherFunction(i);
+        for (int32 i = 0; i < NumActivePoints; i++) GatherFunction(i);
+    }
+
+    if (bLogCalcTime)
+    {
+        UE_LOG(LogTemp, Log, TEXT("HapticProbe: %d/%d points active after culling (%d cluster samples)"),
+            NumActivePoints, NumPoints, CullSampleCount);
     }
 
     // =========================================================
@@ -140,7 +276,40 @@ bool UHapticProbeComponent::CalculateForce(FVector& OutForce, FVector& OutTorque
         }
     }
 
-    if (HitCount == 0) return false; // 无碰撞
+    if (HitCount == 0)
+    {
+        // 无碰撞
+        LastContactStiffnessScale = 1.0f;
+        LastContactCutResistance = 0.0f;
+        return false;
+    }
+
+    // 2.1.1 按材质混合刚度与切削阻力 (权重 = 采样点面积 * 穿透深度)
+    {
+        float WeightSum = 0.0f;
+        float StiffnessSum = 0.0f;
+        float ResistanceSum = 0.0f;
+
+        for (int32 i = 0; i < NumActivePoints; i++)
+        {
+            const FGeoSampleData& Sample = SampleResults[i];
+            if (!Sample.bIsValid) continue;
+
+            const int32 PointIndex = ActivePoints[i];
+            const float Area = LocalSampleAreas.IsValidIndex(PointIndex) ? LocalSampleAreas[PointIndex] : 1.0f;
+            const float Weight = Area * FMath::Max(Sample.Depth, KINDA_SMALL_NUMBER);
+
+            WeightSum += Weight;
+            StiffnessSum += GetStiffnessScale(Sample.MaterialID) * Weight;
+            ResistanceSum += GetCutResistance(Sample.MaterialID) * Weight;
+        }
+
+        if (WeightSum > 0.0f)
+        {
+            LastContactStiffnessScale = StiffnessSum / WeightSum;
+            LastContactCutResistance = ResistanceSum / WeightSum;
+        }
+    }
 
     // 2.2 计算共识法线 (只统计"表面层"的点)
     // 表面层定义：最浅深度 + 1.5个 体素厚度
@@ -175,7 +344,25 @@ bool UHapticProbeComponent::CalculateForce(FVector& OutForce, FVector& OutTorque
 
 	FVector SafeStartPoint = RayStart->GetComponentLocation();
     FVector SurfaceHitPoint;
-    bool bFoundSurface = FindSurfacePointFromRay(SafeStartPoint, ProbeLocation, SurfaceHitPoint);
+    bool bFoundSurface = false;
+
+    // 3.0 热启动：先尝试把上一次的接触点投影回表面
+    if (bWarmStart && ContactCache.bHasSurfaceHit)
+    {
+        const FVector PrevSurfacePoint = TargetTransform.TransformPosition(ContactCache.LastSurfaceHitLocal);
+        bFoundSurface = ProjectPreviousSurfacePoint(SafeStartPoint, ProbeLocation, PrevSurfacePoint, SurfaceHitPoint);
+    }
+
+    if (!bFoundSurface)
+    {
+        bFoundSurface = FindSurfacePointFromRay(SafeStartPoint, ProbeLocation, SurfaceHitPoint);
+    }
+
+    ContactCache.bHasSurfaceHit = bFoundSurface;
+    if (bFoundSurface)
+    {
+        ContactCache.LastSurfaceHitLocal = TargetTransform.InverseTransformPosition(SurfaceHitPoint);
+    }
 
     float PenetrationDepth = 0.0f;
     FVector ForceDirection = FVector::ZeroVector;
@@ -220,9 +407,8 @@ bool UHapticProbeComponent::CalculateForce(FVector& OutForce, FVector& OutTorque
     // 步骤 4: 计算最终力与力矩 (Final Calculation)
     // =========================================================
 
-    // 这里简化了材质获取，直接取探针中心位置的材质，或者取最近点的材质
-    // 为了更精确，应该在 SphereTracing 时顺便获取 SurfaceHitPoint 的材质 ID
-    float Stiffness = BaseStiffness; 
+    // 刚度按接触点的材质混合 (见 2.1.1)
+    float Stiffness = BaseStiffness * LastContactStiffnessScale;
     
     // 计算力：F = k * x * n
     FinalForce = ForceDirection * (PenetrationDepth * Stiffness);
@@ -279,6 +465,11 @@ bool UHapticProbeComponent::FindSurfacePointFromRay(const FVector& StartPoint, c
 
 	FVector CurrentPos = StartPoint;
 
+	// 距离金字塔：远离表面时按粗层单元整块跳过，只在表面附近逐步细化
+	const FSDFDistancePyramid* Pyramid = SDFProvider->GetDistancePyramid();
+	// 每单位世界距离对应的体素坐标增量
+	const FVector VoxelDirection = SDFProvider->GetLocalToWorldTransform().InverseTransformVector(Direction) / VoxelSize;
+
 	// 3. Sphere Tracing 循环
 	for (int32 i = 0; i < MaxSteps; i++)
 	{
@@ -290,6 +481,23 @@ bool UHapticProbeComponent::FindSurfacePointFromRay(const FVector& StartPoint, c
 			return false;
 		}
 
+		if (Pyramid)
+		{
+			const float RemainingDist = TotalDistance - CurrentDist;
+			const float Skip = Pyramid->AdvanceRay(VoxelCoord, VoxelDirection, 0.0f, RemainingDist, SurfaceThreshold);
+			if (Skip > 0.0f)
+			{
+				CurrentDist += Skip;
+				if (CurrentDist >= TotalDistance)
+				{
+					return false;
+				}
+
+				CurrentPos = StartPoint + Direction * CurrentDist;
+				continue;
+			}
+		}
+
 		float SDFVal = SDFProvider->SampleSDF(VoxelCoord);
 
 		// --- 命中检测 ---
@@ -331,7 +539,279 @@ bool UHapticProbeComponent::FindSurfacePointFromRay(const FVector& StartPoint, c
 }
 
 
-void UHapticProbeComponent::UpdateProbeMesh()
+bool UHapticProbeComponent::CalculateGodObjectForce(FVector& OutForce, FVector& OutTorque)
+{
+	OutForce = FVector::ZeroVector;
+	OutTorque = FVector::ZeroVector;
+
+	if (!ProbeMeshComp) return false;
+
+	FRWScopeLock ReadLock(SDFProvider->GetDataLock(), SLT_ReadOnly);
+
+	const FTransform TargetTransform = SDFProvider->GetLocalToWorldTransform();
+	const FVector DeviceLocation = ProbeMeshComp->GetComponentLocation();
+	const double Now = FPlatformTime::Seconds();
+
+	// 1. 初始化代理点
+	if (!bProxyValid)
+	{
+		FVector InitialProxy = DeviceLocation;
+
+		// 设备已经在物体内部时，沿救生索射线找表面作为起点
+		float Distance;
+		FVector Normal;
+		FVector SurfacePoint;
+		if (SampleSurface(DeviceLocation, Distance, Normal) && Distance < 0.0f && RayStart &&
+			FindSurfacePointFromRay(RayStart->GetComponentLocation(), DeviceLocation, SurfacePoint))
+		{
+			InitialProxy = SurfacePoint;
+		}
+
+		ProxyLocationLocal = TargetTransform.InverseTransformPosition(InitialProxy);
+		LastCouplingOffset = InitialProxy - DeviceLocation;
+		LastCouplingTime = Now;
+		bProxyValid = true;
+	}
+
+	// 2. 代理点向设备位置移动，受 SDF 表面约束
+	FVector Proxy = TargetTransform.TransformPosition(ProxyLocationLocal);
+	FVector Goal = DeviceLocation;
+
+	// 距表面小于该值 (世界单位) 视为接触，与 TraceProxy 的最小步长一致
+	const float ContactSkin = SDFProvider->GetVoxelSize() * 0.1f / SDFProvider->GetWorldToSDFScale();
+
+	for (int32 Iter = 0; Iter < MaxProxyIterations; Iter++)
+	{
+		if (FVector::DistSquared(Proxy, Goal) < KINDA_SMALL_NUMBER)
+		{
+			break;
+		}
+
+		// 2.1 代理点贴着表面且运动方向朝内：去掉法向分量，沿切平面滑动
+		float Distance;
+		FVector Normal;
+		if (SampleSurface(Proxy, Distance, Normal) && Distance <= ContactSkin)
+		{
+			const float Into = FVector::DotProduct(Goal - Proxy, Normal);
+			if (Into < 0.0f)
+			{
+				Goal -= Normal * Into;
+				if (FVector::DistSquared(Proxy, Goal) < KINDA_SMALL_NUMBER)
+				{
+					break;
+				}
+			}
+		}
+
+		// 2.2 沿 (滑动后的) 目标方向追踪，碰到新表面就停下，下一轮再处理新的约束平面
+		FVector Blocked;
+		if (!TraceProxy(Proxy, Goal, Blocked))
+		{
+			Proxy = Goal;
+			break;
+		}
+		Proxy = Blocked;
+	}
+
+	// 2.3 数值误差可能让代理点略微进入表面，投影回去 p -= sdf * n
+	{
+		float Distance;
+		FVector Normal;
+		if (SampleSurface(Proxy, Distance, Normal) && Distance < 0.0f)
+		{
+			Proxy -= Normal * Distance;
+		}
+	}
+
+	ProxyLocationLocal = TargetTransform.InverseTransformPosition(Proxy);
+
+	// 3. 弹簧阻尼耦合：F = k * (proxy - device) + b * d(proxy - device)/dt
+	const FVector CouplingOffset = Proxy - DeviceLocation;
+	const double DeltaTime = FMath::Clamp(Now - LastCouplingTime, 1.0e-4, 0.05);
+	const FVector CouplingVelocity = (CouplingOffset - LastCouplingOffset) / DeltaTime;
+
+	LastCouplingOffset = CouplingOffset;
+	LastCouplingTime = Now;
+
+	const bool bInContact = CouplingOffset.SizeSquared() > KINDA_SMALL_NUMBER;
+
+	// 接触材质决定耦合刚度。代理点位于表面上或略在外侧，那里的 G 通道是背景值 (0)，
+	// 所以沿表面法线向内偏移一个体素再采样
+	LastContactStiffnessScale = 1.0f;
+	LastContactCutResistance = 0.0f;
+	float ProxyDistance;
+	FVector ProxyNormal;
+	FVector ContactVoxelCoord;
+	if (bInContact && SampleSurface(Proxy, ProxyDistance, ProxyNormal))
+	{
+		const FVector ContactPoint = Proxy - ProxyNormal * (SDFProvider->GetVoxelSize() / SDFProvider->GetWorldToSDFScale());
+		if (SDFProvider->WorldToVoxelSpace(ContactPoint, ContactVoxelCoord))
+		{
+			const int32 MaterialID = SDFProvider->SampleMaterialID(ContactVoxelCoord);
+			LastContactStiffnessScale = GetStiffnessScale(MaterialID);
+			LastContactCutResistance = GetCutResistance(MaterialID);
+		}
+	}
+
+	if (bInContact)
+	{
+		OutForce = CouplingOffset * (CouplingStiffness * LastContactStiffnessScale) + CouplingVelocity * CouplingDamping;
+	}
+	// 点代理的作用线经过设备位置，不产生力矩
+
+	if (bVisualizeForce)
+	{
+		DrawDebugPoint(GetWorld(), Proxy, 8.0f, FColor::Cyan, false, 0.0f);
+		DrawDebugLine(GetWorld(), DeviceLocation, Proxy, FColor::Green, false, 0.0f);
+		DrawDebugLine(GetWorld(), DeviceLocation, DeviceLocation + OutForce, FColor::Purple, false, 0.0f, 0, 1.0f);
+	}
+
+	return bInContact;
+}
+
+bool UHapticProbeComponent::TraceProxy(const FVector& From, const FVector& To, FVector& OutPosition) const
+{
+	FVector Direction = To - From;
+	const float TotalDistance = Direction.Size();
+	if (TotalDistance < KINDA_SMALL_NUMBER) return false;
+
+	Direction /= TotalDistance;
+
+	const float WorldToSDF = SDFProvider->GetWorldToSDFScale();
+	const float MinStep = SDFProvider->GetVoxelSize() * 0.1f / WorldToSDF;
+	const int32 MaxSteps = 32;
+
+	float CurrentDist = 0.0f;
+	float LastOutsideDist = 0.0f;
+
+	for (int32 i = 0; i < MaxSteps; i++)
+	{
+		float Distance;
+		FVector Normal;
+		if (!SampleSurface(From + Direction * CurrentDist, Distance, Normal))
+		{
+			// 体积外是自由空间，按最小步长继续
+			Distance = MinStep;
+		}
+
+		if (Distance < 0.0f)
+		{
+			// 跨越表面：在 [LastOutsideDist, CurrentDist] 之间二分找到交点
+			float Lo = LastOutsideDist;
+			float Hi = CurrentDist;
+			for (int32 Bisect = 0; Bisect < 6; Bisect++)
+			{
+				const float Mid = 0.5f * (Lo + Hi);
+				if (SampleSurface(From + Direction * Mid, Distance, Normal) && Distance < 0.0f)
+				{
+					Hi = Mid;
+				}
+				else
+				{
+					Lo = Mid;
+				}
+			}
+			OutPosition = From + Direction * Lo;
+			return true;
+		}
+
+		LastOutsideDist = CurrentDist;
+		if (CurrentDist >= TotalDistance)
+		{
+			return false;
+		}
+
+		CurrentDist = FMath::Min(CurrentDist + FMath::Max(Distance, MinStep), TotalDistance);
+	}
+
+	// 步数用完还没到终点，停在最后一个安全位置
+	OutPosition = From + Direction * LastOutsideDist;
+	return true;
+}
+
+bool UHapticProbeComponent::SampleSurface(const FVector& WorldPos, float& OutDistance, FVector& OutNormal) const
+{
+	FVector VoxelCoord;
+	if (!SDFProvider->WorldToVoxelSpace(WorldPos, VoxelCoord))
+	{
+		return false;
+	}
+
+	OutDistance = SDFProvider->SampleSDF(VoxelCoord) / SDFProvider->GetWorldToSDFScale();
+	OutNormal = SDFProvider->GetLocalToWorldTransform().TransformVector(SampleGradient(VoxelCoord)).GetSafeNormal();
+	return true;
+}
+
+FVector UHapticProbeComponent::SampleGradient(const FVector& VoxelCoord) const
+{
+	const float H = 1.0f;
+	return FVector(
+		SDFProvider->SampleSDF(VoxelCoord + FVector(H, 0, 0)) - SDFProvider->SampleSDF(VoxelCoord - FVector(H, 0, 0)),
+		SDFProvider->SampleSDF(VoxelCoord + FVector(0, H, 0)) - SDFProvider->SampleSDF(VoxelCoord - FVector(0, H, 0)),
+		SDFProvider->SampleSDF(VoxelCoord + FVector(0, 0, H)) - SDFProvider->SampleSDF(VoxelCoord - FVector(0, 0, H)));
+}
+
+FVector UHapticProbeComponent::GetProxyLocation() const
+{
+	if (!bProxyValid || !SDFProvider)
+	{
+		return ProbeMeshComp ? ProbeMeshComp->GetComponentLocation() : GetComponentLocation();
+	}
+	return SDFProvider->GetLocalToWorldTransform().TransformPosition(ProxyLocationLocal);
+}
+
+bool UHapticProbeComponent::ProjectPreviousSurfacePoint(const FVector& StartPoint, const FVector& EndPoint,
+	const FVector& PrevSurfacePoint, FVector& OutSurfacePoint)
+{
+	if (!SDFProvider) return false;
+
+	FVector Direction = EndPoint - StartPoint;
+	const float TotalDistance = Direction.Size();
+	if (TotalDistance < KINDA_SMALL_NUMBER) return false;
+
+	Direction /= TotalDistance;
+
+	// 1. 当前射线上离上一次接触点最近的点
+	const float T = FMath::Clamp(FVector::DotProduct(PrevSurfacePoint - StartPoint, Direction), 0.0f, TotalDistance);
+	FVector CurrentPos = StartPoint + Direction * T;
+
+	const float VoxelSize = SDFProvider->GetVoxelSize();
+	const float SurfaceThreshold = VoxelSize * 0.5f;
+	const float WorldToSDF = SDFProvider->GetWorldToSDFScale();
+	const FTransform TargetTransform = SDFProvider->GetLocalToWorldTransform();
+
+	// 2. 沿梯度做少量牛顿投影 p -= sdf * n
+	const int32 MaxIterations = 3;
+	for (int32 i = 0; i < MaxIterations; i++)
+	{
+		FVector VoxelCoord;
+		if (!SDFProvider->WorldToVoxelSpace(CurrentPos, VoxelCoord))
+		{
+			return false;
+		}
+
+		const float SDFVal = SDFProvider->SampleSDF(VoxelCoord);
+		if (FMath::Abs(SDFVal) <= SurfaceThreshold)
+		{
+			OutSurfacePoint = CurrentPos;
+			return true;
+		}
+
+		const FVector WorldNormal = TargetTransform.TransformVector(SampleGradient(VoxelCoord)).GetSafeNormal();
+		if (WorldNormal.IsNearlyZero())
+		{
+			return false;
+		}
+
+		CurrentPos -= WorldNormal * (SDFVal / WorldToSDF);
+	}
+
+	// 没有收敛 (运动过大或表面拓扑变化)，交给完整射线查询
+	return false;
+}
+
+
+bool UHapticProbeComponent::ResolveProbeMeshComponent()
 {
 	ProbeMeshComp = Cast<UStaticMeshComponent>(VisualMeshRef.GetComponent(GetOwner()));
 	// 如果没选，尝试回退到 Owner 自身的组件 (可选逻辑)
@@ -347,6 +827,48 @@ void UHapticProbeComponent::UpdateProbeMesh()
 	if (!ProbeMeshComp)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("HapticProbe: No valid StaticMeshComponent found."));
+		return false;
+	}
+	return true;
+}
+
+FProbePointShellPtr UHapticProbeComponent::GetOrBuildPointShell(const UStaticMesh* MeshAsset)
+{
+	// 1. 优先从缓存读取点壳 (相同网格 + 相同采样参数)
+	const uint64 CacheKey = FProbePointShellCache::MakeKey(MeshAsset, SamplingDensity, SamplingMinSpacing);
+	FProbePointShellPtr Shell = bUsePointShellCache ? FProbePointShellCache::Find(CacheKey) : nullptr;
+
+	if (Shell.IsValid())
+	{
+		UE_LOG(LogTemp, Log, TEXT("Loaded %d cached sample points for probe."), Shell->Num());
+		return Shell;
+	}
+
+	// 2. 缓存未命中，重新采样
+	TSharedPtr<FProbePointShell, ESPMode::ThreadSafe> NewShell = MakeShared<FProbePointShell, ESPMode::ThreadSafe>();
+	GenerateUniformSurfacePoints(MeshAsset, SamplingDensity, *NewShell);
+	NewShell->BuildClusters();
+
+	if (bUsePointShellCache)
+	{
+		FProbePointShellCache::Store(CacheKey, NewShell);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Generated %d sample points for probe."), NewShell->Num());
+	return NewShell;
+}
+
+void UHapticProbeComponent::UpdateProbeMesh()
+{
+	// 有刀具库时探针形状由当前刀具决定，用 PreloadToolLibrary 重新准备
+	if (ToolLibrary)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HapticProbe: UpdateProbeMesh is ignored while a tool library is assigned."));
+		return;
+	}
+
+	if (!ResolveProbeMeshComponent())
+	{
 		return;
 	}
 	
@@ -357,24 +879,138 @@ void UHapticProbeComponent::UpdateProbeMesh()
 		return;
 	}
 
-	// 清空旧数据
-	LocalSamplePoints.Empty();
+	ApplyPointShell(*GetOrBuildPointShell(MeshAsset));
+}
 
-	GenerateUniformSurfacePoints(MeshAsset, SamplingDensity);	
-	
+void UHapticProbeComponent::PreloadToolLibrary()
+{
+	if (!ToolLibrary || !ResolveProbeMeshComponent())
+	{
+		return;
+	}
+
+	// 先在锁外准备所有常驻点壳，触觉线程继续使用旧数据
+	const int32 NumTools = ToolLibrary->GetNumTools();
+	TArray<FResidentProbeShell> NewShells;
+	NewShells.SetNum(NumTools);
+	VisualToolIndex = INDEX_NONE;
+
+	int32 MaxClusters = 0;
+	for (int32 ToolIndex = 0; ToolIndex < NumTools; ToolIndex++)
+	{
+		const FSDFToolLibraryEntry* Tool = ToolLibrary->GetTool(ToolIndex);
+		if (!Tool->Mesh)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("HapticProbe: Tool %d (%s) has no mesh, it will produce no force."), ToolIndex, *Tool->Name.ToString());
+			continue;
+		}
+
+		const FProbePointShellPtr Shell = GetOrBuildPointShell(Tool->Mesh);
+		FResidentProbeShell& Resident = NewShells[ToolIndex];
+		const int32 NumPoints = Shell->Num();
+
+		Resident.Points.SetNumUninitialized(NumPoints);
+		Resident.Normals.SetNumUninitialized(NumPoints);
+		for (int32 i = 0; i < NumPoints; i++)
+		{
+			Resident.Points[i] = FVector(Shell->Points[i]);
+			Resident.Normals[i] = FVector(Shell->Normals[i]);
+		}
+		Resident.Areas = Shell->Areas;
+		Resident.Clusters = Shell->Clusters;
+
+		MaxClusters = FMath::Max(MaxClusters, Resident.Clusters.Num());
+	}
+
+	{
+		FScopeLock ShellLock(&ProbeShellLock);
+		ResidentShells = MoveTemp(NewShells);
+		AppliedToolIndex = INDEX_NONE;
+
+		// 按最大的簇数预留，之后换刀时 ContactCache.Reset 不会重新分配
+		ContactCache.ClusterClearance.Reserve(MaxClusters);
+
+		// 当前刀具的点壳立即生效
+		SyncActiveTool();
+	}
+	UpdateVisualToolMesh();
+
+	UE_LOG(LogTemp, Log, TEXT("HapticProbe: Preloaded point shells for %d tools."), NumTools);
+}
+
+void UHapticProbeComponent::SyncActiveTool()
+{
+	if (!ToolLibrary || ResidentShells.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 ToolIndex = ToolLibrary->GetActiveToolIndex();
+	if (ToolIndex == AppliedToolIndex || !ResidentShells.IsValidIndex(ToolIndex))
+	{
+		return;
+	}
+
+	// 旧刀具的数据放回常驻表，新刀具的数据移入 (只交换数组指针)
+	if (ResidentShells.IsValidIndex(AppliedToolIndex))
+	{
+		FResidentProbeShell& Previous = ResidentShells[AppliedToolIndex];
+		Previous.Points = MoveTemp(LocalSamplePoints);
+		Previous.Normals = MoveTemp(LocalSampleNormals);
+		Previous.Areas = MoveTemp(LocalSampleAreas);
+		Previous.Clusters = MoveTemp(LocalClusters);
+	}
+
+	FResidentProbeShell& Next = ResidentShells[ToolIndex];
+	LocalSamplePoints = MoveTemp(Next.Points);
+	LocalSampleNormals = MoveTemp(Next.Normals);
+	LocalSampleAreas = MoveTemp(Next.Areas);
+	LocalClusters = MoveTemp(Next.Clusters);
+	AppliedToolIndex = ToolIndex;
 
-	UE_LOG(LogTemp, Log, TEXT("Generated %d sample points for probe."), LocalSamplePoints.Num());
+	// 探针形状变化后旧缓存和代理点失效
+	ContactCache.Reset(LocalClusters.Num());
+	bProxyValid = false;
 }
 
+void UHapticProbeComponent::ApplyPointShell(const FProbePointShell& Shell)
+{
+	const int32 NumPoints = Shell.Num();
+
+	// 在锁外转换，只在替换时持有 ProbeShellLock
+	TArray<FVector> Points;
+	TArray<FVector> Normals;
+	Points.SetNumUninitialized(NumPoints);
+	Normals.SetNumUninitialized(NumPoints);
+
+	for (int32 i = 0; i < NumPoints; i++)
+	{
+		Points[i] = FVector(Shell.Points[i]);
+		Normals[i] = FVector(Shell.Normals[i]);
+	}
+
+	TArray<float> Areas = Shell.Areas;
+	TArray<FProbePointCluster> Clusters = Shell.Clusters;
+
+	FScopeLock ShellLock(&ProbeShellLock);
+	LocalSamplePoints = MoveTemp(Points);
+	LocalSampleNormals = MoveTemp(Normals);
+	LocalSampleAreas = MoveTemp(Areas);
+	LocalClusters = MoveTemp(Clusters);
 
-void UHapticProbeComponent::GenerateUniformSurfacePoints(const UStaticMesh* Mesh, float Density)
+	// 点壳变化后旧缓存失效
+	ContactCache.Reset(LocalClusters.Num());
+}
+
+
+void UHapticProbeComponent::GenerateUniformSurfacePoints(const UStaticMesh* Mesh, float Density, FProbePointShell& OutShell)
 {	
+	OutShell.Reset();
+
     if (!Mesh || !Mesh->GetRenderData() || Mesh->GetRenderData()->LODResources.Num() == 0)
     {
         return ;
     }
-	
-	LocalSamplePoints.Reset();
 
     // 获取 LOD0 数据
     const FStaticMeshLODResources& LODModel = Mesh->GetRenderData()->LODResources[0];
@@ -408,7 +1044,8 @@ void UHapticProbeComponent::GenerateUniformSurfacePoints(const UStaticMesh* Mesh
 
 	if (TargetCount > 0)
 	{
-		LocalSamplePoints.Reserve(TargetCount);
+		OutShell.Points.Reserve(TargetCount);
+		OutShell.Normals.Reserve(TargetCount);
 	}
 	
     // 3. 生成候选点 (Oversampling)
@@ -417,6 +1054,9 @@ void UHapticProbeComponent::GenerateUniformSurfacePoints(const UStaticMesh* Mesh
     int32 NumCandidates = TargetCount * 10; 
     TArray<FVector> Candidates;
     Candidates.Reserve(NumCandidates);
+    // 候选点来源三角形，用于输出法线
+    TArray<int32> CandidateTriangles;
+    CandidateTriangles.Reserve(NumCandidates);
 
     // 使用 "累积器" 算法来分配候选点，完美解决小三角形和低密度问题
     double CurrentAreaAccumulator = 0.0;
@@ -439,6 +1079,7 @@ void UHapticProbeComponent::GenerateUniformSurfacePoints(const UStaticMesh* Mesh
             
             // 虚幻内置的重心坐标随机采样
             Candidates.Add(GetRandomPointInTriangle(V0, V1, V2));
+            CandidateTriangles.Add(i);
 
             // 推进阈值
             CurrentThreshold += AreaStep;
@@ -457,20 +1098,25 @@ void UHapticProbeComponent::GenerateUniformSurfacePoints(const UStaticMesh* Mesh
     for (int32 i = 0; i <= LastIndex; ++i)
     {
         int32 Index = FMath::RandRange(i, LastIndex);
-        if (i != Index) Candidates.Swap(i, Index);
+        if (i != Index)
+        {
+            Candidates.Swap(i, Index);
+            CandidateTriangles.Swap(i, Index);
+        }
     }
 
     // 筛选
-    for (const FVector& Cand : Candidates)
+    for (int32 CandIndex = 0; CandIndex < Candidates.Num(); CandIndex++)
     {
         // 如果已经凑够了，停止
-        if (LocalSamplePoints.Num() >= TargetCount) break;
+        if (OutShell.Points.Num() >= TargetCount) break;
 
+        const FVector3f Cand = FVector3f(Candidates[CandIndex]);
         bool bTooClose = false;
 
-        for (const FVector& Existing : LocalSamplePoints)
+        for (const FVector3f& Existing : OutShell.Points)
         {
-            if (FVector::DistSquared(Cand, Existing) < RejectDistSq)
+            if (FVector3f::DistSquared(Cand, Existing) < RejectDistSq)
             {
                 bTooClose = true;
                 break;
@@ -479,9 +1125,19 @@ void UHapticProbeComponent::GenerateUniformSurfacePoints(const UStaticMesh* Mesh
 
         if (!bTooClose)
         {
-            LocalSamplePoints.Add(Cand);
+            const int32 TriIndex = CandidateTriangles[CandIndex];
+            const FVector3f V0 = VertexBuffer.VertexPosition(IndexBuffer.GetIndex(TriIndex * 3 + 0));
+            const FVector3f V1 = VertexBuffer.VertexPosition(IndexBuffer.GetIndex(TriIndex * 3 + 1));
+            const FVector3f V2 = VertexBuffer.VertexPosition(IndexBuffer.GetIndex(TriIndex * 3 + 2));
+
+            OutShell.Points.Add(Cand);
+            OutShell.Normals.Add(FVector3f::CrossProduct(V1 - V0, V2 - V0).GetSafeNormal());
         }
     }
+
+    // 5. 每个点平均分摊总面积
+    const float AreaPerPoint = OutShell.Points.Num() > 0 ? (float)(TotalArea / OutShell.Points.Num()) : 0.0f;
+    OutShell.Areas.Init(AreaPerPoint, OutShell.Points.Num());
 }
 
 FVector UHapticProbeComponent::GetRandomPointInTriangle(const FVector& A, const FVector& B, const FVector& C)
@@ -506,5 +1162,25 @@ void UHapticProbeComponent::TickComponent(float DeltaTime, ELevelTick TickType,
                                           FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UpdateVisualToolMesh();
+}
+
+void UHapticProbeComponent::UpdateVisualToolMesh()
+{
+	// 换刀后在游戏线程更新显示网格 (点壳由触觉线程在 CalculateForce 中切换)
+	if (ToolLibrary && ProbeMeshComp)
+	{
+		const int32 ToolIndex = ToolLibrary->GetActiveToolIndex();
+		if (ToolIndex != VisualToolIndex)
+		{
+			const FSDFToolLibraryEntry* Tool = ToolLibrary->GetTool(ToolIndex);
+			if (Tool && Tool->Mesh)
+			{
+				ProbeMeshComp->SetStaticMesh(Tool->Mesh);
+			}
+			VisualToolIndex = ToolIndex;
+		}
+	}
 }
 
@@ -0,0 +1,243 @@
+// ProbePointShell.cpp
+
+#include "ProbePointShell.h"
+#include "SDFCacheFile.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+#include "Hash/xxhash.h"
+#include "Misc/ScopeLock.h"
+#include "Algo/Sort.h"
+
+namespace ProbePointShellCache
+{
+	// 文件格式: [Header][NumPoints][Points][Normals][Areas]
+	constexpr uint32 Magic = 0x50534853; // 'PSHS'
+	constexpr uint32 Version = 1;
+	const TCHAR* Category = TEXT("ProbeShells");
+
+	FCriticalSection MemoryCacheLock;
+	TMap<uint64, FProbePointShellPtr> MemoryCache;
+}
+
+void FProbePointShell::BuildClusters(int32 MaxLeafPoints)
+{
+	Clusters.Reset();
+
+	const int32 NumPoints = Points.Num();
+	if (NumPoints == 0)
+	{
+		return;
+	}
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(NumPoints);
+	for (int32 i = 0; i < NumPoints; i++)
+	{
+		Order[i] = i;
+	}
+
+	// 节点数上限约为 2 * (N / MaxLeafPoints)
+	Clusters.Reserve(2 * FMath::DivideAndRoundUp(NumPoints, FMath::Max(MaxLeafPoints, 1)));
+	BuildClusterRecursive(Order, 0, NumPoints, FMath::Max(MaxLeafPoints, 1));
+
+	// 按构建顺序重排点数据，使叶子节点的点在内存中连续
+	TArray<FVector3f> SortedPoints;
+	TArray<FVector3f> SortedNormals;
+	TArray<float> SortedAreas;
+	SortedPoints.SetNumUninitialized(NumPoints);
+	SortedNormals.SetNumUninitialized(NumPoints);
+	SortedAreas.SetNumUninitialized(NumPoints);
+
+	for (int32 i = 0; i < NumPoints; i++)
+	{
+		SortedPoints[i] = Points[Order[i]];
+		SortedNormals[i] = Normals.IsValidIndex(Order[i]) ? Normals[Order[i]] : FVector3f::ZeroVector;
+		SortedAreas[i] = Areas.IsValidIndex(Order[i]) ? Areas[Order[i]] : 0.0f;
+	}
+
+	Points = MoveTemp(SortedPoints);
+	Normals = MoveTemp(SortedNormals);
+	Areas = MoveTemp(SortedAreas);
+}
+
+int32 FProbePointShell::BuildClusterRecursive(TArray<int32>& Order, int32 First, int32 Count, int32 MaxLeafPoints)
+{
+	// 1. 计算包围盒
+	FBox3f Bounds(ForceInit);
+	for (int32 i = First; i < First + Count; i++)
+	{
+		Bounds += Points[Order[i]];
+	}
+
+	const int32 NodeIndex = Clusters.AddDefaulted();
+	{
+		FProbePointCluster& Node = Clusters[NodeIndex];
+		Node.Center = Bounds.GetCenter();
+		Node.FirstPoint = First;
+		Node.NumPoints = Count;
+
+		// 2. 包围球半径 = 中心到最远点的距离
+		float MaxDistSq = 0.0f;
+		for (int32 i = First; i < First + Count; i++)
+		{
+			MaxDistSq = FMath::Max(MaxDistSq, FVector3f::DistSquared(Node.Center, Points[Order[i]]));
+		}
+		Node.Radius = FMath::Sqrt(MaxDistSq);
+	}
+
+	if (Count <= MaxLeafPoints)
+	{
+		return NodeIndex;
+	}
+
+	// 3. 沿最长轴按中位数二分
+	const FVector3f Extent = Bounds.GetSize();
+	const int32 Axis = (Extent.X >= Extent.Y && Extent.X >= Extent.Z) ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+
+	TArrayView<int32> Range(Order.GetData() + First, Count);
+	Algo::Sort(Range, [this, Axis](int32 A, int32 B)
+	{
+		return Points[A][Axis] < Points[B][Axis];
+	});
+
+	const int32 HalfCount = Count / 2;
+	const int32 FirstChild = BuildClusterRecursive(Order, First, HalfCount, MaxLeafPoints);
+	const int32 SecondChild = BuildClusterRecursive(Order, First + HalfCount, Count - HalfCount, MaxLeafPoints);
+
+	// 递归过程中 Clusters 可能扩容，重新取引用
+	Clusters[NodeIndex].FirstChild = FirstChild;
+	Clusters[NodeIndex].SecondChild = SecondChild;
+
+	return NodeIndex;
+}
+
+uint64 FProbePointShellCache::MakeKey(const UStaticMesh* Mesh, float Density, float MinSpacing)
+{
+	FXxHash64Builder Builder;
+
+	// 内容键：LOD0 的顶点坐标 + 三角形索引 (与采样读取的数据相同，重新导入后内容变化即失效)
+	if (Mesh && Mesh->GetRenderData() && Mesh->GetRenderData()->LODResources.Num() > 0)
+	{
+		const FStaticMeshLODResources& LODModel = Mesh->GetRenderData()->LODResources[0];
+		const FPositionVertexBuffer& VertexBuffer = LODModel.VertexBuffers.PositionVertexBuffer;
+		const FRawStaticIndexBuffer& IndexBuffer = LODModel.IndexBuffer;
+
+		const int32 NumVertices = VertexBuffer.GetNumVertices();
+		for (int32 i = 0; i < NumVertices; i++)
+		{
+			const FVector3f& Position = VertexBuffer.VertexPosition(i);
+			Builder.Update(&Position, sizeof(FVector3f));
+		}
+
+		const int32 NumIndices = IndexBuffer.GetNumIndices();
+		for (int32 i = 0; i < NumIndices; i++)
+		{
+			const uint32 Index = IndexBuffer.GetIndex(i);
+			Builder.Update(&Index, sizeof(uint32));
+		}
+	}
+
+	// 采样参数
+	Builder.Update(&Density, sizeof(Density));
+	Builder.Update(&MinSpacing, sizeof(MinSpacing));
+
+	return Builder.Finalize().Hash;
+}
+
+FProbePointShellPtr FProbePointShellCache::Find(uint64 Key)
+{
+	{
+		FScopeLock Lock(&ProbePointShellCache::MemoryCacheLock);
+		if (const FProbePointShellPtr* Found = ProbePointShellCache::MemoryCache.Find(Key))
+		{
+			return *Found;
+		}
+	}
+
+	TSharedPtr<FProbePointShell, ESPMode::ThreadSafe> Loaded = MakeShared<FProbePointShell, ESPMode::ThreadSafe>();
+	if (!LoadFromDisk(Key, *Loaded))
+	{
+		return nullptr;
+	}
+
+	// 磁盘缓存只保存点数据，包围球层次结构在加载后重建
+	Loaded->BuildClusters();
+
+	FScopeLock Lock(&ProbePointShellCache::MemoryCacheLock);
+	ProbePointShellCache::MemoryCache.Add(Key, Loaded);
+	return Loaded;
+}
+
+void FProbePointShellCache::Store(uint64 Key, const FProbePointShellPtr& Shell)
+{
+	if (!Shell.IsValid() || Shell->IsEmpty())
+	{
+		return;
+	}
+
+	{
+		FScopeLock Lock(&ProbePointShellCache::MemoryCacheLock);
+		ProbePointShellCache::MemoryCache.Add(Key, Shell);
+	}
+
+	SaveToDisk(Key, *Shell);
+}
+
+void FProbePointShellCache::ClearMemoryCache()
+{
+	FScopeLock Lock(&ProbePointShellCache::MemoryCacheLock);
+	ProbePointShellCache::MemoryCache.Empty();
+}
+
+bool FProbePointShellCache::LoadFromDisk(uint64 Key, FProbePointShell& OutShell)
+{
+	const FString FilePath = FSDFCacheFile::GetCachePath(ProbePointShellCache::Category, Key);
+
+	return FSDFCacheFile::ReadMapped(FilePath, ProbePointShellCache::Magic, ProbePointShellCache::Version, Key,
+		[&OutShell](const uint8* Data, int64 Size) -> bool
+		{
+			if (Size < (int64)sizeof(int32))
+			{
+				return false;
+			}
+
+			int32 NumPoints = 0;
+			FMemory::Memcpy(&NumPoints, Data, sizeof(int32));
+			Data += sizeof(int32);
+
+			const int64 ExpectedSize = sizeof(int32) + (int64)NumPoints * (sizeof(FVector3f) * 2 + sizeof(float));
+			if (NumPoints <= 0 || Size != ExpectedSize)
+			{
+				return false;
+			}
+
+			// 直接从映射内存拷贝到数组
+			OutShell.Points.SetNumUninitialized(NumPoints);
+			FMemory::Memcpy(OutShell.Points.GetData(), Data, NumPoints * sizeof(FVector3f));
+			Data += NumPoints * sizeof(FVector3f);
+
+			OutShell.Normals.SetNumUninitialized(NumPoints);
+			FMemory::Memcpy(OutShell.Normals.GetData(), Data, NumPoints * sizeof(FVector3f));
+			Data += NumPoints * sizeof(FVector3f);
+
+			OutShell.Areas.SetNumUninitialized(NumPoints);
+			FMemory::Memcpy(OutShell.Areas.GetData(), Data, NumPoints * sizeof(float));
+
+			return true;
+		});
+}
+
+bool FProbePointShellCache::SaveToDisk(uint64 Key, const FProbePointShell& Shell)
+{
+	const FString FilePath = FSDFCacheFile::GetCachePath(ProbePointShellCache::Category, Key);
+
+	return FSDFCacheFile::Write(FilePath, ProbePointShellCache::Magic, ProbePointShellCache::Version, Key,
+		[&Shell](FArchive& Ar)
+		{
+			int32 NumPoints = Shell.Num();
+			Ar.Serialize(&NumPoints, sizeof(int32));
+			Ar.Serialize(const_cast<FVector3f*>(Shell.Points.GetData()), NumPoints * sizeof(FVector3f));
+			Ar.Serialize(const_cast<FVector3f*>(Shell.Normals.GetData()), NumPoints * sizeof(FVector3f));
+			Ar.Serialize(const_cast<float*>(Shell.Areas.GetData()), NumPoints * sizeof(float));
+		});
+}
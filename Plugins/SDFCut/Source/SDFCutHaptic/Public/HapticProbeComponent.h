@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/SceneComponent.h"
 #include "SDFVolumeProvider.h"
+#include "ProbePointShell.h"
 #include "GameFramework/Actor.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
@@ -14,14 +15,69 @@
 #include "Rendering/StaticMeshVertexBuffer.h" 
 #include "HapticProbeComponent.generated.h"
 
+class USDFToolLibrary;
+
 // 辅助结构体：仅存储用于决策的几何信息
 struct FGeoSampleData
 {
 	FVector Gradient; // SDF梯度 (法线)
 	float Depth;      // SDF深度
+	int32 MaterialID; // 最近体素的材质 ID (G 通道)
 	bool bIsValid;    // 是否命中
 };
 
+// 力反馈渲染模式
+UENUM(BlueprintType)
+enum class EHapticRenderMode : uint8
+{
+	Penalty,   // 罚函数：力 = 刚度 * 穿透深度，需要很高的刷新率才能稳定
+	GodObject  // 虚拟耦合：代理点约束在 SDF 表面外，通过弹簧阻尼与设备位置耦合
+};
+
+// 时间相干性缓存：保存上一次查询的结果，用于下一次热启动
+// 相邻两次查询 (1kHz) 之间探针只移动极小距离，大部分结果可以直接复用
+struct FHapticContactCache
+{
+	bool bValid = false;
+
+	// 上一次探针相对于 SDF 局部空间的位姿 (目标物体移动时同样有效)
+	FTransform LastProbeToTarget;
+
+	// 自缓存建立以来的累计运动量上界 (世界单位)
+	float AccumulatedMotion = 0.0f;
+
+	// 每个簇被剔除时记录的 (与表面的间隙 + 当时的累计运动量)
+	// 当累计运动量超过该值时，簇可能已接触表面，需要重新采样；-1 表示必须重新采样
+	TArray<float> ClusterClearance;
+
+	// 上一次的表面接触点 (SDF 局部空间)
+	bool bHasSurfaceHit = false;
+	FVector LastSurfaceHitLocal = FVector::ZeroVector;
+
+	void Reset(int32 NumClusters)
+	{
+		bValid = false;
+		AccumulatedMotion = 0.0f;
+		// 不收缩已有内存：换刀时在触觉线程调用，预留足够容量后不会重新分配
+		ClusterClearance.SetNumUninitialized(NumClusters, EAllowShrinking::No);
+		for (float& Clearance : ClusterClearance)
+		{
+			Clearance = -1.0f;
+		}
+		bHasSurfaceHit = false;
+	}
+};
+
+// 刀具库中一把刀具的常驻点壳 (已转换为 CalculateForce 使用的格式)
+// 换刀时与探针当前的采样数据整体交换 (移动数组指针，不复制、不分配)
+struct FResidentProbeShell
+{
+	TArray<FVector> Points;
+	TArray<FVector> Normals;
+	TArray<float> Areas;
+	TArray<FProbePointCluster> Clusters;
+};
+
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class SDFCUTHAPTIC_API UHapticProbeComponent : public USceneComponent
@@ -48,10 +104,47 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Haptics")
 	float SamplingMinSpacing = 0.75f;
 
+	// 是否使用点壳缓存 (相同网格+采样参数直接读取缓存，不重新采样)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Haptics")
+	bool bUsePointShellCache = true;
+
+	// 是否使用包围球层次结构剔除远离表面的采样点
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Haptics")
+	bool bUseClusterCulling = true;
+
+	// 是否利用上一次查询结果热启动 (复用远离表面的簇、投影上一次的接触点)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Haptics")
+	bool bUseWarmStart = true;
+
+	// 单次查询间运动量超过该值 (世界单位) 时丢弃缓存，执行完整查询
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Haptics", meta=(EditCondition="bUseWarmStart", ClampMin="0.0"))
+	float WarmStartMaxMotion = 0.5f;
+
+	// 常驻刀具库：设置后 BeginPlay 时为每把刀具预先生成点壳，
+	// 之后换刀只需修改库的 ActiveToolIndex (可在触觉线程调用)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Haptics|Tool")
+	USDFToolLibrary* ToolLibrary = nullptr;
+
 	
 	// --- 物理参数 ---
 	UPROPERTY(EditAnywhere, Category = "Haptics")
 	float BaseStiffness = 1.0f;
+
+	// 力反馈渲染模式
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Haptics")
+	EHapticRenderMode RenderMode = EHapticRenderMode::Penalty;
+
+	// 虚拟耦合弹簧刚度 (代理点与设备之间)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Haptics|GodObject", meta=(EditCondition="RenderMode==EHapticRenderMode::GodObject"))
+	float CouplingStiffness = 1.0f;
+
+	// 虚拟耦合阻尼 (作用于代理点与设备的相对速度)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Haptics|GodObject", meta=(EditCondition="RenderMode==EHapticRenderMode::GodObject"))
+	float CouplingDamping = 0.01f;
+
+	// 每次更新代理点时最多处理的约束平面数 (沿表面滑动的次数)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Haptics|GodObject", meta=(EditCondition="RenderMode==EHapticRenderMode::GodObject", ClampMin="1"))
+	int32 MaxProxyIterations = 3;
 	
 	// 计算反馈力 (可以在 Haptic 线程调用)
 	// 返回 true 如果产生了碰撞
@@ -66,14 +159,40 @@ public:
 	 * @return 是否成功找到表面
 	 */
 	bool FindSurfacePointFromRay(const FVector& StartPoint, const FVector& EndPoint, FVector& OutSurfacePoint);
+
+	/**
+	 * 热启动的表面查找：取射线上距上一次接触点最近的点，沿 SDF 梯度投影回表面
+	 * 运动很小时只需 1~2 次采样，失败时由调用方回退到 FindSurfacePointFromRay
+	 * @param PrevSurfacePoint 上一次的表面接触点 (世界坐标)
+	 */
+	bool ProjectPreviousSurfacePoint(const FVector& StartPoint, const FVector& EndPoint, const FVector& PrevSurfacePoint, FVector& OutSurfacePoint);
+
+	// 上一次接触按材质混合后的刚度系数 (无接触时为 1)
+	UFUNCTION(BlueprintPure, Category = "Haptics|Material")
+	float GetContactStiffnessScale() const { return LastContactStiffnessScale; }
+
+	// 上一次接触按材质混合后的切削阻力 (无接触时为 0)
+	UFUNCTION(BlueprintPure, Category = "Haptics|Material")
+	float GetContactCutResistance() const { return LastContactCutResistance; }
+
+	// 获取虚拟耦合模式下代理点的世界坐标 (未初始化时返回探针位置)
+	UFUNCTION(BlueprintPure, Category = "Haptics|GodObject")
+	FVector GetProxyLocation() const;
 	
 	/**
-	 * 根据静态网格更新探针形状
+	 * 根据静态网格更新探针形状 (设置了刀具库时不生效，探针形状由当前刀具决定)
 	 * @param NewMesh        要采样的网格
 	 * @param PointDensity   采样密度 (点数 / 平方厘米)，建议值 10~50
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Haptics")
 	void UpdateProbeMesh();
+
+	/**
+	 * 为刀具库中的所有刀具准备常驻点壳，并应用当前刀具 (BeginPlay 中自动调用)
+	 * 采样在锁外进行，只有替换常驻点壳时短暂持有 ProbeShellLock，触觉线程运行时也可以调用
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Haptics|Tool")
+	void PreloadToolLibrary();
 	
 	// 调试用的属性----------
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Haptics|Debug")
@@ -100,9 +219,37 @@ protected:
 	/**
 	 * @param Mesh          目标网格资源
 	 * @param Density       采样密度 (点/平方厘米)。例如 0.01 代表每 100cm² 一个点。
-	 * @param MinSpacing    最小间距系数 (0.0~1.0)。值越大分布越均匀，但如果太大可能导致点数不足。推荐 0.75
+	 * @param OutShell      输出点壳 (位置、法线、面积)，最小间距系数使用 SamplingMinSpacing
 	 */
-	void GenerateUniformSurfacePoints(const UStaticMesh* Mesh, float Density);
+	void GenerateUniformSurfacePoints(const UStaticMesh* Mesh, float Density, FProbePointShell& OutShell);
+
+	// 虚拟耦合模式：更新代理点并计算耦合力，在 CalculateForce 内部调用
+	bool CalculateGodObjectForce(FVector& OutForce, FVector& OutTorque);
+
+	// 代理点从 From 向 To 移动，遇到表面 (SDF 由正变负) 时停在表面上，返回是否被阻挡
+	bool TraceProxy(const FVector& From, const FVector& To, FVector& OutPosition) const;
+
+	// 采样世界坐标处的 SDF (世界单位) 和表面法线 (世界空间)，在体积外返回 false
+	bool SampleSurface(const FVector& WorldPos, float& OutDistance, FVector& OutNormal) const;
+
+	// 体素坐标处的 SDF 梯度 (中心差分，步长 1 体素，SDF 局部空间，未归一化)
+	FVector SampleGradient(const FVector& VoxelCoord) const;
+
+	// 将点壳数据应用到当前探针
+	void ApplyPointShell(const FProbePointShell& Shell);
+
+	// 查找探针的 StaticMeshComponent (VisualMeshRef 或 Owner 上的第一个)
+	bool ResolveProbeMeshComponent();
+
+	// 读取点壳缓存，未命中时重新采样并写入缓存
+	FProbePointShellPtr GetOrBuildPointShell(const UStaticMesh* MeshAsset);
+
+	// 刀具库的当前刀具变化时换入对应的常驻点壳 (在 CalculateForce 开头调用，不分配内存)
+	// 调用方需持有 ProbeShellLock
+	void SyncActiveTool();
+
+	// 刀具库的当前刀具变化时更换显示网格 (游戏线程)
+	void UpdateVisualToolMesh();
 	
 	
 	// 辅助：在三角形ABC内部生成一个随机点
@@ -112,14 +259,70 @@ protected:
 	ISDFVolumeProvider* SDFProvider = nullptr;
 	
 
-	// 材质刚度系数表 (对应 G 通道的 ID)
-	UPROPERTY(VisibleAnywhere, Category = "Haptics|Material")
-	TMap<int32, float> MaterialStiffnessScales;
+	// 材质刚度系数表 (按 EVolumeMaterial 索引，对应 G 通道的 ID)
+	UPROPERTY(EditAnywhere, Category = "Haptics|Material")
+	float MaterialStiffnessScales[NumVolumeMaterials] = {
+		1.0f, // 牙釉质 (硬)
+		0.6f, // 牙本质 (中)
+		0.2f, // 龋坏 (软)
+		0.8f  // 填充物(较硬)
+	};
+
+	// 材质切削阻力系数表 (按 EVolumeMaterial 索引)
+	UPROPERTY(EditAnywhere, Category = "Haptics|Material")
+	float MaterialCutResistance[NumVolumeMaterials] = {
+		1.0f,  // 牙釉质
+		0.5f,  // 牙本质
+		0.15f, // 龋坏
+		0.8f   // 填充物
+	};
+
+	// 查表 (越界 ID 归到最近的有效材质)
+	float GetStiffnessScale(int32 MaterialID) const { return MaterialStiffnessScales[FMath::Clamp(MaterialID, 0, NumVolumeMaterials - 1)]; }
+	float GetCutResistance(int32 MaterialID) const { return MaterialCutResistance[FMath::Clamp(MaterialID, 0, NumVolumeMaterials - 1)]; }
+
+	// 上一次接触的混合结果
+	float LastContactStiffnessScale = 1.0f;
+	float LastContactCutResistance = 0.0f;
 
 	// --- 内部数据 ---
 	// 采样点 (相对于组件的局部坐标)
 	TArray<FVector> LocalSamplePoints;
 
+	// 采样点法线 (局部坐标)，与 LocalSamplePoints 一一对应
+	TArray<FVector> LocalSampleNormals;
+
+	// 每个采样点代表的表面积，与 LocalSamplePoints 一一对应
+	TArray<float> LocalSampleAreas;
+
+	// 采样点的包围球层次结构 (局部坐标)，LocalClusters[0] 为根节点
+	TArray<FProbePointCluster> LocalClusters;
+
+	// 上一次查询的缓存 (只在 CalculateForce 中读写)
+	FHapticContactCache ContactCache;
+
+	// 保护 LocalSample* / LocalClusters / ResidentShells / AppliedToolIndex / ContactCache：
+	// CalculateForce (触觉线程) 全程持有；游戏线程只在替换点壳数据时短暂持有，不在锁内采样
+	FCriticalSection ProbeShellLock;
+
+	// --- 虚拟耦合状态 ---
+	bool bProxyValid = false;
+	// 代理点位置 (SDF 局部空间，目标物体移动时代理随之移动)
+	FVector ProxyLocationLocal = FVector::ZeroVector;
+	// 上一次的耦合弹簧伸长量 (用于计算阻尼)
+	FVector LastCouplingOffset = FVector::ZeroVector;
+	double LastCouplingTime = 0.0;
+
+	// --- 刀具库 ---
+	// 每把刀具的常驻点壳，当前刀具的数据已移动到 LocalSample* 中 (该项为空)
+	TArray<FResidentProbeShell> ResidentShells;
+
+	// 当前 LocalSample* 对应的刀具 (持有 ProbeShellLock 时读写)
+	int32 AppliedToolIndex = INDEX_NONE;
+
+	// 当前显示网格对应的刀具 (只在游戏线程读写)
+	int32 VisualToolIndex = INDEX_NONE;
+
 public:
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
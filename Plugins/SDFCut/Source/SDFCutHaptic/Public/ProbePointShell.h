@@ -0,0 +1,91 @@
+// ProbePointShell.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+
+/**
+ * 点壳包围球层次结构的节点
+ * 叶子节点 (FirstChild == INDEX_NONE) 覆盖 [FirstPoint, FirstPoint + NumPoints) 范围的采样点
+ */
+struct FProbePointCluster
+{
+	FVector3f Center = FVector3f::ZeroVector;
+	float Radius = 0.0f;
+
+	int32 FirstChild = INDEX_NONE;
+	int32 SecondChild = INDEX_NONE;
+
+	int32 FirstPoint = 0;
+	int32 NumPoints = 0;
+
+	bool IsLeaf() const { return FirstChild == INDEX_NONE; }
+};
+
+/**
+ * 探针点壳 (Point Shell)：探针表面的均匀采样点
+ * 所有数据都在探针 MeshComponent 的局部空间
+ */
+struct SDFCUTHAPTIC_API FProbePointShell
+{
+	// 采样点位置
+	TArray<FVector3f> Points;
+
+	// 采样点所在三角形的法线
+	TArray<FVector3f> Normals;
+
+	// 每个采样点代表的表面积
+	TArray<float> Areas;
+
+	// 包围球层次结构，Clusters[0] 为根节点 (调用 BuildClusters 后有效)
+	TArray<FProbePointCluster> Clusters;
+
+	int32 Num() const { return Points.Num(); }
+	bool IsEmpty() const { return Points.Num() == 0; }
+
+	void Reset()
+	{
+		Points.Reset();
+		Normals.Reset();
+		Areas.Reset();
+		Clusters.Reset();
+	}
+
+	/**
+	 * 构建包围球层次结构 (沿最长轴中位数二分)
+	 * 会重新排列 Points/Normals/Areas，使每个节点覆盖连续的一段点
+	 * @param MaxLeafPoints 叶子节点最多包含的点数
+	 */
+	void BuildClusters(int32 MaxLeafPoints = 16);
+
+private:
+	int32 BuildClusterRecursive(TArray<int32>& Order, int32 First, int32 Count, int32 MaxLeafPoints);
+};
+
+typedef TSharedPtr<const FProbePointShell, ESPMode::ThreadSafe> FProbePointShellPtr;
+
+/**
+ * 点壳缓存
+ * 键 = (StaticMesh 标识, SamplingDensity, SamplingMinSpacing)
+ * 先查进程内缓存，再查磁盘上的二进制缓存 (内存映射读取)，都没有时才重新采样。
+ */
+class SDFCUTHAPTIC_API FProbePointShellCache
+{
+public:
+	// 生成缓存键 (LOD0 顶点坐标与索引的 xxhash64 + 采样参数)
+	static uint64 MakeKey(const UStaticMesh* Mesh, float Density, float MinSpacing);
+
+	// 查找缓存，未命中返回 nullptr
+	static FProbePointShellPtr Find(uint64 Key);
+
+	// 写入缓存 (内存 + 磁盘)
+	static void Store(uint64 Key, const FProbePointShellPtr& Shell);
+
+	// 清空进程内缓存 (磁盘缓存保留)
+	static void ClearMemoryCache();
+
+private:
+	static bool LoadFromDisk(uint64 Key, FProbePointShell& OutShell);
+	static bool SaveToDisk(uint64 Key, const FProbePointShell& Shell);
+};
@@ -2,6 +2,8 @@
 
 #include "DynamicMesh/MeshTransforms.h"
 #include "Spatial/FastWinding.h"
+#include "SDFGridGenerator.h"
+#include "Util/ProgressCancel.h"
 
 UE_DISABLE_OPTIMIZATION
 using namespace UE::Geometry;
@@ -105,12 +107,12 @@ void FMaVoxelData::Reset()
 	OctreeRoot = FOctreeNode();
 }
 
-void FMaVoxelData::BuildOctreeFromMesh(const FDynamicMesh3& Mesh, const FTransform& Transform)
+bool FMaVoxelData::BuildOctreeFromMesh(const FDynamicMesh3& Mesh, const FTransform& Transform, FProgressCancel* Progress)
 {
 	if (Mesh.TriangleCount() == 0) 
     {
         UE_LOG(LogTemp, Warning, TEXT("BuildOctreeFromMesh: Mesh has no triangles"));
-        return;
+        return false;
     }
     
     double StartTime = FPlatformTime::Seconds();
@@ -132,6 +134,43 @@ void FMaVoxelData::BuildOctreeFromMesh(const FDynamicMesh3& Mesh, const FTransfo
     MeshTransforms::ApplyTransform(WorldSpaceMesh, Transform, true);
     FDynamicMeshAABBTree3 Spatial(&WorldSpaceMesh);    
     TFastWindingTree<FDynamicMesh3> Winding(&Spatial);
+
+    // 八叉树按深度均匀细分，叶子中心构成规则网格：先按行奇偶一次算出所有叶子的内外，
+    // 只有碰到开放边界的行才逐点 Fast Winding
+    int32 LeafDepth = 0;
+    FVector3d LeafSize = OctreeRoot.Bounds.Max - OctreeRoot.Bounds.Min;
+    while (!(LeafSize.GetMin() <= MinVoxelSize || LeafDepth >= MaxOctreeDepth))
+    {
+        LeafSize *= 0.5;
+        LeafDepth++;
+    }
+
+    const int32 LeafCount = 1 << FMath::Min(LeafDepth, 30);
+    TArray<bool> LeafInside;
+    if (LeafCount <= MaxSignGridResolution)
+    {
+        FSDFGridDesc SignGrid;
+        SignGrid.Origin = OctreeRoot.Bounds.Min + LeafSize * 0.5;
+        SignGrid.Spacing = LeafSize;
+        SignGrid.Dimensions = FIntVector(LeafCount);
+
+        int32 NumFallbackRows = 0;
+        FSDFGridGenerator::ComputeInsideMask(WorldSpaceMesh, SignGrid, FSDFGridGenerator::FConfig(), LeafInside, &Winding, &NumFallbackRows);
+        UE_LOG(LogTemp, Log, TEXT("叶子内外判断: %d^3 采样, %d 行回退到 Fast Winding"), LeafCount, NumFallbackRows);
+    }
+
+    auto GetLeafInside = [&](const FVector3d& Center) -> const bool*
+    {
+        if (LeafInside.Num() == 0)
+        {
+            return nullptr;
+        }
+        const FVector3d Cell = (Center - OctreeRoot.Bounds.Min) / LeafSize;
+        const int32 X = FMath::Clamp(FMath::FloorToInt(Cell.X), 0, LeafCount - 1);
+        const int32 Y = FMath::Clamp(FMath::FloorToInt(Cell.Y), 0, LeafCount - 1);
+        const int32 Z = FMath::Clamp(FMath::FloorToInt(Cell.Z), 0, LeafCount - 1);
+        return &LeafInside[(Z * LeafCount + Y) * LeafCount + X];
+    };
     
     // 递归构建八叉树
     TFunction<void(FOctreeNode&)> BuildNode = [&](FOctreeNode& Node)
@@ -152,7 +191,7 @@ void FMaVoxelData::BuildOctreeFromMesh(const FDynamicMesh3& Mesh, const FTransfo
 
 
 			FVector3d WorldPos = Node.Bounds.Center();
-			float Distance = CalculateDistanceToMesh(Spatial, Winding, WorldPos);
+			float Distance = CalculateDistanceToMesh(Spatial, Winding, WorldPos, GetLeafInside(WorldPos));
 			Node.Voxel = Distance;
             
 			// 检查节点是否变为非空
@@ -166,6 +205,12 @@ void FMaVoxelData::BuildOctreeFromMesh(const FDynamicMesh3& Mesh, const FTransfo
         }
         else
         {
+            // 取消后不再细分，结果在最后丢弃
+            if (Progress && Progress->Cancelled())
+            {
+                return;
+            }
+
             // 需要继续细分
             Node.Subdivide(MinVoxelSize);
             for (FOctreeNode& Child : Node.Children)
@@ -186,12 +231,25 @@ void FMaVoxelData::BuildOctreeFromMesh(const FDynamicMesh3& Mesh, const FTransfo
         }
     };
     
+    if (Progress && Progress->Cancelled())
+    {
+        Reset();
+        return false;
+    }
+
     BuildNode(OctreeRoot);
+
+    if (Progress && Progress->Cancelled())
+    {
+        Reset();
+        return false;
+    }
     
     double EndTime = FPlatformTime::Seconds();
     UE_LOG(LogTemp, Warning, TEXT("八叉树构建耗时: %.2f 毫秒"), (EndTime - StartTime) * 1000.0);
 
     DebugLogOctreeStats();
+    return true;
 }
 
 float FMaVoxelData::GetValueAtPosition(const FVector3d& WorldPos) const
@@ -258,7 +316,7 @@ void FMaVoxelData::DebugLogOctreeStats() const
 }
 
 float FMaVoxelData::CalculateDistanceToMesh(const FDynamicMeshAABBTree3& Spatial,
-	TFastWindingTree<FDynamicMesh3>& Winding, const FVector3d& Pos) const
+	TFastWindingTree<FDynamicMesh3>& Winding, const FVector3d& Pos, const bool* bPrecomputedInside) const
 {    
     // 使用AABB树查找最近三角形
     double NearestDistSqr; 
@@ -270,8 +328,8 @@ float FMaVoxelData::CalculateDistanceToMesh(const FDynamicMeshAABBTree3& Spatial
     }
     double NearestDist = FMath::Sqrt(NearestDistSqr);
     
-    // 使用绕数法判断点在网格内部还是外部
-    bool bIsInside = Winding.IsInside(Pos);
+    // 优先使用预先按行计算的内外结果，否则用绕数法判断点在网格内部还是外部
+    bool bIsInside = bPrecomputedInside ? *bPrecomputedInside : Winding.IsInside(Pos);
     
     // 内部点距离为负，外部点距离为正
     float SignedDistance = bIsInside ? -NearestDist : NearestDist;
@@ -4,6 +4,10 @@
 #include "VoxelCutComponent.h"
 #include "DynamicMesh/MeshTransforms.h"
 #include "Engine/Engine.h"
+#include "SDFToolLibrary.h"
+#include "UDynamicMesh.h"
+#include "GeometryScript/MeshAssetFunctions.h"
+#include "Async/Async.h"
 
 
 UVoxelCutComponent::UVoxelCutComponent()
@@ -19,13 +23,35 @@ UVoxelCutComponent::UVoxelCutComponent()
 void UVoxelCutComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// 刀具库是共享资产，上一次 PIE 的换刀结果不能带到本次
+	if (ToolLibrary)
+	{
+		ToolLibrary->ResetActiveTool();
+	}
+}
+
+void UVoxelCutComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// 后台体素化只持有 CutOp 和共享状态，取消后自行结束，完成回调因 WeakSelf 失效或任务不匹配而被忽略
+	CancelInitialization();
+	ActiveInitJob.Reset();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 
 void UVoxelCutComponent::InitializeCutSystem()
 {
-	if (bSystemInitialized || !TargetMeshComponent || !CutToolMeshComponent)
+	if (bSystemInitialized || ActiveInitJob.IsValid() || !TargetMeshComponent || !CutToolMeshComponent)
+		return;
+
+	// 上一次被取消的初始化还有刀具SDF在计算，结束后才能重新开始
+	if (bIsPrecomputingSDF || NumPendingToolSDFs > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("上一次初始化的刀具SDF预计算尚未结束，稍后再初始化"));
 		return;
+	}
     
 	// 创建切削操作器（只创建一次）
 	if (!CutOp.IsValid())
@@ -59,35 +85,103 @@ void UVoxelCutComponent::InitializeCutSystem()
 	CutOp->bSmoothCutEdges = bSmoothEdges;
 	CutOp->SmoothingIteration = SmoothingIteration;
 	CutOp->SmoothingStrength = SmoothingStrength;
+	CutOp->bUseDualContouring = bUseDualContouring;
 	CutOp->bFillCutHole = bFillHoles;
 	CutOp->UpdateMargin = 5;
 	CutOp->MarchingCubeSize = MarchingCubeSize;
 	CutOp->MaxOctreeDepth = MaxOctreeDepth;
 	CutOp->MinVoxelSize = MinVoxelSize;
 	CutOp->CutToolMesh = CopyToolMesh();
+	CutOp->ToolShape = ToolShape;
+	CutOp->bCPUVolumeCut = bCPUToolSDFCut;
 	
     
+	// 目标体素化和刀具SDF两个阶段并行进行，全部结束后广播 OnCutSystemReady
+	TSharedPtr<FInitJob, ESPMode::ThreadSafe> Job = MakeShared<FInitJob, ESPMode::ThreadSafe>();
+	FInitJob* JobPtr = Job.Get();
+	Job->ProgressCancel.CancelF = [JobPtr]() { return JobPtr->bCancelRequested.load(); };
+	ActiveInitJob = Job;
+	NumPendingInitStages = 2;
+	bInitStageFailed = false;
+
 	// 初始化目标物体体素
 	UDynamicMesh* TargetDynamicMesh = TargetMeshComponent->GetDynamicMesh();
 	if (TargetDynamicMesh)
 	{
-		// 创建目标网格的副本（只做一次）
+		// 设置目标变换
+		CutOp->TargetTransform = TargetMeshComponent->GetComponentTransform();
+
+		// 在 GameThread 上复制目标网格（只做一次）：UDynamicMesh 不是线程安全的，
+		// 复制远比体素化便宜，后台任务只使用副本
 		CutOp->TargetMesh = MakeShared<FDynamicMesh3>();
 		TargetDynamicMesh->ProcessMesh([this](const FDynamicMesh3& SourceMesh)
 		{
 			CutOp->TargetMesh->Copy(SourceMesh);
-		});        
-		// 设置目标变换
-		CutOp->TargetTransform = TargetMeshComponent->GetComponentTransform();
+		});
+
+		TWeakObjectPtr<UVoxelCutComponent> WeakSelf(this);
+		TSharedPtr<FVoxelCutMeshOp> Op = CutOp;
 
-		// 体素化切割目标（只做一次）
-		CutOp->InitializeVoxelData(nullptr);
+		// 进度回调：记录到共享状态，并投递到 GameThread 广播
+		auto ReportProgress = [WeakSelf, Job](float Progress)
+		{
+			Job->VoxelProgress.store(Progress, std::memory_order_relaxed);
+			AsyncTask(ENamedThreads::GameThread, [WeakSelf, Job]()
+			{
+				UVoxelCutComponent* Self = WeakSelf.Get();
+				if (Self && Self->ActiveInitJob == Job)
+				{
+					Self->BroadcastInitProgress();
+				}
+			});
+		};
+
+		// 八叉树构建在后台线程，GameThread 不再等待
+		Async(EAsyncExecution::ThreadPool, [WeakSelf, Job, Op, ReportProgress]()
+		{
+			ReportProgress(0.2f);
+
+			// 体素化切割目标（只做一次）
+			bool bVoxelized = false;
+			if (!Job->bCancelRequested)
+			{
+				bVoxelized = Op->InitializeVoxelData(&Job->ProgressCancel);
+			}
+			ReportProgress(1.0f);
+
+			AsyncTask(ENamedThreads::GameThread, [WeakSelf, Job, bVoxelized]()
+			{
+				UVoxelCutComponent* Self = WeakSelf.Get();
+				if (!Self || Self->ActiveInitJob != Job)
+				{
+					return;
+				}
+				Self->CompleteInitStage(bVoxelized);
+			});
+		});
+	}
+	else
+	{
+		Job->VoxelProgress = 1.0f;
+		CompleteInitStage(true);
 	}
 
 	//VisualizeOctreeNode();
 
-	// 初始化切割工具VolumeTexture资源
-	InitToolSDFAsync(64);
+	// 刀具库：所有刀具的SDF准备好后才完成初始化
+	// 解析刀具不需要SDF纹理，其余形状初始化切割工具VolumeTexture资源
+	if (ToolLibrary)
+	{
+		PreloadToolLibrary();
+	}
+	else if (ToolShape.IsAnalytic())
+	{
+		CompleteToolInitStage(true);
+	}
+	else
+	{
+		InitToolSDFAsync(64);
+	}
 
 	//bSystemInitialized = true;
 }
@@ -95,6 +189,78 @@ void UVoxelCutComponent::InitializeCutSystem()
 void UVoxelCutComponent::OnCutSystemInitialized()
 {
 	bSystemInitialized = true;
+	OnInitProgress.Broadcast(1.0f);
+	OnCutSystemReady.Broadcast(true);
+}
+
+void UVoxelCutComponent::CompleteInitStage(bool bSuccess)
+{
+	// 初始化之外的调用 (例如手动重新生成刀具SDF) 不影响初始化状态
+	if (!ActiveInitJob.IsValid())
+	{
+		return;
+	}
+
+	bInitStageFailed |= !bSuccess;
+	if (--NumPendingInitStages > 0)
+	{
+		BroadcastInitProgress();
+		return;
+	}
+
+	const bool bCancelled = ActiveInitJob->bCancelRequested;
+	ActiveInitJob.Reset();
+
+	if (!bCancelled && !bInitStageFailed)
+	{
+		OnCutSystemInitialized();
+		return;
+	}
+
+	// 所有阶段都已结束，丢弃部分完成的数据，允许重新初始化
+	UE_LOG(LogTemp, Warning, TEXT("切削系统初始化%s"), bCancelled ? TEXT("已取消") : TEXT("失败"));
+	CutOp.Reset();
+	ToolSDFGenerator.Reset();
+	ResidentTools.Reset();
+	AppliedToolIndex = INDEX_NONE;
+	OnCutSystemReady.Broadcast(false);
+}
+
+void UVoxelCutComponent::CompleteToolInitStage(bool bSuccess)
+{
+	if (ActiveInitJob.IsValid())
+	{
+		ActiveInitJob->ToolProgress = 1.0f;
+	}
+	CompleteInitStage(bSuccess);
+}
+
+void UVoxelCutComponent::BroadcastInitProgress()
+{
+	if (ActiveInitJob.IsValid())
+	{
+		OnInitProgress.Broadcast(GetInitProgress());
+	}
+}
+
+float UVoxelCutComponent::GetInitProgress() const
+{
+	if (!ActiveInitJob.IsValid())
+	{
+		return 0.0f;
+	}
+
+	// 体素化通常远慢于刀具SDF，按 8 : 2 加权
+	return ActiveInitJob->VoxelProgress.load(std::memory_order_relaxed) * 0.8f +
+		ActiveInitJob->ToolProgress.load(std::memory_order_relaxed) * 0.2f;
+}
+
+void UVoxelCutComponent::CancelInitialization()
+{
+	if (ActiveInitJob.IsValid())
+	{
+		ActiveInitJob->bCancelRequested = true;
+	}
 }
 
 void UVoxelCutComponent::InitToolSDFAsync(int32 TextureSize)
@@ -110,6 +276,7 @@ void UVoxelCutComponent::InitToolSDFAsync(int32 TextureSize)
 	if (!CutOp.IsValid() || !CutOp->CutToolMesh.IsValid())
 	{
 		UE_LOG(LogTemp, Error, TEXT("CutOp或切割工具网格未初始化，无法预计算SDF"));
+		CompleteToolInitStage(false);
 		return;
 	}
 
@@ -118,11 +285,15 @@ void UVoxelCutComponent::InitToolSDFAsync(int32 TextureSize)
 
 	// 4. 创建SDF生成器
 	ToolSDFGenerator = MakeShared<FToolSDFGenerator>();
+	ToolSDFGenerator->SetKeepCPUVolume(bCPUToolSDFCut);
 	TWeakObjectPtr<UVoxelCutComponent> WeakSelf = this;
+	FToolSDFResolution Resolution;
+	Resolution.TextureSize = TextureSize;
+	Resolution.TargetVoxelSize = ToolSDFVoxelSize;
 	// 5. 异步调用PrecomputeSDFAsync，传入回调函数
 	ToolSDFGenerator->PrecomputeSDFAsync(
 		*CutOp->CutToolMesh,  // 传入工具网格（const引用）
-		TextureSize,          // 纹理尺寸
+		Resolution,           // 分辨率设置
 		[WeakSelf, this](bool bSuccess) // 回调：捕获弱引用避免循环引用
 		{
 			// 切回游戏线程执行业务逻辑（关键：避免跨线程操作CutOp）
@@ -144,8 +315,8 @@ void UVoxelCutComponent::InitToolSDFAsync(int32 TextureSize)
 					// 复制SDF生成器到CutOp（共享指针自动管理生命周期）
 					CutOp->ToolSDFGenerator = ToolSDFGenerator;
 
-					// 切削系统初始化完成
-					OnCutSystemInitialized();
+					// 刀具SDF阶段完成
+					CompleteToolInitStage(true);
 				}
 				else
 				{
@@ -153,6 +324,7 @@ void UVoxelCutComponent::InitToolSDFAsync(int32 TextureSize)
 					// 失败时释放无效的生成器
 					ToolSDFGenerator.Reset();
 					CutOp->ToolSDFGenerator.Reset();
+					CompleteToolInitStage(false);
 				}
 			});
 		}
@@ -160,6 +332,136 @@ void UVoxelCutComponent::InitToolSDFAsync(int32 TextureSize)
 }
 
 
+void UVoxelCutComponent::PreloadToolLibrary()
+{
+	if (!CutOp.IsValid() || NumPendingToolSDFs > 0)
+	{
+		return;
+	}
+
+	const int32 NumTools = ToolLibrary->GetNumTools();
+	ResidentTools.Reset();
+	ResidentTools.SetNum(NumTools);
+	AppliedToolIndex = INDEX_NONE;
+
+	// 1. 复制每把刀具的网格 (解析刀具也保留网格，用于显示)
+	for (int32 ToolIndex = 0; ToolIndex < NumTools; ToolIndex++)
+	{
+		const FSDFToolLibraryEntry* Tool = ToolLibrary->GetTool(ToolIndex);
+		FResidentTool& Resident = ResidentTools[ToolIndex];
+		Resident.Shape = Tool->Shape;
+
+		if (!Tool->Mesh)
+		{
+			continue;
+		}
+
+		UDynamicMesh* TempMesh = NewObject<UDynamicMesh>();
+		FGeometryScriptCopyMeshFromAssetOptions Options;
+		Options.bApplyBuildSettings = true;
+		FGeometryScriptMeshReadLOD LODSettings;
+		LODSettings.LODIndex = 0;
+		EGeometryScriptOutcomePins Outcome;
+		UGeometryScriptLibrary_StaticMeshFunctions::CopyMeshFromStaticMeshV2(Tool->Mesh, TempMesh, Options, LODSettings, Outcome);
+
+		if (Outcome == EGeometryScriptOutcomePins::Success)
+		{
+			Resident.Mesh = MakeShared<FDynamicMesh3, ESPMode::ThreadSafe>(MoveTemp(TempMesh->GetMeshRef()));
+		}
+	}
+
+	// 2. 网格刀具异步预计算SDF，最后一个完成时初始化切削系统
+	FToolSDFResolution Resolution;
+	Resolution.TargetVoxelSize = ToolSDFVoxelSize;
+	for (int32 ToolIndex = 0; ToolIndex < NumTools; ToolIndex++)
+	{
+		FResidentTool& Resident = ResidentTools[ToolIndex];
+		if (Resident.Shape.IsAnalytic())
+		{
+			continue;
+		}
+		if (!Resident.Mesh.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("刀具库第 %d 把刀具既没有解析形状也没有网格"), ToolIndex);
+			continue;
+		}
+
+		NumPendingToolSDFs++;
+		Resident.SDFGenerator = MakeShared<FToolSDFGenerator>();
+		Resident.SDFGenerator->SetKeepCPUVolume(bCPUToolSDFCut);
+		TWeakObjectPtr<UVoxelCutComponent> WeakSelf = this;
+		Resident.SDFGenerator->PrecomputeSDFAsync(*Resident.Mesh, Resolution, [WeakSelf, this, ToolIndex](bool bSuccess)
+		{
+			AsyncTask(ENamedThreads::GameThread, [this, WeakSelf, ToolIndex, bSuccess]()
+			{
+				if (!WeakSelf.IsValid())
+				{
+					return;
+				}
+
+				if (!bSuccess)
+				{
+					UE_LOG(LogTemp, Error, TEXT("刀具库第 %d 把刀具SDF预计算失败"), ToolIndex);
+					ResidentTools[ToolIndex].SDFGenerator.Reset();
+				}
+
+				if (--NumPendingToolSDFs == 0)
+				{
+					SyncActiveTool();
+					CompleteToolInitStage(true);
+				}
+			});
+		});
+	}
+
+	if (NumPendingToolSDFs == 0)
+	{
+		SyncActiveTool();
+		CompleteToolInitStage(true);
+	}
+}
+
+void UVoxelCutComponent::SyncActiveTool()
+{
+	if (!ToolLibrary || !CutOp.IsValid())
+	{
+		return;
+	}
+
+	const int32 ToolIndex = ToolLibrary->GetActiveToolIndex();
+	if (ToolIndex == AppliedToolIndex || !ResidentTools.IsValidIndex(ToolIndex))
+	{
+		return;
+	}
+
+	const FResidentTool& Resident = ResidentTools[ToolIndex];
+	if (!Resident.Shape.IsAnalytic() && !Resident.SDFGenerator.IsValid())
+	{
+		return;
+	}
+
+	// 切削线程正在读取 CutOp 的刀具数据时不切换，下一帧再试
+	FScopeLock Lock(&StateLock);
+	if (CutState == ECutState::Processing)
+	{
+		return;
+	}
+
+	CutOp->CutToolMesh = Resident.Mesh;
+	CutOp->ToolSDFGenerator = Resident.SDFGenerator;
+	CutOp->ToolShape = Resident.Shape;
+	AppliedToolIndex = ToolIndex;
+
+	// 更新刀具显示网格
+	if (CutToolMeshComponent && Resident.Mesh.IsValid())
+	{
+		CutToolMeshComponent->SetMesh(FDynamicMesh3(*Resident.Mesh));
+	}
+
+	// 换刀后即使位置不变也立即用新刀具切削一次
+	DistanceSinceLastUpdate = UpdateThreshold;
+}
+
 void UVoxelCutComponent::EnableCutting()
 {
 	bCuttingEnabled = true;
@@ -188,6 +490,9 @@ void UVoxelCutComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 	if (!bSystemInitialized || !bCuttingEnabled || !CutToolMeshComponent || !TargetMeshComponent)
 		return;
 
+	// 刀具库换刀
+	SyncActiveTool();
+
 	// 获取当前工具位置
 	FTransform CurrentTransform = CutToolMeshComponent->GetComponentTransform();
 	
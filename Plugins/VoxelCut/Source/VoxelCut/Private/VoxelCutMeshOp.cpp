@@ -11,6 +11,9 @@
 #include "DynamicMesh/DynamicMesh3.h"
 #include "HAL/PlatformTime.h"
 #include "VoxelCutComputePass.h"
+#include "SDFMeshExporter.h"
+#include "Async/ParallelFor.h"
+#include "Async/Async.h"
 
 using namespace UE::Geometry;
 
@@ -40,7 +43,7 @@ bool FVoxelCutMeshOp::InitializeVoxelData(FProgressCancel* Progress)
 	// 体素化目标网格
 	bool success = VoxelizeMesh(*TargetMesh, TargetTransform, *PersistentVoxelData, Progress);
 
-	bVoxelDataInitialized = true;
+	bVoxelDataInitialized = success;
 	return success;
 }
 
@@ -74,7 +77,10 @@ bool FVoxelCutMeshOp::VoxelizeMesh(const FDynamicMesh3& Mesh, const FTransform&
 	double StartTime = FPlatformTime::Seconds();
 
 	// 从模型构建八叉树
-	VoxelData.BuildOctreeFromMesh(Mesh, Transform);
+	if (!VoxelData.BuildOctreeFromMesh(Mesh, Transform, Progress))
+	{
+		return false;
+	}
 
 	double EndTime = FPlatformTime::Seconds();
 	UE_LOG(LogTemp, Warning, TEXT("网格体素化耗时: %.2f 毫秒"), (EndTime - StartTime) * 1000.0);
@@ -85,14 +91,15 @@ bool FVoxelCutMeshOp::VoxelizeMesh(const FDynamicMesh3& Mesh, const FTransform&
 
 void FVoxelCutMeshOp::UpdateLocalRegion()
 {
-	if (!PersistentVoxelData.IsValid()|| !CutToolMesh)
+	// 解析刀具不读取网格 (刀具库中的解析刀具可以没有网格)
+	if (!PersistentVoxelData.IsValid()|| (!CutToolMesh && !ToolShape.IsAnalytic()))
 	{
 		UE_LOG(LogTemp, Error, TEXT("UpdateLocalRegion: [PersistentVoxelData OR CutToolMesh] is not valid"));
 		return;
 	}
 
-	// 切削工具的扩展边界
-	FAxisAlignedBox3d OriginalBounds = CutToolMesh->GetBounds();
+	// 切削工具的扩展边界 (解析刀具使用图元包围盒)
+	FAxisAlignedBox3d OriginalBounds = ToolShape.IsAnalytic() ? FAxisAlignedBox3d(ToolShape.GetLocalBounds()) : CutToolMesh->GetBounds();
 	FAxisAlignedBox3d TransformedBounds(OriginalBounds, CutToolTransform);
 
 	double StartTime = FPlatformTime::Seconds();
@@ -138,46 +145,189 @@ void FVoxelCutMeshOp::UpdateLocalRegion()
 			FlatOctreeNodes[i].Voxel = 1.0f;
 		}
 	}
-	// 2. 设置发送给GPU的参数
+	// 2. 解析刀具按形状分派到特化的 CPU 切削核，网格刀具可选在 CPU 上采样距离场，直接写回
+	const bool bCPUAnalytic = ToolShape.IsAnalytic() && bCPUAnalyticCut;
+	// 刀具SDF生成时没有保留 CPU 副本则退回着色器路径
+	const bool bCPUVolume = !ToolShape.IsAnalytic() && bCPUVolumeCut && ToolSDFGenerator.IsValid() && ToolSDFGenerator->GetCPUVolume().IsValid();
+	if (bCPUAnalytic || bCPUVolume)
+	{
+		if (bCPUAnalytic)
+		{
+			SDFToolShape::DispatchKernel(ToolShape.GetKernel(), [this, &FlatOctreeNodes](auto KernelTag)
+			{
+				CutNodesAnalytic<decltype(KernelTag)::value>(FlatOctreeNodes);
+			});
+		}
+		else
+		{
+			CutNodesVolume(FlatOctreeNodes);
+		}
+
+		// 与 GPU 回调一样在游戏线程写回
+		AsyncTask(ENamedThreads::GameThread, [this, AffectedNodesCopy = AffectedNodes, ResultNodes = MoveTemp(FlatOctreeNodes)]()
+		{
+			ApplyCutResult(AffectedNodesCopy, ResultNodes);
+		});
+		return;
+	}
+
+	// 3. 设置发送给GPU的参数
 	FVoxelCutCSParams Params;
 	Params.ToolSDFGenerator = ToolSDFGenerator;
 	Params.ToolTransform = CutToolTransform;
 	Params.OctreeNodesArray = FlatOctreeNodes;
+	Params.ToolShape = ToolShape;
 
-	// 3. 调用ComputeShader并设置回调
+	// 4. 调用ComputeShader并设置回调
 	FVoxlCutShaderInterface::Dispatch(
 		Params,
 	    [this, AffectedNodesCopy = AffectedNodes](const TArray<FlatOctreeNode>& ResultNodes)
 	    {
-		    // 4. 处理GPU返回的结果
+		    // 5. 处理GPU返回的结果
 		    if (ResultNodes.Num() != AffectedNodesCopy.Num())
 		    {
 			    UE_LOG(LogTemp, Error, TEXT("Compute shader result count mismatch"));
 			    return;
 		    }
 
-		    // 5. 更新体素数据
-		    for (int32 i = 0; i < AffectedNodesCopy.Num(); i++)
-		    {
-			    FOctreeNode* Node = AffectedNodesCopy[i];
-			    const FlatOctreeNode& ResultNode = ResultNodes[i];		    	
-				Node->Voxel = ResultNode.Voxel;
-		    	if (ResultNode.Voxel > 0.0f)
-		    	{
-		    		Node->bIsEmpty = true;
-		    	}
-		    }
-
-		    // 6. 触发模型更新回调
-		    if (OnVoxelDataUpdated.IsBound())
-		    {
-			    OnVoxelDataUpdated.Execute(true);
-		    }
+		    ApplyCutResult(AffectedNodesCopy, ResultNodes);
 	    });
 }
 
+template <ESDFToolKernel Kernel>
+void FVoxelCutMeshOp::CutNodesAnalytic(TArray<FlatOctreeNode>& Nodes) const
+{
+	// 与 VoxelCutCS.usf 一致：节点中心变换到刀具局部空间，落在刀具内部则标记为被切削
+	const FMatrix44f ToolInverse(CutToolTransform.Inverse().ToMatrixWithScale());
+
+	ParallelFor(Nodes.Num(), [&](int32 i)
+	{
+		FlatOctreeNode& Node = Nodes[i];
+		const FVector3f Center(
+			(Node.BoundsMin[0] + Node.BoundsMax[0]) * 0.5f,
+			(Node.BoundsMin[1] + Node.BoundsMax[1]) * 0.5f,
+			(Node.BoundsMin[2] + Node.BoundsMax[2]) * 0.5f);
+		const FVector3f ToolLocal = ToolInverse.TransformPosition(Center);
+
+		if (SDFToolShape::Evaluate<Kernel>(ToolShape, ToolLocal) < 0.0f)
+		{
+			Node.Voxel = FMath::Abs(Node.Voxel);
+		}
+	});
+}
+
+void FVoxelCutMeshOp::CutNodesVolume(TArray<FlatOctreeNode>& Nodes) const
+{
+	// 取一次已发布的快照，整个切削过程使用同一份数据
+	const TSharedPtr<const FToolSDFCPUVolume, ESPMode::ThreadSafe> ToolVolume = ToolSDFGenerator->GetCPUVolume();
+	if (!ToolVolume.IsValid())
+	{
+		return;
+	}
+
+	const FMatrix44f ToolInverse(CutToolTransform.Inverse().ToMatrixWithScale());
+	const FBox3f SDFBounds(FVector3f(ToolVolume->Bounds.Min), FVector3f(ToolVolume->Bounds.Max));
+
+	ParallelFor(Nodes.Num(), [&](int32 i)
+	{
+		FlatOctreeNode& Node = Nodes[i];
+		const FVector3f Center(
+			(Node.BoundsMin[0] + Node.BoundsMax[0]) * 0.5f,
+			(Node.BoundsMin[1] + Node.BoundsMax[1]) * 0.5f,
+			(Node.BoundsMin[2] + Node.BoundsMax[2]) * 0.5f);
+		const FVector3f ToolLocal = ToolInverse.TransformPosition(Center);
+
+		// 采样域之外不可能在刀具内部
+		if (SDFBounds.IsInsideOrOn(ToolLocal) && ToolVolume->Sample(ToolLocal) < 0.0f)
+		{
+			Node.Voxel = FMath::Abs(Node.Voxel);
+		}
+	});
+}
+
+void FVoxelCutMeshOp::ApplyCutResult(const TArray<FOctreeNode*>& Nodes, const TArray<FlatOctreeNode>& ResultNodes)
+{
+	// 有订阅者时记录增量 (需要在覆盖旧值之前)
+	if (CutDeltaChannel.HasSubscribers() && PersistentVoxelData.IsValid())
+	{
+		PublishCutDelta(Nodes, ResultNodes);
+	}
+
+	// 更新体素数据
+	for (int32 i = 0; i < Nodes.Num(); i++)
+	{
+		FOctreeNode* Node = Nodes[i];
+		const FlatOctreeNode& ResultNode = ResultNodes[i];
+		Node->Voxel = ResultNode.Voxel;
+		if (ResultNode.Voxel > 0.0f)
+		{
+			Node->bIsEmpty = true;
+		}
+	}
+
+	// 触发模型更新回调
+	if (OnVoxelDataUpdated.IsBound())
+	{
+		OnVoxelDataUpdated.Execute(true);
+	}
+}
+
+
+
+
+void FVoxelCutMeshOp::PublishCutDelta(const TArray<FOctreeNode*>& Nodes, const TArray<FlatOctreeNode>& ResultNodes)
+{
+	// 叶子节点不在规则网格上：以受影响叶子中最小的边长为网格单元，
+	// 每个叶子按其最小角点落到一个网格坐标上 (八叉树不存储材质，G 通道恒为 0)
+	double CellSize = TNumericLimits<double>::Max();
+	for (const FOctreeNode* Node : Nodes)
+	{
+		CellSize = FMath::Min(CellSize, Node->Bounds.Width());
+	}
+	if (CellSize <= 0.0 || CellSize == TNumericLimits<double>::Max())
+	{
+		return;
+	}
 
+	const FVector3d GridOrigin = PersistentVoxelData->OctreeRoot.Bounds.Min;
 
+	TArray<FIntVector> Coords;
+	Coords.SetNumUninitialized(Nodes.Num());
+	FIntVector RegionMin(MAX_int32);
+	FIntVector RegionMax(MIN_int32);
+	for (int32 i = 0; i < Nodes.Num(); i++)
+	{
+		const FVector3d Cell = (Nodes[i]->Bounds.Min - GridOrigin) / CellSize;
+		Coords[i] = FIntVector(FMath::RoundToInt(Cell.X), FMath::RoundToInt(Cell.Y), FMath::RoundToInt(Cell.Z));
+		RegionMin = FIntVector(FMath::Min(RegionMin.X, Coords[i].X), FMath::Min(RegionMin.Y, Coords[i].Y), FMath::Min(RegionMin.Z, Coords[i].Z));
+		RegionMax = FIntVector(FMath::Max(RegionMax.X, Coords[i].X), FMath::Max(RegionMax.Y, Coords[i].Y), FMath::Max(RegionMax.Z, Coords[i].Z));
+	}
+
+	TSharedRef<FSDFCutDelta, ESPMode::ThreadSafe> Delta = MakeShared<FSDFCutDelta, ESPMode::ThreadSafe>();
+	Delta->GridOrigin = GridOrigin;
+	Delta->CellSize = (float)CellSize;
+	Delta->RegionMin = RegionMin;
+	Delta->RegionSize = RegionMax - RegionMin + FIntVector(1);
+
+	TArray<FSDFCutDelta::FSparseEntry> Entries;
+	Entries.Reserve(Nodes.Num());
+	for (int32 i = 0; i < Nodes.Num(); i++)
+	{
+		if (Nodes[i]->Voxel == ResultNodes[i].Voxel)
+		{
+			continue;
+		}
+
+		const FIntVector Local = Coords[i] - RegionMin;
+		FSDFCutDelta::FSparseEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Index = (Local.Z * Delta->RegionSize.Y + Local.Y) * Delta->RegionSize.X + Local.X;
+		Entry.Old = FFloat16Color(FLinearColor(Nodes[i]->Voxel, 0.0f, 0.0f, 0.0f));
+		Entry.New = FFloat16Color(FLinearColor(ResultNodes[i].Voxel, 0.0f, 0.0f, 0.0f));
+	}
+
+	Delta->BuildFromSparse(Entries);
+	CutDeltaChannel.Publish(Delta);
+}
 
 void RecursivelyLogOctreeNode(const FOctreeNode& Node, int32 Level)
 {
@@ -230,24 +380,64 @@ void FVoxelCutMeshOp::ConvertVoxelsToMesh(const FMaVoxelData& Voxels, FProgressC
 
 	double StartTime = FPlatformTime::Seconds();
 
-	FMarchingCubes MarchingCubes;
-	// 使用八叉树边界
-	MarchingCubes.Bounds = Voxels.GetOctreeBounds();
-	MarchingCubes.CubeSize = Voxels.MarchingCubeSize;
+	if (bUseDualContouring)
+	{
+		// 1. 将八叉树按 MarchingCubeSize 采样为规则网格
+		const double CellSize = Voxels.MarchingCubeSize;
+		const FVector3d Extent = Bounds.Max - Bounds.Min;
+		const FIntVector GridDims(
+			FMath::CeilToInt(Extent.X / CellSize) + 1,
+			FMath::CeilToInt(Extent.Y / CellSize) + 1,
+			FMath::CeilToInt(Extent.Z / CellSize) + 1);
+
+		TArray<float> GridValues;
+		GridValues.SetNumUninitialized(GridDims.X * GridDims.Y * GridDims.Z);
+		ParallelFor(GridDims.Z, [&](int32 Z)
+		{
+			for (int32 Y = 0; Y < GridDims.Y; Y++)
+			{
+				for (int32 X = 0; X < GridDims.X; X++)
+				{
+					const FVector3d Pos = Bounds.Min + FVector3d(X, Y, Z) * CellSize;
+					GridValues[(Z * GridDims.Y + Y) * GridDims.X + X] = Voxels.GetValueAtPosition(Pos);
+				}
+			}
+		});
+
+		if (Progress && Progress->Cancelled()) return;
 
-	// 使用八叉树进行采样
-	MarchingCubes.Implicit = [&Voxels](const FVector3d& Pos) -> double
+		// 2. 对偶轮廓提取 (八叉树没有材质信息)
+		FSDFMeshExporter::FDualContouringConfig DCConfig;
+		DCConfig.IsoValue = 0.0f;
+		if (Progress)
+		{
+			DCConfig.CancelF = [Progress]() { return Progress->Cancelled(); };
+		}
+
+		FSDFMeshExporter::DualContourGrid(GridValues, TArrayView<const uint8>(), GridDims, CellSize, Bounds.Min, DCConfig, *ResultMesh);
+		ResultMesh->DiscardTriangleGroups();
+	}
+	else
 	{
-		return Voxels.GetValueAtPosition(Pos);
-	};
+		FMarchingCubes MarchingCubes;
+		// 使用八叉树边界
+		MarchingCubes.Bounds = Voxels.GetOctreeBounds();
+		MarchingCubes.CubeSize = Voxels.MarchingCubeSize;
 
-	MarchingCubes.IsoValue = 0.0f;
-	MarchingCubes.Generate();
+		// 使用八叉树进行采样
+		MarchingCubes.Implicit = [&Voxels](const FVector3d& Pos) -> double
+		{
+			return Voxels.GetValueAtPosition(Pos);
+		};
 
-	ResultMesh->Copy(&MarchingCubes);
-	
-	// 平滑模型
-	SmoothGeneratedMesh(*ResultMesh, SmoothingIteration);
+		MarchingCubes.IsoValue = 0.0f;
+		MarchingCubes.Generate();
+
+		ResultMesh->Copy(&MarchingCubes);
+
+		// 平滑模型 (对偶轮廓的锐利边缘不需要平滑)
+		SmoothGeneratedMesh(*ResultMesh, SmoothingIteration);
+	}
 
 	UE_LOG(LogTemp, Warning, TEXT("Generated mesh triangle count: %d"), ResultMesh->TriangleCount());
 
@@ -7,6 +7,8 @@
 
 using namespace UE::Geometry;
 
+class FProgressCancel;
+
 // 八叉树节点
 struct VOXELCUT_API FOctreeNode
 {
@@ -31,13 +33,15 @@ struct VOXELCUT_API FMaVoxelData
 	double MarchingCubeSize = 2.0f; // Marching Cubes的体素大小
 	int32 MaxOctreeDepth = 6; // 最大深度，控制精度
 	double MinVoxelSize = 0.5; // 最小体素大小
+	int32 MaxSignGridResolution = 256; // 叶子内外批量判断的网格每轴上限，超过则逐点 Fast Winding
 
 	FOctreeNode OctreeRoot;
 
 	void Reset();
 	bool IsValid() const { return  !OctreeRoot.Bounds.IsEmpty(); }
 	
-	void BuildOctreeFromMesh(const FDynamicMesh3& Mesh, const FTransform& Transform);
+	// 从网格构建八叉树，Progress 被取消时提前结束并清空八叉树，返回 false
+	bool BuildOctreeFromMesh(const FDynamicMesh3& Mesh, const FTransform& Transform, FProgressCancel* Progress = nullptr);
 	float GetValueAtPosition(const FVector3d& WorldPos) const;
 	
 	void DebugLogOctreeStats() const;
@@ -49,5 +53,6 @@ private:
 	// 内部辅助方法
 	float CalculateDistanceToMesh(const FDynamicMeshAABBTree3& Spatial, 
 								TFastWindingTree<FDynamicMesh3>& Winding,
-								const FVector3d& Pos) const;
+								const FVector3d& Pos,
+								const bool* bPrecomputedInside = nullptr) const;
 };
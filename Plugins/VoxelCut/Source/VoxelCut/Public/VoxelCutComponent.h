@@ -10,10 +10,21 @@
 #include "ToolSDFGenerator.h"
 #include "UObject/WeakObjectPtr.h"
 #include "HAL/PlatformTime.h"
+#include "UDynamicMesh.h"
+#include "Util/ProgressCancel.h"
+#include <atomic>
 #include "VoxelCutComponent.generated.h"
 
+class USDFToolLibrary;
+
 using namespace UE::Geometry;
 
+// 切削系统初始化结束 (在 GameThread 上广播)，取消或失败时 bSuccess = false
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVoxelCutSystemReady, bool, bSuccess);
+
+// 切削系统初始化进度 0~1 (在 GameThread 上广播)
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVoxelCutInitProgress, float, Progress);
+
 // 切削状态枚举
 UENUM()
 enum class ECutState : uint8
@@ -54,16 +65,47 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Voxel Cut")
 	void DisableCutting();
 
-	// 初始化切削系统
+	// 初始化切削系统 (分阶段异步进行：目标网格复制和体素化在后台线程，刀具SDF并行预计算，
+	// GameThread 上只做参数设置；全部完成后广播 OnCutSystemReady)
+	UFUNCTION(BlueprintCallable, Category = "Voxel Cut")
 	void InitializeCutSystem();
 
 	// 切削系统初始化完成
 	void OnCutSystemInitialized();
+
+	// 取消进行中的初始化 (OnCutSystemReady 以 false 广播，之后可以重新调用 InitializeCutSystem)
+	UFUNCTION(BlueprintCallable, Category = "Voxel Cut")
+	void CancelInitialization();
+
+	// 初始化进度 (0~1)，没有进行中的初始化时返回 0
+	UFUNCTION(BlueprintPure, Category = "Voxel Cut")
+	float GetInitProgress() const;
+
+	UFUNCTION(BlueprintPure, Category = "Voxel Cut")
+	bool IsInitializing() const { return ActiveInitJob.IsValid(); }
+
+	UFUNCTION(BlueprintPure, Category = "Voxel Cut")
+	bool IsCutSystemReady() const { return bSystemInitialized; }
+
+	UPROPERTY(BlueprintAssignable, Category = "Voxel Cut")
+	FOnVoxelCutSystemReady OnCutSystemReady;
+
+	UPROPERTY(BlueprintAssignable, Category = "Voxel Cut")
+	FOnVoxelCutInitProgress OnInitProgress;
 	
-	// 初始化切削工具的SDF
+	// 初始化切削工具的SDF (ToolSDFVoxelSize > 0 时 TextureSize 作为各轴分辨率上限)
 	UFUNCTION(BlueprintCallable, Category = "VoxelCut")
 	void InitToolSDFAsync(int32 TextureSize = 64);
 
+	// 工具SDF的目标体素尺寸 (刀具局部单位)，> 0 时按刀具包围盒逐轴确定分辨率 (细长刀具的刀尖精度更高、体素更少)；
+	// 0 时使用覆盖包围盒的立方体网格
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Cut|Tool", meta = (ClampMin = "0.0"))
+	float ToolSDFVoxelSize = 0.0f;
+
+	// 网格刀具在 CPU 上采样工具SDF切削，不走计算着色器 (需在生成刀具SDF之前设置，决定是否保留 CPU 副本)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Cut|Tool")
+	bool bCPUToolSDFCut = false;
+
 
 	
 	// 切削参数
@@ -84,23 +126,42 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Cut")
 	int32 SmoothingIteration = 2;
+
+	// 使用对偶轮廓生成切削网格 (保留锐利的切削边缘，此时不做边缘平滑)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Cut")
+	bool bUseDualContouring = false;
     
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Cut")
 	bool bFillHoles = true;
     
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Cut")
 	float UpdateThreshold = 1.0f;	
+
+	// 解析刀具形状 (刀具组件局部空间)，非空时直接按解析 SDF 切削，不再从刀具网格生成 SDF 纹理
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Cut|Tool")
+	FSDFToolShape ToolShape;
+
+	// 常驻刀具库：设置后初始化时为所有刀具准备网格和 SDF，换刀只需修改库的 ActiveToolIndex
+	// (此时忽略 ToolShape 和刀具组件上的网格)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel Cut|Tool")
+	USDFToolLibrary* ToolLibrary = nullptr;
 	
 	// 获取切削结果网格
 	UFUNCTION(BlueprintCallable, Category = "Voxel Cut")
 	UDynamicMeshComponent* GetResultMesh() const { return TargetMeshComponent; }
 
+	// 切削增量通道 (切削系统初始化之前返回 nullptr)
+	FSDFCutDeltaChannel* GetCutDeltaChannel() const { return CutOp.IsValid() ? &CutOp->CutDeltaChannel : nullptr; }
+
 
 	
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	// 取消未完成的初始化
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	
 
 public:
@@ -167,10 +228,59 @@ private:
 	// 异步状态标记：是否正在预计算SDF
 	bool bIsPrecomputingSDF = false;
 
+	// 刀具库中一把刀具的常驻切削数据
+	struct FResidentTool
+	{
+		TSharedPtr<const FDynamicMesh3, ESPMode::ThreadSafe> Mesh;
+		TSharedPtr<FToolSDFGenerator> SDFGenerator;
+		FSDFToolShape Shape;
+	};
+
+	TArray<FResidentTool> ResidentTools;
+
+	// 当前 CutOp 使用的刀具库索引
+	int32 AppliedToolIndex = INDEX_NONE;
+
+	// 尚未完成的刀具 SDF 预计算数量
+	int32 NumPendingToolSDFs = 0;
+
+	// 为刀具库的所有刀具复制网格并异步预计算 SDF，全部完成后初始化切削系统
+	void PreloadToolLibrary();
+
+	// 刀具库的当前刀具变化时切换 CutOp 的刀具 (只在没有切削进行时切换)
+	void SyncActiveTool();
+
 	
 	// 切削系统是否已经初始化
 	bool bSystemInitialized = false;
 
+	// 初始化任务的共享状态 (GameThread 与后台体素化任务共同持有)
+	struct FInitJob
+	{
+		std::atomic<float> VoxelProgress{0.0f};
+		std::atomic<float> ToolProgress{0.0f};
+		std::atomic<bool> bCancelRequested{false};
+
+		// 传给体素化的取消接口 (查询 bCancelRequested)
+		FProgressCancel ProgressCancel;
+	};
+
+	// 当前正在进行的初始化，仅在 GameThread 上读写
+	TSharedPtr<FInitJob, ESPMode::ThreadSafe> ActiveInitJob;
+
+	// 尚未完成的初始化阶段 (目标体素化 + 刀具SDF)
+	int32 NumPendingInitStages = 0;
+	bool bInitStageFailed = false;
+
+	// 一个初始化阶段结束，最后一个阶段结束时完成 (或放弃) 初始化
+	void CompleteInitStage(bool bSuccess);
+
+	// 刀具SDF阶段结束
+	void CompleteToolInitStage(bool bSuccess);
+
+	// 在 GameThread 上广播当前初始化进度
+	void BroadcastInitProgress();
+
 
 // Debug 相关信息
 
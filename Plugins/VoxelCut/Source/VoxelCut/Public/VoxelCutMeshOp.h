@@ -8,6 +8,7 @@
 #include "MaVoxelData.h"
 #include "ToolSDFGenerator.h"
 #include "VoxelCutComputePass.h"
+#include "SDFCutDelta.h"
 
 
 
@@ -28,6 +29,12 @@ namespace UE
 			TSharedPtr<FDynamicMesh3, ESPMode::ThreadSafe> TargetMesh;
 			TSharedPtr<const FDynamicMesh3, ESPMode::ThreadSafe> CutToolMesh;
 			TSharedPtr<FToolSDFGenerator> ToolSDFGenerator;
+			// 解析刀具形状 (刀具局部空间)，非空时不需要 ToolSDFGenerator
+			FSDFToolShape ToolShape;
+			// 解析刀具直接在 CPU 上切削 (省去 GPU 上传与回读)；false 时走着色器的解析排列
+			bool bCPUAnalyticCut = true;
+			// 网格刀具在 CPU 上采样 ToolSDFGenerator 的距离场副本切削 (受影响节点较少时省去 GPU 往返)
+			bool bCPUVolumeCut = false;
 			
 			// 变换矩阵
 			FTransform TargetTransform;
@@ -47,10 +54,15 @@ namespace UE
 			bool bSmoothCutEdges = true;
 			int32 SmoothingIteration = 0;
 			double SmoothingStrength = 0.6;
+			// 使用对偶轮廓 (Dual Contouring) 生成网格：保留切削产生的锐利边缘，不再进行平滑
+			bool bUseDualContouring = false;
     
 			// 增量更新选项
 			int32 UpdateMargin = 2;          // 更新边界扩展（体素单位）
 
+			// 切削增量通道：每次 UpdateLocalRegion 的 GPU 结果写回前发布变化的叶子节点
+			FSDFCutDeltaChannel CutDeltaChannel;
+
 			void SetTransform(const FTransformSRT3d& Transform);
 
     
@@ -86,6 +98,19 @@ namespace UE
 
 			void PrintOctreeNodeRecursive(const FOctreeNode& Node, int32 Depth);
 
+			// 解析刀具的 CPU 切削核，Kernel 为编译期常量
+			template <ESDFToolKernel Kernel>
+			void CutNodesAnalytic(TArray<FlatOctreeNode>& Nodes) const;
+
+			// 网格刀具的 CPU 切削核 (三线性采样工具SDF，与 VoxelCutCS.usf 的纹理采样一致)
+			void CutNodesVolume(TArray<FlatOctreeNode>& Nodes) const;
+
+			// 把切削结果写回八叉树 (GPU 回调与 CPU 路径共用)
+			void ApplyCutResult(const TArray<FOctreeNode*>& Nodes, const TArray<FlatOctreeNode>& ResultNodes);
+
+			// 比较新旧叶子值并发布增量
+			void PublishCutDelta(const TArray<FOctreeNode*>& Nodes, const TArray<FlatOctreeNode>& ResultNodes);
+
 
 		};
 	}
@@ -53,7 +53,8 @@ public class VoxelCut : ModuleRules
 				"RenderCore",
 				"RHI",
 				"Projects",
-				"GeometryFramework"
+				"GeometryFramework",
+				"SDFCut"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -1,21 +1,144 @@
 #include "ToolSDFGenerator.h"
 #include "RenderUtils.h"
-#include "DynamicMesh/DynamicMeshAABBTree3.h"
-#include "Spatial/FastWinding.h"
+#include "SDFGridGenerator.h"
+#include "SDFCacheFile.h"
+#include "Hash/xxhash.h"
 #include "RHI.h"
 #include "RHIResources.h"
 #include "RenderingThread.h"
 
+namespace ToolSDFCache
+{
+	// 文件格式: [Header][BoundsMin][BoundsMax][Dimensions][Volume]
+	// 生成算法变化时递增 Version，旧缓存自动失效
+	constexpr uint32 Magic = 0x46445354; // 'TSDF'
+	constexpr uint32 Version = 2;
+	const TCHAR* Category = TEXT("ToolSDFs");
+
+	// 内容键：顶点坐标 + 三角形索引 + 分辨率设置
+	uint64 MakeKey(const FDynamicMesh3& Mesh, const FToolSDFResolution& Resolution)
+	{
+		FXxHash64Builder Builder;
+
+		for (int32 VertexID : Mesh.VertexIndicesItr())
+		{
+			const FVector3d Position = Mesh.GetVertex(VertexID);
+			Builder.Update(&Position, sizeof(FVector3d));
+		}
+		for (int32 TriangleID : Mesh.TriangleIndicesItr())
+		{
+			const FIndex3i Triangle = Mesh.GetTriangle(TriangleID);
+			Builder.Update(&Triangle, sizeof(FIndex3i));
+		}
+		Builder.Update(&Resolution.TargetVoxelSize, sizeof(Resolution.TargetVoxelSize));
+		Builder.Update(&Resolution.TextureSize, sizeof(Resolution.TextureSize));
+		Builder.Update(&Resolution.MinAxisResolution, sizeof(Resolution.MinAxisResolution));
+		Builder.Update(&Resolution.PaddingVoxels, sizeof(Resolution.PaddingVoxels));
+
+		return Builder.Finalize().Hash;
+	}
+
+	bool Load(uint64 Key, const FIntVector& Dimensions, FAxisAlignedBox3d& OutBounds, TArray<float>& OutVolume)
+	{
+		const FString FilePath = FSDFCacheFile::GetCachePath(Category, Key);
+
+		return FSDFCacheFile::ReadMapped(FilePath, Magic, Version, Key,
+			[&](const uint8* Data, int64 Size) -> bool
+			{
+				const int64 NumVoxels = (int64)Dimensions.X * Dimensions.Y * Dimensions.Z;
+				const int64 ExpectedSize = sizeof(FVector3d) * 2 + sizeof(FIntVector) + NumVoxels * sizeof(float);
+				if (Size != ExpectedSize)
+				{
+					return false;
+				}
+
+				FVector3d BoundsMin, BoundsMax;
+				FIntVector StoredDimensions;
+				FMemory::Memcpy(&BoundsMin, Data, sizeof(FVector3d));
+				Data += sizeof(FVector3d);
+				FMemory::Memcpy(&BoundsMax, Data, sizeof(FVector3d));
+				Data += sizeof(FVector3d);
+				FMemory::Memcpy(&StoredDimensions, Data, sizeof(FIntVector));
+				Data += sizeof(FIntVector);
+
+				if (StoredDimensions != Dimensions)
+				{
+					return false;
+				}
+
+				// 直接从映射内存拷贝到体积数组
+				OutBounds = FAxisAlignedBox3d(BoundsMin, BoundsMax);
+				OutVolume.SetNumUninitialized((int32)NumVoxels);
+				FMemory::Memcpy(OutVolume.GetData(), Data, NumVoxels * sizeof(float));
+				return true;
+			});
+	}
+
+	bool Save(uint64 Key, const FIntVector& Dimensions, const FAxisAlignedBox3d& Bounds, const TArray<float>& Volume)
+	{
+		const FString FilePath = FSDFCacheFile::GetCachePath(Category, Key);
+
+		return FSDFCacheFile::Write(FilePath, Magic, Version, Key,
+			[&](FArchive& Ar)
+			{
+				FVector3d BoundsMin = Bounds.Min;
+				FVector3d BoundsMax = Bounds.Max;
+				FIntVector StoredDimensions = Dimensions;
+				Ar.Serialize(&BoundsMin, sizeof(FVector3d));
+				Ar.Serialize(&BoundsMax, sizeof(FVector3d));
+				Ar.Serialize(&StoredDimensions, sizeof(FIntVector));
+				Ar.Serialize(const_cast<float*>(Volume.GetData()), Volume.Num() * sizeof(float));
+			});
+	}
+}
+
+void FToolSDFGenerator::ComputeGridLayout(const FAxisAlignedBox3d& MeshBounds, const FToolSDFResolution& Resolution,
+	FAxisAlignedBox3d& OutBounds, FIntVector& OutDimensions)
+{
+	const int32 MaxResolution = FMath::Max(Resolution.TextureSize, 2);
+
+	// 未指定体素尺寸：覆盖包围盒的立方体网格
+	if (Resolution.TargetVoxelSize <= 0.0)
+	{
+		OutBounds = MeshBounds;
+		OutDimensions = FIntVector(MaxResolution);
+		return;
+	}
+
+	// 紧贴包围盒 + 外扩若干体素，各轴按目标体素尺寸独立确定分辨率
+	OutBounds = MeshBounds;
+	OutBounds.Expand(Resolution.TargetVoxelSize * FMath::Max(Resolution.PaddingVoxels, 0));
+
+	const FVector3d Size = OutBounds.Diagonal();
+	const int32 MinResolution = FMath::Clamp(Resolution.MinAxisResolution, 2, MaxResolution);
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		// 采样点位于角点上：N 个采样点覆盖 N - 1 个体素
+		OutDimensions[Axis] = FMath::Clamp(FMath::CeilToInt32(Size[Axis] / Resolution.TargetVoxelSize) + 1, MinResolution, MaxResolution);
+	}
+}
+
 void FToolSDFGenerator::PrecomputeSDFAsync(
     const FDynamicMesh3& ToolMesh,
     int32 TextureSize,
     TFunction<void(bool)> OnComplete
 )
+{
+    FToolSDFResolution Resolution;
+    Resolution.TextureSize = TextureSize;
+    PrecomputeSDFAsync(ToolMesh, Resolution, MoveTemp(OnComplete));
+}
+
+void FToolSDFGenerator::PrecomputeSDFAsync(
+    const FDynamicMesh3& ToolMesh,
+    const FToolSDFResolution& Resolution,
+    TFunction<void(bool)> OnComplete
+)
 {
     // 复制输入数据到新的计算数据结构
     TUniquePtr<FComputeData> ComputeData = MakeUnique<FComputeData>();
     ComputeData->ToolMesh = ToolMesh;
-    ComputeData->TextureSize = TextureSize;
+    ComputeData->Resolution = Resolution;
     ComputeData->CompleteCallback = OnComplete;
 
     // 先在工作线程计算SDF数据
@@ -27,57 +150,50 @@ void FToolSDFGenerator::PrecomputeSDFAsync(
 
 void FToolSDFGenerator::ComputeSDFData(TUniquePtr<FComputeData> Data)
 {
-    // 1. 计算工具网格边界
-    Data->Bounds = Data->ToolMesh.GetBounds();
-    FVector3d SDFSize = Data->Bounds.Max - Data->Bounds.Min;
+    // 1. 采样域与各轴分辨率
+    ComputeGridLayout(Data->ToolMesh.GetBounds(), Data->Resolution, Data->Bounds, Data->Dimensions);
+    const FIntVector Dims = Data->Dimensions;
+    const int32 NumVoxels = Dims.X * Dims.Y * Dims.Z;
 
-    // 2. 创建空间查询结构
-    FDynamicMeshAABBTree3 ToolSpatial(&Data->ToolMesh);
-    TFastWindingTree<FDynamicMesh3> ToolWinding(&ToolSpatial);
+    // 2. 磁盘缓存：同一网格 + 分辨率设置直接读取，跳过计算
+    const uint64 CacheKey = bUseDiskCache ? ToolSDFCache::MakeKey(Data->ToolMesh, Data->Resolution) : 0;
+    if (bUseDiskCache && ToolSDFCache::Load(CacheKey, Dims, Data->Bounds, Data->VolumeData))
+    {
+        UE_LOG(LogTemp, Log, TEXT("工具SDF命中磁盘缓存: %016llx (%dx%dx%d)"), CacheKey, Dims.X, Dims.Y, Dims.Z);
 
-    // 3. 初始化Volume数据
-    Data->VolumeData.SetNumZeroed(Data->TextureSize * Data->TextureSize * Data->TextureSize);
-    int32 TotalVoxels = Data->VolumeData.Num();
+        ENQUEUE_RENDER_COMMAND(CreateSDFTexture)(
+            [this, Data = MoveTemp(Data)](FRHICommandListImmediate& RHICmdList) mutable
+            {
+                CreateTextureOnRenderThread(MoveTemp(Data));
+            }
+        );
+        return;
+    }
+
+    // 3. 采样网格：采样点位于采样域的角点上 (UVW = i / (N - 1))，各轴间距可以不同
+    const FVector3d SDFSize = Data->Bounds.Diagonal();
+    FSDFGridDesc Grid;
+    Grid.Origin = Data->Bounds.Min;
+    Grid.Spacing = FVector3d(
+        FMath::Max(SDFSize.X / (Dims.X - 1), UE_DOUBLE_KINDA_SMALL_NUMBER),
+        FMath::Max(SDFSize.Y / (Dims.Y - 1), UE_DOUBLE_KINDA_SMALL_NUMBER),
+        FMath::Max(SDFSize.Z / (Dims.Z - 1), UE_DOUBLE_KINDA_SMALL_NUMBER));
+    Grid.Dimensions = Dims;
 
-    // 计算最大可能距离
-    double MaxPossibleDist = SDFSize.GetMax() * 2.0;
+    // 4. 窄带 + 快速扫描计算符号距离 (没有三角形时整体填充最大可能距离)
+    FSDFGridGenerator::FConfig Config;
+    Config.FarValue = (float)(SDFSize.GetMax() * 2.0);
 
-    // 4. 并行计算每个体素的符号距离
-    ParallelFor(Data->TextureSize, [&](int32 Z)
+    if (!FSDFGridGenerator::Generate(Data->ToolMesh, Grid, Config, Data->VolumeData))
     {
-        for (int32 Y = 0; Y < Data->TextureSize; Y++)
-        {
-            for (int32 X = 0; X < Data->TextureSize; X++)
-            {
-                // 计算采样位置
-                FVector3d VoxelUVW(
-                    (double)X / (Data->TextureSize - 1),
-                    (double)Y / (Data->TextureSize - 1),
-                    (double)Z / (Data->TextureSize - 1)
-                );
-                
-                FVector3d SamplePos = Data->Bounds.Min + VoxelUVW * SDFSize;
-
-                // 计算符号距离
-                double NearestDistSqr;
-                int32 NearestTriID = ToolSpatial.FindNearestTriangle(SamplePos, NearestDistSqr);
-                
-                float SignedDist = (float)MaxPossibleDist;
-                if (NearestTriID != IndexConstants::InvalidID)
-                {
-                    double NearestDist = FMath::Sqrt(NearestDistSqr);
-                    bool bInside = ToolWinding.IsInside(SamplePos);
-                    SignedDist = (float)(bInside ? -NearestDist : NearestDist);
-                }
-
-                int32 Index = Z * (Data->TextureSize * Data->TextureSize) + Y * Data->TextureSize + X;
-                if (Index < TotalVoxels) // 边界检查
-                {
-                    Data->VolumeData[Index] = SignedDist;
-                }
-            }
-        }
-    });
+        Data->VolumeData.Init(Config.FarValue, NumVoxels);
+    }
+    else if (bUseDiskCache && Data->VolumeData.Num() == NumVoxels)
+    {
+        ToolSDFCache::Save(CacheKey, Dims, Data->Bounds, Data->VolumeData);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("工具SDF分辨率: %dx%dx%d (%d 体素)"), Dims.X, Dims.Y, Dims.Z, NumVoxels);
 
     // 5. 提交到渲染线程创建纹理
     ENQUEUE_RENDER_COMMAND(CreateSDFTexture)(
@@ -88,13 +204,39 @@ void FToolSDFGenerator::ComputeSDFData(TUniquePtr<FComputeData> Data)
     );
 }
 
+float FToolSDFCPUVolume::Sample(const FVector3f& LocalPos) const
+{
+    // 与着色器一致：采样点在角点上，超出采样域时夹到边界 (不镜像)
+    const FVector3d Size = Bounds.Diagonal();
+    int32 Base[3];
+    float Frac[3];
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        const int32 N = Dimensions[Axis];
+        const double Spacing = FMath::Max(Size[Axis] / (N - 1), UE_DOUBLE_KINDA_SMALL_NUMBER);
+        const float Coord = FMath::Clamp((float)((LocalPos[Axis] - Bounds.Min[Axis]) / Spacing), 0.0f, (float)(N - 1));
+        Base[Axis] = FMath::Min((int32)Coord, N - 2);
+        Frac[Axis] = Coord - Base[Axis];
+    }
+
+    const int32 StrideY = Dimensions.X;
+    const int32 StrideZ = Dimensions.X * Dimensions.Y;
+    const float* P = Data.GetData() + Base[0] + Base[1] * StrideY + Base[2] * StrideZ;
+
+    const float X00 = FMath::Lerp(P[0], P[1], Frac[0]);
+    const float X10 = FMath::Lerp(P[StrideY], P[StrideY + 1], Frac[0]);
+    const float X01 = FMath::Lerp(P[StrideZ], P[StrideZ + 1], Frac[0]);
+    const float X11 = FMath::Lerp(P[StrideZ + StrideY], P[StrideZ + StrideY + 1], Frac[0]);
+    return FMath::Lerp(FMath::Lerp(X00, X10, Frac[1]), FMath::Lerp(X01, X11, Frac[1]), Frac[2]);
+}
+
 void FToolSDFGenerator::CreateTextureOnRenderThread(TUniquePtr<FComputeData> Data)
 {
     check(IsInRenderingThread());
     check(Data.IsValid());
 
-    const int32 TextureSize = Data->TextureSize;
-    const int32 TotalVoxels = TextureSize * TextureSize * TextureSize;
+    const FIntVector Dims = Data->Dimensions;
+    const int32 TotalVoxels = Dims.X * Dims.Y * Dims.Z;
     const int32 BytesPerVoxel = sizeof(float);
     const int32 TotalBytes = TotalVoxels * BytesPerVoxel; 
 
@@ -113,12 +255,12 @@ void FToolSDFGenerator::CreateTextureOnRenderThread(TUniquePtr<FComputeData> Dat
     }
     
     // 2. 计算D3D12纹理数据布局参数
-    const uint32 SourceRowPitch = TextureSize * BytesPerVoxel;       // 一行（X）的字节数
-    const uint32 SourceDepthPitch = SourceRowPitch * TextureSize;    // 一层（X*Y）的字节数
+    const uint32 SourceRowPitch = Dims.X * BytesPerVoxel;            // 一行（X）的字节数
+    const uint32 SourceDepthPitch = SourceRowPitch * Dims.Y;         // 一层（X*Y）的字节数
 
     // 2. 创建空的3D纹理（无初始BulkData）
     FRHITextureCreateDesc TextureDesc = FRHITextureCreateDesc::Create3D(TEXT("ToolSDFVolumeTexture"),
-        FIntVector(TextureSize,TextureSize,TextureSize),
+        Dims,
         PF_R32_FLOAT)
         .SetNumMips(1)
         .SetFlags(ETextureCreateFlags::ShaderResource | ETextureCreateFlags::CPUWritable) // 允许CPU更新
@@ -146,7 +288,7 @@ void FToolSDFGenerator::CreateTextureOnRenderThread(TUniquePtr<FComputeData> Dat
     const FUpdateTextureRegion3D UpdateRegion(
         0, 0, 0,                    // 起始X/Y/Z
         0, 0, 0,                    // 起始Mip/Array/Slice
-        TextureSize, TextureSize, TextureSize // 宽度/高度/深度
+        Dims.X, Dims.Y, Dims.Z      // 宽度/高度/深度
     );
 
     // 上传数据到纹理
@@ -166,15 +308,26 @@ void FToolSDFGenerator::CreateTextureOnRenderThread(TUniquePtr<FComputeData> Dat
         ERHIAccess::SRVMask
     ));
 
-    // 5. 线程安全更新成员变量
+    // 5. 只有 CPU 切削路径需要时才保留距离场副本，作为不可变快照整体发布
+    TSharedPtr<FToolSDFCPUVolume, ESPMode::ThreadSafe> NewCPUVolume;
+    if (bKeepCPUVolume)
+    {
+        NewCPUVolume = MakeShared<FToolSDFCPUVolume, ESPMode::ThreadSafe>();
+        NewCPUVolume->Bounds = Data->Bounds;
+        NewCPUVolume->Dimensions = Dims;
+        NewCPUVolume->Data = MoveTemp(Data->VolumeData);
+    }
+
+    // 6. 线程安全更新成员变量
     {
         FScopeLock Lock(&TextureCritical);
         SDFTextureRHI = NewTextureRHI;
         SDFBounds = Data->Bounds;
-        VolumeSize = TextureSize;
+        VolumeDimensions = Dims;
+        CPUVolume = NewCPUVolume;
     }
 
-    // 6. 通知完成（游戏线程）
+    // 7. 通知完成（游戏线程）
     if (Data->CompleteCallback)
     {
         AsyncTask(ENamedThreads::GameThread, [CompleteCallback = MoveTemp(Data->CompleteCallback), NewTextureRHI]()
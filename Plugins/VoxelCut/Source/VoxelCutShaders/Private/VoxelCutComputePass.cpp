@@ -20,21 +20,27 @@ void FVoxlCutShaderInterface::DispatchRenderThread(
 {
 	FRDGBuilder GraphBuilder(RHICmdList);
 	{
-		// 获取ComputeShader
-		TShaderMapRef<FVoxelCutCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+		// 获取ComputeShader (按刀具形状选择排列)
+		const ESDFToolKernel ToolKernel = Params.ToolShape.GetKernel();
+		FVoxelCutCS::FPermutationDomain PermutationVector;
+		PermutationVector.Set<FVoxelCutCS::FToolShapeDim>((int32)ToolKernel);
+		TShaderMapRef<FVoxelCutCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel), PermutationVector);
 
 		bool bIsShaderValid = ComputeShader.IsValid();
 
 		//BEGIN_RDG_EVENT(GraphBuilder, "VoxelCutComputeShader");
 
-		if (bIsShaderValid)
+		// 网格刀具需要已生成的SDF纹理
+		const bool bHasToolTexture = Params.ToolSDFGenerator.IsValid() && Params.ToolSDFGenerator->GetSDFTextureRHI().IsValid();
+
+		if (bIsShaderValid && (ToolKernel != ESDFToolKernel::MeshTexture || bHasToolTexture))
 		{
 			// 1. 初始化参数
 			FVoxelCutCS::FParameters* PassParameters = GraphBuilder.AllocParameters<FVoxelCutCS::FParameters>();
 
 			// 2. 传入SDF参数
-			PassParameters->ToolSDF = Params.ToolSDFGenerator->GetSDFTextureRHI();
-			PassParameters->ToolSDFSampler = TStaticSamplerState<SF_Bilinear, AM_Mirror, AM_Mirror>::GetRHI();
+			PassParameters->ToolSDF = bHasToolTexture ? Params.ToolSDFGenerator->GetSDFTextureRHI() : nullptr;
+			PassParameters->ToolSDFSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
 			
 			constexpr uint32 ElementSize = sizeof(FlatOctreeNode);
 			const uint32 ArrayElementCount = Params.OctreeNodesArray.Num();
@@ -73,9 +79,20 @@ void FVoxlCutShaderInterface::DispatchRenderThread(
 			auto* ToolUBParameters = GraphBuilder.AllocParameters<FToolUB>();
 			FTransform InverseTransform = Params.ToolTransform.Inverse(); // 直接传进去inverse Transform, shader中不好计算inverse
 			ToolUBParameters->ToolInverseTransform = FMatrix44f(InverseTransform.ToMatrixWithScale());
-			ToolUBParameters->ToolBoundsLocalMin = FVector3f(Params.ToolSDFGenerator->GetSDFBounds().Min);
-			ToolUBParameters->ToolBoundsLocalMax = FVector3f(Params.ToolSDFGenerator->GetSDFBounds().Max);
-			ToolUBParameters->VolumeTextureSize = Params.ToolSDFGenerator->GetVolumeSize();
+			if (ToolKernel == ESDFToolKernel::MeshTexture)
+			{
+				ToolUBParameters->ToolBoundsLocalMin = FVector3f(Params.ToolSDFGenerator->GetSDFBounds().Min);
+				ToolUBParameters->ToolBoundsLocalMax = FVector3f(Params.ToolSDFGenerator->GetSDFBounds().Max);
+				ToolUBParameters->VolumeDimensions = Params.ToolSDFGenerator->GetVolumeDimensions();
+			}
+			else
+			{
+				const FBox ShapeBounds = Params.ToolShape.GetLocalBounds();
+				ToolUBParameters->ToolBoundsLocalMin = FVector3f(ShapeBounds.Min);
+				ToolUBParameters->ToolBoundsLocalMax = FVector3f(ShapeBounds.Max);
+				ToolUBParameters->VolumeDimensions = FIntVector(1);
+			}
+			Params.ToolShape.SetShaderParameters(*ToolUBParameters);
 			TRDGUniformBufferRef<FToolUB> ToolUB = GraphBuilder.CreateUniformBuffer(ToolUBParameters);
 			PassParameters->ToolUB = ToolUB;
 
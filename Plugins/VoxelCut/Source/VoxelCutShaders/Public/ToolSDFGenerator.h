@@ -5,6 +5,34 @@
 
 using namespace UE::Geometry;
 
+// 工具SDF的分辨率设置
+struct FToolSDFResolution
+{
+	// 目标体素尺寸 (刀具局部单位)，> 0 时各轴分辨率按包围盒尺寸 / 体素尺寸单独确定；
+	// <= 0 时退回到覆盖包围盒的 TextureSize^3 立方体网格
+	double TargetVoxelSize = 0.0;
+
+	// 立方体网格的分辨率，同时是各轴分辨率的上限
+	int32 TextureSize = 64;
+
+	// 各轴分辨率下限 (保证细长刀具的短轴也有足够采样)
+	int32 MinAxisResolution = 4;
+
+	// 包围盒外扩的体素数 (按目标体素尺寸时有效)，保证表面外侧的距离场也被采样到
+	int32 PaddingVoxels = 2;
+};
+
+// 工具SDF的 CPU 端副本 (X 最快)，发布后不再修改，可在任意线程读取
+struct VOXELCUTSHADERS_API FToolSDFCPUVolume
+{
+	FAxisAlignedBox3d Bounds;           // 采样域 (采样点位于边界的角点上)
+	FIntVector Dimensions = FIntVector::ZeroValue;
+	TArray<float> Data;
+
+	// 三线性采样 (刀具局部空间，与着色器的采样方式一致)
+	float Sample(const FVector3f& LocalPos) const;
+};
+
 class VOXELCUTSHADERS_API FToolSDFGenerator
 {
 public:
@@ -15,30 +43,59 @@ public:
 		TFunction<void(bool)> OnComplete = nullptr
 	);
 
+	// 预计算工具网格的SDF纹理，按目标体素尺寸选择各轴分辨率（异步执行）
+	void PrecomputeSDFAsync(
+		const FDynamicMesh3& ToolMesh,
+		const FToolSDFResolution& Resolution,
+		TFunction<void(bool)> OnComplete = nullptr
+	);
+
 	// 获取GPU可访问的SDF纹理资源（仅在渲染线程使用）
-	FTextureRHIRef GetSDFTextureRHI() const { 
+	FTextureRHIRef GetSDFTextureRHI() const {
 		FScopeLock Lock(&TextureCritical);
-		return SDFTextureRHI; 
+		return SDFTextureRHI;
 	}
 
-	// 获取SDF的边界信息
+	// 获取SDF的边界信息 (采样点位于边界的角点上)
 	const FAxisAlignedBox3d& GetSDFBounds() const { return SDFBounds; }
 
-	// 获取VolumeTexture尺寸
-	int32 GetVolumeSize() const { return VolumeSize; }
+	// 获取VolumeTexture各轴尺寸
+	FIntVector GetVolumeDimensions() const { return VolumeDimensions; }
+
+	// CPU 端距离场副本，未保留或尚未生成时返回空
+	TSharedPtr<const FToolSDFCPUVolume, ESPMode::ThreadSafe> GetCPUVolume() const {
+		FScopeLock Lock(&TextureCritical);
+		return CPUVolume;
+	}
+
+	// 是否在上传纹理后保留 CPU 端距离场副本 (只有 CPU 切削路径需要)，需在 PrecomputeSDFAsync 之前设置
+	void SetKeepCPUVolume(bool bEnable) { bKeepCPUVolume = bEnable; }
+
+	// 是否使用磁盘缓存 (<ProjectSaved>/SDFCut/ToolSDFs，按网格内容 + 分辨率寻址)
+	void SetUseDiskCache(bool bEnable) { bUseDiskCache = bEnable; }
+
+	// 根据网格包围盒和分辨率设置计算SDF的采样域和各轴分辨率
+	static void ComputeGridLayout(const FAxisAlignedBox3d& MeshBounds, const FToolSDFResolution& Resolution,
+		FAxisAlignedBox3d& OutBounds, FIntVector& OutDimensions);
 
 
 private:
 	mutable FCriticalSection TextureCritical; // 保护RHI资源访问
 	FTextureRHIRef SDFTextureRHI;       // GPU纹理资源
 	FAxisAlignedBox3d SDFBounds;        // SDF覆盖的空间边界
-	int32 VolumeSize = 0;
+	FIntVector VolumeDimensions = FIntVector::ZeroValue;
+	bool bUseDiskCache = true;
+	bool bKeepCPUVolume = false;
+
+	// CPU 端的距离场副本，用于 CPU 切削路径 (整体替换，受 TextureCritical 保护)
+	TSharedPtr<const FToolSDFCPUVolume, ESPMode::ThreadSafe> CPUVolume;
 
 	// 内部数据结构用于线程间传递
 	struct FComputeData
 	{
 		FDynamicMesh3 ToolMesh;
-		int32 TextureSize;
+		FToolSDFResolution Resolution;
+		FIntVector Dimensions;
 		FAxisAlignedBox3d Bounds;
 		TArray<float> VolumeData;
 		TFunction<void(bool)> CompleteCallback;
@@ -46,4 +103,4 @@ private:
 
 	void ComputeSDFData(TUniquePtr<FComputeData> Data);
 	void CreateTextureOnRenderThread(TUniquePtr<FComputeData> Data);
-};
\ No newline at end of file
+};
@@ -2,6 +2,7 @@
 #include "CoreMinimal.h"
 #include "ShaderParameterStruct.h"
 #include "ToolSDFGenerator.h"
+#include "SDFToolShape.h"
 
 
 struct FlatOctreeNode
@@ -18,6 +19,8 @@ struct VOXELCUTSHADERS_API FVoxelCutCSParams
 	TSharedPtr<FToolSDFGenerator> ToolSDFGenerator;
 	TArray<FlatOctreeNode> OctreeNodesArray;
 	FTransform ToolTransform;
+	// 解析刀具形状 (非空时不使用 ToolSDFGenerator 的纹理)
+	FSDFToolShape ToolShape;
 };
 
 
@@ -26,7 +29,11 @@ BEGIN_UNIFORM_BUFFER_STRUCT(FToolUB, )
 	SHADER_PARAMETER(FMatrix44f, ToolInverseTransform)
 	SHADER_PARAMETER(FVector3f, ToolBoundsLocalMin)
 	SHADER_PARAMETER(FVector3f, ToolBoundsLocalMax)
-	SHADER_PARAMETER(int32, VolumeTextureSize)
+	SHADER_PARAMETER(FIntVector, VolumeDimensions)
+	SHADER_PARAMETER_ARRAY(FVector4f, ToolPrimitiveA, [FSDFToolShape::MaxPrimitives])
+	SHADER_PARAMETER_ARRAY(FVector4f, ToolPrimitiveB, [FSDFToolShape::MaxPrimitives])
+	SHADER_PARAMETER(int32, NumToolPrimitives)
+	SHADER_PARAMETER(float, ToolSmoothRadius)
 END_UNIFORM_BUFFER_STRUCT()
 
 
@@ -35,6 +42,10 @@ class FVoxelCutCS: public FGlobalShader
 	DECLARE_GLOBAL_SHADER(FVoxelCutCS);
 	SHADER_USE_PARAMETER_STRUCT(FVoxelCutCS, FGlobalShader);
 
+	// 刀具形状排列 (取值为 ESDFToolKernel，见 SDFToolShape.ush)
+	class FToolShapeDim : SHADER_PERMUTATION_INT("TOOL_SHAPE", (int32)ESDFToolKernel::Num);
+	using FPermutationDomain = TShaderPermutationDomain<FToolShapeDim>;
+
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
 		SHADER_PARAMETER_TEXTURE(Texture3D<float>, ToolSDF)
 		SHADER_PARAMETER_SAMPLER(SamplerState, ToolSDFSampler)